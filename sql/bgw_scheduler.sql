@@ -35,6 +35,11 @@ RETURNS INTEGER
 AS '@MODULE_PATHNAME@', 'ts_add_compress_chunks_policy'
 LANGUAGE C VOLATILE STRICT;
 
+CREATE OR REPLACE FUNCTION add_precreate_chunks_policy(hypertable REGCLASS, num_chunks INTEGER = 1, if_not_exists BOOL = false)
+RETURNS INTEGER
+AS '@MODULE_PATHNAME@', 'ts_add_precreate_chunks_policy'
+LANGUAGE C VOLATILE STRICT;
+
 CREATE OR REPLACE FUNCTION remove_drop_chunks_policy(hypertable REGCLASS, if_exists BOOL = false) RETURNS VOID
 AS '@MODULE_PATHNAME@', 'ts_remove_drop_chunks_policy'
 LANGUAGE C VOLATILE STRICT;
@@ -47,6 +52,10 @@ CREATE OR REPLACE FUNCTION remove_compress_chunks_policy(hypertable REGCLASS, if
 AS '@MODULE_PATHNAME@', 'ts_remove_compress_chunks_policy'
 LANGUAGE C VOLATILE STRICT;
 
+CREATE OR REPLACE FUNCTION remove_precreate_chunks_policy(hypertable REGCLASS, if_exists BOOL = false) RETURNS VOID
+AS '@MODULE_PATHNAME@', 'ts_remove_precreate_chunks_policy'
+LANGUAGE C VOLATILE STRICT;
+
 -- Returns the updated job schedule values
 CREATE OR REPLACE FUNCTION alter_job_schedule(
     job_id INTEGER,
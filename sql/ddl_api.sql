@@ -65,6 +65,27 @@ CREATE OR REPLACE FUNCTION  set_number_partitions(
     dimension_name          NAME = NULL
 ) RETURNS VOID AS '@MODULE_PATHNAME@', 'ts_dimension_set_num_slices' LANGUAGE C VOLATILE;
 
+-- Track the range of values of a column in each chunk of a hypertable so that
+-- chunks can be excluded on restrictions on the column. Only integer and
+-- date/time columns are supported.
+CREATE OR REPLACE FUNCTION  enable_chunk_column_stats(
+    hypertable              REGCLASS,
+    column_name             NAME,
+    if_not_exists           BOOLEAN = false
+) RETURNS VOID AS '@MODULE_PATHNAME@', 'ts_chunk_column_stats_enable' LANGUAGE C VOLATILE;
+
+CREATE OR REPLACE FUNCTION  disable_chunk_column_stats(
+    hypertable              REGCLASS,
+    column_name             NAME,
+    if_exists               BOOLEAN = false
+) RETURNS VOID AS '@MODULE_PATHNAME@', 'ts_chunk_column_stats_disable' LANGUAGE C VOLATILE;
+
+-- Recalculate the column ranges of a chunk, e.g., after they were invalidated
+-- by an UPDATE
+CREATE OR REPLACE FUNCTION  refresh_chunk_column_stats(
+    chunk                   REGCLASS
+) RETURNS VOID AS '@MODULE_PATHNAME@', 'ts_chunk_column_stats_refresh' LANGUAGE C VOLATILE;
+
 -- Drop chunks older than the given timestamp. If a hypertable name is given,
 -- drop only chunks associated with this table. Any of the first three arguments
 -- can be NULL meaning "all values".
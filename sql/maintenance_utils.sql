@@ -28,3 +28,23 @@ CREATE OR REPLACE FUNCTION decompress_chunk(
     uncompressed_chunk REGCLASS,
     if_compressed BOOLEAN = false
 ) RETURNS REGCLASS AS '@MODULE_PATHNAME@', 'ts_decompress_chunk' LANGUAGE C STRICT VOLATILE;
+
+-- Get the planner statistics collected by this backend for each hypertable
+-- while timescaledb.track_planning is enabled. Times are in milliseconds.
+CREATE OR REPLACE FUNCTION _timescaledb_internal.hypertable_planner_stats(
+    OUT hypertable REGCLASS,
+    OUT plans BIGINT,
+    OUT chunks_considered BIGINT,
+    OUT chunks_excluded BIGINT,
+    OUT chunks_expanded BIGINT,
+    OUT paths_created BIGINT,
+    OUT planning_time FLOAT8,
+    OUT expansion_time FLOAT8,
+    OUT restrict_info_time FLOAT8,
+    OUT chunk_exclusion_time FLOAT8,
+    OUT ordered_append_time FLOAT8,
+    OUT decompression_paths_time FLOAT8
+) RETURNS SETOF RECORD AS '@MODULE_PATHNAME@', 'ts_planner_stats_get' LANGUAGE C VOLATILE STRICT;
+
+CREATE OR REPLACE FUNCTION _timescaledb_internal.reset_hypertable_planner_stats()
+RETURNS VOID AS '@MODULE_PATHNAME@', 'ts_planner_stats_reset' LANGUAGE C VOLATILE STRICT;
@@ -162,6 +162,25 @@ CREATE INDEX IF NOT EXISTS chunk_index_hypertable_id_hypertable_index_name_idx
 ON _timescaledb_catalog.chunk_index(hypertable_id, hypertable_index_name);
 SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.chunk_index', '');
 
+-- Ranges of values (zone maps) in the chunks of a hypertable for columns
+-- that are not partitioning dimensions. Rows with chunk_id 0 enable the
+-- ranges for a column of the hypertable. The range_end is exclusive and an
+-- empty range means that the chunk has no non-NULL values in the column.
+-- Ranges that are not valid are not used to exclude chunks.
+CREATE TABLE IF NOT EXISTS _timescaledb_catalog.chunk_column_stats (
+    id              SERIAL   NOT NULL PRIMARY KEY,
+    hypertable_id   INTEGER  NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
+    chunk_id        INTEGER  NOT NULL,
+    column_name     NAME     NOT NULL,
+    range_start     BIGINT   NOT NULL,
+    range_end       BIGINT   NOT NULL,
+    valid           BOOLEAN  NOT NULL,
+    CHECK (range_start <= range_end),
+    UNIQUE (hypertable_id, chunk_id, column_name)
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.chunk_column_stats', '');
+SELECT pg_catalog.pg_extension_config_dump(pg_get_serial_sequence('_timescaledb_catalog.chunk_column_stats','id'), '');
+
 -- Default jobs are given the id space [1,1000). User-installed jobs and any jobs created inside tests
 -- are given the id space [1000, INT_MAX). That way, we do not pg_dump jobs that are always default-installed
 -- inside other .sql scripts. This avoids insertion conflicts during pg_restore.
@@ -177,7 +196,7 @@ CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_job (
     max_runtime         INTERVAL    NOT NULL,
     max_retries         INT         NOT NULL,
     retry_period        INTERVAL    NOT NULL,
-    CONSTRAINT  valid_job_type CHECK (job_type IN ('telemetry_and_version_check_if_enabled', 'reorder', 'drop_chunks', 'continuous_aggregate', 'compress_chunks'))
+    CONSTRAINT  valid_job_type CHECK (job_type IN ('telemetry_and_version_check_if_enabled', 'reorder', 'drop_chunks', 'continuous_aggregate', 'compress_chunks', 'precreate_chunks'))
 );
 ALTER SEQUENCE _timescaledb_config.bgw_job_id_seq OWNED BY _timescaledb_config.bgw_job.id;
 
@@ -339,6 +358,8 @@ CREATE TABLE IF NOT EXISTS _timescaledb_catalog.compression_chunk_size (
     compressed_heap_size BIGINT NOT NULL,
     compressed_toast_size BIGINT NOT NULL,
     compressed_index_size BIGINT NOT NULL,
+    numrows_pre_compression BIGINT,
+    numrows_post_compression BIGINT,
     PRIMARY KEY(chunk_id, compressed_chunk_id)
 );
 SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.compression_chunk_size', '');
@@ -352,6 +373,14 @@ CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_compress_chunks(
 
 SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_compress_chunks', '');
 
+CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_precreate_chunks(
+    job_id          INTEGER     PRIMARY KEY REFERENCES _timescaledb_config.bgw_job(id) ON DELETE CASCADE,
+    hypertable_id   INTEGER     UNIQUE NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
+    num_chunks      INTEGER     NOT NULL CHECK (num_chunks > 0)
+);
+
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_precreate_chunks', '');
+
 
 -- Set table permissions
 -- We need to grant SELECT to PUBLIC for all tables even those not
@@ -0,0 +1,34 @@
+ALTER TABLE _timescaledb_catalog.compression_chunk_size
+    ADD COLUMN numrows_pre_compression BIGINT,
+    ADD COLUMN numrows_post_compression BIGINT;
+
+ALTER TABLE _timescaledb_config.bgw_job
+DROP CONSTRAINT valid_job_type,
+ADD CONSTRAINT valid_job_type CHECK (job_type IN ('telemetry_and_version_check_if_enabled', 'reorder', 'drop_chunks', 'continuous_aggregate', 'compress_chunks', 'precreate_chunks'));
+
+CREATE TABLE IF NOT EXISTS _timescaledb_config.bgw_policy_precreate_chunks(
+    job_id          INTEGER     PRIMARY KEY REFERENCES _timescaledb_config.bgw_job(id) ON DELETE CASCADE,
+    hypertable_id   INTEGER     UNIQUE NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
+    num_chunks      INTEGER     NOT NULL CHECK (num_chunks > 0)
+);
+
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_config.bgw_policy_precreate_chunks', '');
+
+GRANT SELECT ON _timescaledb_config.bgw_policy_precreate_chunks TO PUBLIC;
+
+CREATE TABLE IF NOT EXISTS _timescaledb_catalog.chunk_column_stats (
+    id              SERIAL   NOT NULL PRIMARY KEY,
+    hypertable_id   INTEGER  NOT NULL REFERENCES _timescaledb_catalog.hypertable(id) ON DELETE CASCADE,
+    chunk_id        INTEGER  NOT NULL,
+    column_name     NAME     NOT NULL,
+    range_start     BIGINT   NOT NULL,
+    range_end       BIGINT   NOT NULL,
+    valid           BOOLEAN  NOT NULL,
+    CHECK (range_start <= range_end),
+    UNIQUE (hypertable_id, chunk_id, column_name)
+);
+SELECT pg_catalog.pg_extension_config_dump('_timescaledb_catalog.chunk_column_stats', '');
+SELECT pg_catalog.pg_extension_config_dump(pg_get_serial_sequence('_timescaledb_catalog.chunk_column_stats','id'), '');
+
+GRANT SELECT ON _timescaledb_catalog.chunk_column_stats TO PUBLIC;
+GRANT SELECT ON _timescaledb_catalog.chunk_column_stats_id_seq TO PUBLIC;
@@ -71,6 +71,7 @@ CREATE OR REPLACE VIEW timescaledb_information.policy_stats as
   FROM (SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_reorder
         UNION SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_drop_chunks
         UNION SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_compress_chunks
+        UNION SELECT job_id, hypertable_id FROM _timescaledb_config.bgw_policy_precreate_chunks
         UNION SELECT job_id, raw_hypertable_id FROM _timescaledb_catalog.continuous_agg) p
     INNER JOIN _timescaledb_catalog.hypertable ht ON p.hypertable_id = ht.id
     INNER JOIN _timescaledb_config.bgw_job j ON p.job_id = j.id
@@ -32,6 +32,7 @@
 #include "bgw_policy/chunk_stats.h"
 #include "bgw_policy/drop_chunks.h"
 #include "bgw_policy/compress_chunks.h"
+#include "bgw_policy/precreate_chunks.h"
 #include "bgw_policy/reorder.h"
 #include "scan_iterator.h"
 
@@ -64,6 +65,7 @@ static const char *job_type_names[_MAX_JOB_TYPE] = {
 	[JOB_TYPE_DROP_CHUNKS] = "drop_chunks",
 	[JOB_TYPE_CONTINUOUS_AGGREGATE] = "continuous_aggregate",
 	[JOB_TYPE_COMPRESS_CHUNKS] = "compress_chunks",
+	[JOB_TYPE_PRECREATE_CHUNKS] = "precreate_chunks",
 	[JOB_TYPE_UNKNOWN] = "unknown",
 };
 
@@ -142,6 +144,16 @@ ts_bgw_job_owner(BgwJob *job)
 				elog(ERROR, "compress chunks policy for job with id \"%d\" not found", job->fd.id);
 			return ts_rel_get_owner(ts_hypertable_id_to_relid(policy->fd.hypertable_id));
 		}
+		case JOB_TYPE_PRECREATE_CHUNKS:
+		{
+			BgwPolicyPrecreateChunks *policy =
+				ts_bgw_policy_precreate_chunks_find_by_job(job->fd.id);
+
+			if (policy == NULL)
+				elog(ERROR, "precreate chunks policy for job with id \"%d\" not found", job->fd.id);
+
+			return ts_rel_get_owner(ts_hypertable_id_to_relid(policy->fd.hypertable_id));
+		}
 		case JOB_TYPE_UNKNOWN:
 			if (unknown_job_type_owner_hook != NULL)
 				return unknown_job_type_owner_hook(job);
@@ -423,6 +435,7 @@ bgw_job_tuple_delete(TupleInfo *ti, void *data)
 	ts_bgw_policy_reorder_delete_row_only_by_job_id(job_id);
 	ts_bgw_policy_drop_chunks_delete_row_only_by_job_id(job_id);
 	ts_bgw_policy_compress_chunks_delete_row_only_by_job_id(job_id);
+	ts_bgw_policy_precreate_chunks_delete_row_only_by_job_id(job_id);
 
 	/* Delete any stats in bgw_policy_chunk_stats related to this job */
 	ts_bgw_policy_chunk_stats_delete_row_only_by_job_id(job_id);
@@ -544,6 +557,7 @@ ts_bgw_job_execute(BgwJob *job)
 		case JOB_TYPE_DROP_CHUNKS:
 		case JOB_TYPE_CONTINUOUS_AGGREGATE:
 		case JOB_TYPE_COMPRESS_CHUNKS:
+		case JOB_TYPE_PRECREATE_CHUNKS:
 			return ts_cm_functions->bgw_policy_job_execute(job);
 		case JOB_TYPE_UNKNOWN:
 			if (unknown_job_type_hook != NULL)
@@ -20,6 +20,7 @@ typedef enum JobType
 	JOB_TYPE_DROP_CHUNKS,
 	JOB_TYPE_CONTINUOUS_AGGREGATE,
 	JOB_TYPE_COMPRESS_CHUNKS,
+	JOB_TYPE_PRECREATE_CHUNKS,
 	/* end of real jobs */
 	JOB_TYPE_UNKNOWN,
 	_MAX_JOB_TYPE
@@ -11,6 +11,7 @@
 #include "bgw_policy/reorder.h"
 #include "bgw_policy/drop_chunks.h"
 #include "bgw_policy/compress_chunks.h"
+#include "bgw_policy/precreate_chunks.h"
 #include "bgw/job.h"
 
 void
@@ -35,6 +36,11 @@ ts_bgw_policy_delete_by_hypertable_id(int32 hypertable_id)
 
 	if (policy)
 		ts_bgw_job_delete_by_id(((BgwPolicyCompressChunks *) policy)->fd.job_id);
+
+	policy = ts_bgw_policy_precreate_chunks_find_by_hypertable(hypertable_id);
+
+	if (policy)
+		ts_bgw_job_delete_by_id(((BgwPolicyPrecreateChunks *) policy)->fd.job_id);
 }
 
 /* This function does NOT cascade deletes to the bgw_job table. */
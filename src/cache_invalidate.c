@@ -4,6 +4,7 @@
  * LICENSE-APACHE for a copy of the license.
  */
 #include <postgres.h>
+#include <access/transam.h>
 #include <access/xact.h>
 #include <utils/lsyscache.h>
 #include <utils/inval.h>
@@ -13,6 +14,7 @@
 
 #include "catalog.h"
 #include "compat.h"
+#include "dimension_slice_index.h"
 #include "extension.h"
 #include "hypertable_cache.h"
 
@@ -44,6 +46,11 @@
  * (e.g., when replacing a negative hypertable entry with a positive one). Note,
  * also, that INSERTS can taint the cache if the transaction that did the INSERT
  * fails. This is why we also need to invalidate caches on transaction failure.
+ *
+ * Changes to the catalog rows of a single hypertable (including new chunks)
+ * are signaled via a relcache invalidation on the hypertable itself instead
+ * of the dummy table, so that only the cache entries of that hypertable are
+ * evicted.
  */
 
 void _cache_invalidate_init(void);
@@ -54,6 +61,7 @@ cache_invalidate_all(void)
 {
 	ts_hypertable_cache_invalidate_callback();
 	ts_bgw_job_cache_invalidate_callback();
+	ts_hypertable_slice_index_invalidate();
 }
 
 /*
@@ -77,13 +85,26 @@ cache_invalidate_callback(Datum arg, Oid relid)
 	catalog = ts_catalog_get();
 
 	if (relid == ts_catalog_get_cache_proxy_id(catalog, CACHE_TYPE_HYPERTABLE))
+	{
 		ts_hypertable_cache_invalidate_callback();
+		ts_hypertable_slice_index_invalidate();
+	}
 
 	if (relid == ts_catalog_get_cache_proxy_id(catalog, CACHE_TYPE_BGW_JOB))
 		ts_bgw_job_cache_invalidate_callback();
 
 	if (relid == InvalidOid)
 		cache_invalidate_all();
+	else if (relid >= FirstNormalObjectId)
+	{
+		/*
+		 * Only user tables can be hypertables. Most relcache invalidations
+		 * are for system catalogs, so skip them before looking up the
+		 * caches.
+		 */
+		ts_hypertable_cache_invalidate_entry(relid);
+		ts_hypertable_slice_index_invalidate_relid(relid);
+	}
 }
 
 TS_FUNCTION_INFO_V1(ts_timescaledb_invalidate_cache);
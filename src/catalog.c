@@ -11,6 +11,9 @@
 #include <utils/builtins.h>
 #include <utils/syscache.h>
 #include <utils/inval.h>
+#include <utils/fmgroids.h>
+#include <utils/hsearch.h>
+#include <utils/memutils.h>
 #include <access/xact.h>
 #include <access/htup_details.h>
 #include <miscadmin.h>
@@ -110,6 +113,14 @@ static const TableInfoDef catalog_table_names[_MAX_CATALOG_TABLES + 1] = {
 		.schema_name = CONFIG_SCHEMA_NAME,
 		.table_name = BGW_POLICY_COMPRESS_CHUNKS_TABLE_NAME,
 	},
+	[BGW_POLICY_PRECREATE_CHUNKS] = {
+		.schema_name = CONFIG_SCHEMA_NAME,
+		.table_name = BGW_POLICY_PRECREATE_CHUNKS_TABLE_NAME,
+	},
+	[CHUNK_COLUMN_STATS] = {
+		.schema_name = CATALOG_SCHEMA_NAME,
+		.table_name = CHUNK_COLUMN_STATS_TABLE_NAME,
+	},
 	[_MAX_CATALOG_TABLES] = {
 		.schema_name = "invalid schema",
 		.table_name = "invalid table",
@@ -259,6 +270,20 @@ static const TableIndexDef catalog_table_index_definitions[_MAX_CATALOG_TABLES]
 			[BGW_POLICY_COMPRESS_CHUNKS_HYPERTABLE_ID_KEY] = "bgw_policy_compress_chunks_hypertable_id_key",
 		},
 	},
+	[BGW_POLICY_PRECREATE_CHUNKS] = {
+		.length = _MAX_BGW_POLICY_PRECREATE_CHUNKS_INDEX,
+		.names = (char *[]) {
+			[BGW_POLICY_PRECREATE_CHUNKS_PKEY] = "bgw_policy_precreate_chunks_pkey",
+			[BGW_POLICY_PRECREATE_CHUNKS_HYPERTABLE_ID_KEY] = "bgw_policy_precreate_chunks_hypertable_id_key",
+		},
+	},
+	[CHUNK_COLUMN_STATS] = {
+		.length = _MAX_CHUNK_COLUMN_STATS_INDEX,
+		.names = (char *[]) {
+			[CHUNK_COLUMN_STATS_HYPERTABLE_ID_CHUNK_ID_COLUMN_NAME_KEY] = "chunk_column_stats_hypertable_id_chunk_id_column_name_key",
+			[CHUNK_COLUMN_STATS_PKEY] = "chunk_column_stats_pkey",
+		},
+	},
 };
 
 static const char *catalog_table_serial_id_names[_MAX_CATALOG_TABLES] = {
@@ -280,6 +305,8 @@ static const char *catalog_table_serial_id_names[_MAX_CATALOG_TABLES] = {
 	[HYPERTABLE_COMPRESSION] = NULL,
 	[COMPRESSION_CHUNK_SIZE] = NULL,
 	[BGW_POLICY_COMPRESS_CHUNKS] = NULL,
+	[BGW_POLICY_PRECREATE_CHUNKS] = NULL,
+	[CHUNK_COLUMN_STATS] = CATALOG_SCHEMA_NAME ".chunk_column_stats_id_seq",
 };
 
 typedef struct InternalFunctionDef
@@ -492,11 +519,39 @@ ts_catalog_get(void)
 	return &s_catalog;
 }
 
+/*
+ * Memo of the hypertables that chunks and dimensions belong to, and of the
+ * relids of hypertables, for finding the hypertable a catalog change belongs
+ * to. Chunks and dimensions never move to another hypertable and catalog IDs
+ * are never reused, so entries only become invalid when the extension's
+ * catalog is reset.
+ */
+typedef struct HypertableMemoKey
+{
+	CatalogTable table;
+	int32 id;
+} HypertableMemoKey;
+
+typedef struct HypertableMemoEntry
+{
+	HypertableMemoKey key;
+	int32 hypertable_id;
+	Oid hypertable_relid;
+} HypertableMemoEntry;
+
+static HTAB *hypertable_memo = NULL;
+
 void
 ts_catalog_reset(void)
 {
 	s_catalog.initialized = false;
 	database_info.database_id = InvalidOid;
+
+	if (NULL != hypertable_memo)
+	{
+		hash_destroy(hypertable_memo);
+		hypertable_memo = NULL;
+	}
 }
 
 static CatalogTable
@@ -604,6 +659,276 @@ ts_catalog_restore_user(CatalogSecurityContext *sec_ctx)
 	SetUserIdAndSecContext(sec_ctx->saved_uid, sec_ctx->saved_security_context);
 }
 
+typedef struct HypertableIdLookup
+{
+	AttrNumber attno;
+	int32 hypertable_id;
+} HypertableIdLookup;
+
+static ScanTupleResult
+hypertable_id_tuple_found(TupleInfo *ti, void *data)
+{
+	HypertableIdLookup *lookup = data;
+	bool isnull;
+	Datum id = heap_getattr(ti->tuple, lookup->attno, ti->desc, &isnull);
+
+	if (!isnull)
+		lookup->hypertable_id = DatumGetInt32(id);
+
+	return SCAN_DONE;
+}
+
+static HypertableMemoEntry *
+hypertable_memo_lookup(CatalogTable table, int32 id, bool *found)
+{
+	HypertableMemoKey key = {
+		.table = table,
+		.id = id,
+	};
+
+	if (NULL == hypertable_memo)
+	{
+		HASHCTL ctl = {
+			.keysize = sizeof(HypertableMemoKey),
+			.entrysize = sizeof(HypertableMemoEntry),
+			.hcxt = CacheMemoryContext,
+		};
+
+		hypertable_memo = hash_create("Catalog hypertable memo",
+									  64,
+									  &ctl,
+									  HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	return hash_search(hypertable_memo, &key, HASH_FIND, found);
+}
+
+static void
+hypertable_memo_add(CatalogTable table, int32 id, int32 hypertable_id, Oid hypertable_relid)
+{
+	HypertableMemoKey key = {
+		.table = table,
+		.id = id,
+	};
+	HypertableMemoEntry *entry = hash_search(hypertable_memo, &key, HASH_ENTER, NULL);
+
+	entry->hypertable_id = hypertable_id;
+	entry->hypertable_relid = hypertable_relid;
+}
+
+/*
+ * Get the hypertable ID of a chunk or dimension given the chunk's or
+ * dimension's ID. Returns -1 if there is no such chunk or dimension, e.g.,
+ * because it was deleted in the current transaction.
+ */
+static int32
+catalog_lookup_hypertable_id(Catalog *catalog, CatalogTable table, int32 id)
+{
+	bool found;
+	HypertableMemoEntry *entry = hypertable_memo_lookup(table, id, &found);
+	HypertableIdLookup lookup = {
+		.attno = (table == CHUNK) ? Anum_chunk_hypertable_id : Anum_dimension_hypertable_id,
+		.hypertable_id = -1,
+	};
+	int indexid = (table == CHUNK) ? CHUNK_ID_INDEX : DIMENSION_ID_IDX;
+	ScanKeyData scankey[1];
+	ScannerCtx scanctx = {
+		.table = catalog_get_table_id(catalog, table),
+		.index = catalog_get_index(catalog, table, indexid),
+		.nkeys = 1,
+		.scankey = scankey,
+		.tuple_found = hypertable_id_tuple_found,
+		.data = &lookup,
+		.lockmode = AccessShareLock,
+		.scandirection = ForwardScanDirection,
+	};
+
+	Assert(table == CHUNK || table == DIMENSION);
+
+	if (found)
+		return entry->hypertable_id;
+
+	/* The ID is the first key of both the chunk and dimension pkey index */
+	ScanKeyInit(&scankey[0], 1, BTEqualStrategyNumber, F_INT4EQ, Int32GetDatum(id));
+	ts_scanner_scan(&scanctx);
+
+	if (lookup.hypertable_id > 0)
+		hypertable_memo_add(table, id, lookup.hypertable_id, InvalidOid);
+
+	return lookup.hypertable_id;
+}
+
+static ScanTupleResult
+hypertable_relid_tuple_found(TupleInfo *ti, void *data)
+{
+	Oid *relid = data;
+	bool isnull;
+	Datum schema_name = heap_getattr(ti->tuple, Anum_hypertable_schema_name, ti->desc, &isnull);
+	Datum table_name = heap_getattr(ti->tuple, Anum_hypertable_table_name, ti->desc, &isnull);
+	Oid schema_oid;
+
+	schema_oid = get_namespace_oid(NameStr(*DatumGetName(schema_name)), true);
+
+	if (OidIsValid(schema_oid))
+		*relid = get_relname_relid(NameStr(*DatumGetName(table_name)), schema_oid);
+
+	return SCAN_DONE;
+}
+
+static Oid
+catalog_lookup_hypertable_relid(Catalog *catalog, int32 hypertable_id)
+{
+	bool found;
+	HypertableMemoEntry *entry = hypertable_memo_lookup(HYPERTABLE, hypertable_id, &found);
+	Oid relid = InvalidOid;
+	ScanKeyData scankey[1];
+	ScannerCtx scanctx = {
+		.table = catalog_get_table_id(catalog, HYPERTABLE),
+		.index = catalog_get_index(catalog, HYPERTABLE, HYPERTABLE_ID_INDEX),
+		.nkeys = 1,
+		.scankey = scankey,
+		.tuple_found = hypertable_relid_tuple_found,
+		.data = &relid,
+		.lockmode = AccessShareLock,
+		.scandirection = ForwardScanDirection,
+	};
+
+	if (found)
+		return entry->hypertable_relid;
+
+	ScanKeyInit(&scankey[0],
+				Anum_hypertable_pkey_idx_id,
+				BTEqualStrategyNumber,
+				F_INT4EQ,
+				Int32GetDatum(hypertable_id));
+	ts_scanner_scan(&scanctx);
+
+	if (OidIsValid(relid))
+		hypertable_memo_add(HYPERTABLE, hypertable_id, hypertable_id, relid);
+
+	return relid;
+}
+
+static int32
+catalog_tuple_get_int32(Relation rel, HeapTuple tuple, AttrNumber attno)
+{
+	bool isnull;
+	Datum value = heap_getattr(tuple, attno, RelationGetDescr(rel), &isnull);
+
+	return isnull ? -1 : DatumGetInt32(value);
+}
+
+/*
+ * Get the IDs of the hypertables whose metadata is changed by a change to a
+ * catalog tuple. Returns the number of hypertable IDs found, or zero if the
+ * hypertable cannot be determined.
+ */
+static int
+catalog_tuple_get_hypertable_ids(Catalog *catalog, CatalogTable table, Relation rel,
+								 HeapTuple tuple, int32 hypertable_ids[2])
+{
+	int32 id;
+
+	switch (table)
+	{
+		case HYPERTABLE:
+			hypertable_ids[0] = catalog_tuple_get_int32(rel, tuple, Anum_hypertable_id);
+			return 1;
+		case DIMENSION:
+			hypertable_ids[0] = catalog_tuple_get_int32(rel, tuple, Anum_dimension_hypertable_id);
+			return 1;
+		case CHUNK:
+			hypertable_ids[0] = catalog_tuple_get_int32(rel, tuple, Anum_chunk_hypertable_id);
+			return 1;
+		case CHUNK_CONSTRAINT:
+			id = catalog_tuple_get_int32(rel, tuple, Anum_chunk_constraint_chunk_id);
+			hypertable_ids[0] = catalog_lookup_hypertable_id(catalog, CHUNK, id);
+			return 1;
+		case DIMENSION_SLICE:
+			id = catalog_tuple_get_int32(rel, tuple, Anum_dimension_slice_dimension_id);
+			hypertable_ids[0] = catalog_lookup_hypertable_id(catalog, DIMENSION, id);
+			return 1;
+		case CONTINUOUS_AGG:
+			hypertable_ids[0] =
+				catalog_tuple_get_int32(rel, tuple, Anum_continuous_agg_mat_hypertable_id);
+			hypertable_ids[1] =
+				catalog_tuple_get_int32(rel, tuple, Anum_continuous_agg_raw_hypertable_id);
+			return 2;
+		case CHUNK_COLUMN_STATS:
+			/*
+			 * Only the rows that enable stats on a column are part of the
+			 * cached hypertable. Changes to the ranges of chunks invalidate
+			 * the chunk instead, which needs no cache invalidation here.
+			 */
+			if (catalog_tuple_get_int32(rel, tuple, Anum_chunk_column_stats_chunk_id) != 0)
+				return 0;
+			hypertable_ids[0] =
+				catalog_tuple_get_int32(rel, tuple, Anum_chunk_column_stats_hypertable_id);
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+/*
+ * Invalidate the caches for a change to a catalog tuple.
+ *
+ * Changes to the metadata of a hypertable are signaled with a relcache
+ * invalidation on the hypertable itself, so that other backends only evict
+ * the cache entries of that hypertable instead of the whole hypertable
+ * cache. If the hypertable cannot be determined, e.g., because the
+ * hypertable is being dropped, fall back to invalidating all entries.
+ */
+static void
+catalog_invalidate_cache_for_tuple(Relation rel, HeapTuple tuple, CmdType operation)
+{
+	Catalog *catalog = ts_catalog_get();
+	CatalogTable table = catalog_get_table(catalog, RelationGetRelid(rel));
+	int32 hypertable_ids[2];
+	Oid relids[2];
+	int num_hypertables;
+	int i;
+
+	/*
+	 * The metadata of a new chunk is inserted in several steps, so the new
+	 * chunk is signaled once after all of it is in place (see
+	 * ts_chunk_invalidate_new()).
+	 */
+	if (operation == CMD_INSERT &&
+		(table == CHUNK || table == CHUNK_CONSTRAINT || table == DIMENSION_SLICE))
+		return;
+
+	num_hypertables = catalog_tuple_get_hypertable_ids(catalog, table, rel, tuple, hypertable_ids);
+
+	if (num_hypertables == 0)
+	{
+		ts_catalog_invalidate_cache(RelationGetRelid(rel), operation);
+		return;
+	}
+
+	for (i = 0; i < num_hypertables; i++)
+	{
+		relids[i] = InvalidOid;
+
+		if (hypertable_ids[i] > 0)
+			relids[i] = catalog_lookup_hypertable_relid(catalog, hypertable_ids[i]);
+
+		/*
+		 * The relid might be memoized for a hypertable that is dropped
+		 * already. DROP TABLE and DROP SCHEMA delete the catalog rows of a
+		 * hypertable only after dropping the table itself.
+		 */
+		if (!OidIsValid(relids[i]) || !SearchSysCacheExists1(RELOID, ObjectIdGetDatum(relids[i])))
+		{
+			ts_catalog_invalidate_cache(RelationGetRelid(rel), operation);
+			return;
+		}
+	}
+
+	for (i = 0; i < num_hypertables; i++)
+		CacheInvalidateRelcacheByRelid(relids[i]);
+}
+
 /*
  * Insert a new row into a catalog table.
  */
@@ -611,7 +936,7 @@ void
 ts_catalog_insert(Relation rel, HeapTuple tuple)
 {
 	CatalogTupleInsert(rel, tuple);
-	ts_catalog_invalidate_cache(RelationGetRelid(rel), CMD_INSERT);
+	catalog_invalidate_cache_for_tuple(rel, tuple, CMD_INSERT);
 	/* Make changes visible */
 	CommandCounterIncrement();
 }
@@ -632,7 +957,7 @@ TSDLLEXPORT void
 ts_catalog_update_tid(Relation rel, ItemPointer tid, HeapTuple tuple)
 {
 	CatalogTupleUpdate(rel, tid, tuple);
-	ts_catalog_invalidate_cache(RelationGetRelid(rel), CMD_UPDATE);
+	catalog_invalidate_cache_for_tuple(rel, tuple, CMD_UPDATE);
 	/* Make changes visible */
 	CommandCounterIncrement();
 }
@@ -654,7 +979,9 @@ ts_catalog_delete_tid(Relation rel, ItemPointer tid)
 TSDLLEXPORT void
 ts_catalog_delete(Relation rel, HeapTuple tuple)
 {
-	ts_catalog_delete_tid(rel, &tuple->t_self);
+	CatalogTupleDelete(rel, &tuple->t_self);
+	catalog_invalidate_cache_for_tuple(rel, tuple, CMD_DELETE);
+	CommandCounterIncrement();
 }
 
 void
@@ -55,6 +55,8 @@ typedef enum CatalogTable
 	HYPERTABLE_COMPRESSION,
 	COMPRESSION_CHUNK_SIZE,
 	BGW_POLICY_COMPRESS_CHUNKS,
+	BGW_POLICY_PRECREATE_CHUNKS,
+	CHUNK_COLUMN_STATS,
 	_MAX_CATALOG_TABLES,
 } CatalogTable;
 
@@ -1117,6 +1119,8 @@ typedef enum Anum_compression_chunk_size
 	Anum_compression_chunk_size_compressed_heap_size,
 	Anum_compression_chunk_size_compressed_toast_size,
 	Anum_compression_chunk_size_compressed_index_size,
+	Anum_compression_chunk_size_numrows_pre_compression,
+	Anum_compression_chunk_size_numrows_post_compression,
 	_Anum_compression_chunk_size_max,
 } Anum_compression_chunk_size;
 
@@ -1132,6 +1136,8 @@ typedef struct FormData_compression_chunk_size
 	int64 compressed_heap_size;
 	int64 compressed_toast_size;
 	int64 compressed_index_size;
+	int64 numrows_pre_compression;
+	int64 numrows_post_compression;
 } FormData_compression_chunk_size;
 
 typedef FormData_compression_chunk_size *Form_compression_chunk_size;
@@ -1194,6 +1200,110 @@ typedef enum Anum_bgw_policy_compress_chunks_pkey
 
 #define Natts_bgw_policy_compress_chunks_pkey (_Anum_bgw_policy_compress_chunks_pkey_max - 1)
 
+#define BGW_POLICY_PRECREATE_CHUNKS_TABLE_NAME "bgw_policy_precreate_chunks"
+typedef enum Anum_bgw_policy_precreate_chunks
+{
+	Anum_bgw_policy_precreate_chunks_job_id = 1,
+	Anum_bgw_policy_precreate_chunks_hypertable_id,
+	Anum_bgw_policy_precreate_chunks_num_chunks,
+	_Anum_bgw_policy_precreate_chunks_max,
+} Anum_bgw_policy_precreate_chunks;
+
+#define Natts_bgw_policy_precreate_chunks (_Anum_bgw_policy_precreate_chunks_max - 1)
+
+typedef struct FormData_bgw_policy_precreate_chunks
+{
+	int32 job_id;
+	int32 hypertable_id;
+	int32 num_chunks;
+} FormData_bgw_policy_precreate_chunks;
+
+typedef FormData_bgw_policy_precreate_chunks *Form_bgw_policy_precreate_chunks;
+
+enum
+{
+	BGW_POLICY_PRECREATE_CHUNKS_HYPERTABLE_ID_KEY = 0,
+	BGW_POLICY_PRECREATE_CHUNKS_PKEY,
+	_MAX_BGW_POLICY_PRECREATE_CHUNKS_INDEX,
+};
+
+typedef enum Anum_bgw_policy_precreate_chunks_hypertable_id_key
+{
+	Anum_bgw_policy_precreate_chunks_hypertable_id_key_hypertable_id = 1,
+	_Anum_bgw_policy_precreate_chunks_hypertable_id_key_max,
+} Anum_bgw_policy_precreate_chunks_hypertable_id_key;
+
+#define Natts_bgw_policy_precreate_chunks_hypertable_id_key                                        \
+	(_Anum_bgw_policy_precreate_chunks_hypertable_id_key_max - 1)
+
+typedef enum Anum_bgw_policy_precreate_chunks_pkey
+{
+	Anum_bgw_policy_precreate_chunks_pkey_job_id = 1,
+	_Anum_bgw_policy_precreate_chunks_pkey_max,
+} Anum_bgw_policy_precreate_chunks_pkey;
+
+#define Natts_bgw_policy_precreate_chunks_pkey (_Anum_bgw_policy_precreate_chunks_pkey_max - 1)
+
+/******************************************
+ *
+ * chunk_column_stats table definitions
+ *
+ ******************************************/
+#define CHUNK_COLUMN_STATS_TABLE_NAME "chunk_column_stats"
+
+typedef enum Anum_chunk_column_stats
+{
+	Anum_chunk_column_stats_id = 1,
+	Anum_chunk_column_stats_hypertable_id,
+	Anum_chunk_column_stats_chunk_id,
+	Anum_chunk_column_stats_column_name,
+	Anum_chunk_column_stats_range_start,
+	Anum_chunk_column_stats_range_end,
+	Anum_chunk_column_stats_valid,
+	_Anum_chunk_column_stats_max,
+} Anum_chunk_column_stats;
+
+#define Natts_chunk_column_stats (_Anum_chunk_column_stats_max - 1)
+
+typedef struct FormData_chunk_column_stats
+{
+	int32 id;
+	int32 hypertable_id;
+	int32 chunk_id;
+	NameData column_name;
+	int64 range_start;
+	int64 range_end;
+	bool valid;
+} FormData_chunk_column_stats;
+
+typedef FormData_chunk_column_stats *Form_chunk_column_stats;
+
+enum
+{
+	CHUNK_COLUMN_STATS_HYPERTABLE_ID_CHUNK_ID_COLUMN_NAME_KEY = 0,
+	CHUNK_COLUMN_STATS_PKEY,
+	_MAX_CHUNK_COLUMN_STATS_INDEX,
+};
+
+typedef enum Anum_chunk_column_stats_hypertable_id_chunk_id_column_name_key
+{
+	Anum_chunk_column_stats_ht_id_chunk_id_column_name_key_hypertable_id = 1,
+	Anum_chunk_column_stats_ht_id_chunk_id_column_name_key_chunk_id,
+	Anum_chunk_column_stats_ht_id_chunk_id_column_name_key_column_name,
+	_Anum_chunk_column_stats_ht_id_chunk_id_column_name_key_max,
+} Anum_chunk_column_stats_hypertable_id_chunk_id_column_name_key;
+
+#define Natts_chunk_column_stats_ht_id_chunk_id_column_name_key                                    \
+	(_Anum_chunk_column_stats_ht_id_chunk_id_column_name_key_max - 1)
+
+typedef enum Anum_chunk_column_stats_pkey
+{
+	Anum_chunk_column_stats_pkey_id = 1,
+	_Anum_chunk_column_stats_pkey_max,
+} Anum_chunk_column_stats_pkey;
+
+#define Natts_chunk_column_stats_pkey (_Anum_chunk_column_stats_pkey_max - 1)
+
 /*
  * The maximum number of indexes a catalog table can have.
  * This needs to be bumped in case of new catalog tables that have more indexes.
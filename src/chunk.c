@@ -23,6 +23,7 @@
 #include <utils/lsyscache.h>
 #include <utils/syscache.h>
 #include <utils/hsearch.h>
+#include <utils/inval.h>
 #include <storage/lmgr.h>
 #include <miscadmin.h>
 #include <funcapi.h>
@@ -36,6 +37,7 @@
 
 #include "export.h"
 #include "chunk.h"
+#include "chunk_column_stats.h"
 #include "chunk_index.h"
 #include "catalog.h"
 #include "continuous_agg.h"
@@ -210,6 +212,19 @@ ts_chunk_insert_lock(Chunk *chunk, LOCKMODE lock)
 	table_close(rel, lock);
 }
 
+/*
+ * Signal that a new chunk was added to a hypertable, after all of the chunk's
+ * metadata was inserted. The relcache invalidation on the hypertable makes
+ * backends only evict the cached metadata of that hypertable, e.g., its
+ * dimension slice index, which no longer covers all chunks.
+ */
+TSDLLEXPORT void
+ts_chunk_invalidate_new(Chunk *chunk)
+{
+	CacheInvalidateRelcacheByRelid(chunk->hypertable_relid);
+	CommandCounterIncrement();
+}
+
 /*-
  * Align a chunk's hypercube in 'aligned' dimensions.
  *
@@ -746,6 +761,12 @@ chunk_create_metadata_after_lock(Hypertable *ht, Point *p, const char *schema, c
 
 	ts_chunk_constraints_insert_metadata(chunk->constraints);
 
+	/* Add empty ranges for any columns with chunk column stats */
+	if (ht->stats_columns != NIL)
+		ts_chunk_column_stats_create_for_chunk(ht->fd.id, chunk->fd.id);
+
+	ts_chunk_invalidate_new(chunk);
+
 	return chunk;
 }
 
@@ -844,6 +865,35 @@ ts_chunk_create_base(int32 id, int16 num_constraints)
 	return chunk;
 }
 
+/*
+ * Set the hypercube of a chunk with scanned constraints.
+ */
+static void
+chunk_build_cube_from_stub(Chunk *chunk, const ChunkStub *stub, MemoryContext mctx)
+{
+	/* If a stub is provided then reuse its hypercube. Note that stubs that are
+	 * results of a point or range scan might be incomplete (in terms of number
+	 * of slices and constraints). Only a chunk stub that matches in all
+	 * dimensions will have a complete hypercube. Thus, we need to check the
+	 * validity of the stub before we can reuse it.
+	 */
+	if (chunk_stub_is_valid(stub, chunk->constraints->num_dimension_constraints))
+	{
+		MemoryContext oldctx = MemoryContextSwitchTo(mctx);
+
+		chunk->cube = ts_hypercube_copy(stub->cube);
+		MemoryContextSwitchTo(oldctx);
+
+		/*
+		 * The hypercube slices were filled in during the scan. Now we need to
+		 * sort them in dimension order.
+		 */
+		ts_hypercube_slice_sort(chunk->cube);
+	}
+	else
+		chunk->cube = ts_hypercube_from_constraints(chunk->constraints, mctx);
+}
+
 /*
  * Build a chunk from a chunk tuple and a stub.
  *
@@ -873,28 +923,7 @@ chunk_build_from_tuple_and_stub(Chunk **chunkptr, TupleInfo *ti, const ChunkStub
 	 */
 	chunk->constraints =
 		ts_chunk_constraint_scan_by_chunk_id(chunk->fd.id, num_constraints_hint, ti->mctx);
-
-	/* If a stub is provided then reuse its hypercube. Note that stubs that are
-	 * results of a point or range scan might be incomplete (in terms of number
-	 * of slices and constraints). Only a chunk stub that matches in all
-	 * dimensions will have a complete hypercube. Thus, we need to check the
-	 * validity of the stub before we can reuse it.
-	 */
-	if (chunk_stub_is_valid(stub, chunk->constraints->num_dimension_constraints))
-	{
-		MemoryContext oldctx = MemoryContextSwitchTo(ti->mctx);
-
-		chunk->cube = ts_hypercube_copy(stub->cube);
-		MemoryContextSwitchTo(oldctx);
-
-		/*
-		 * The hypercube slices were filled in during the scan. Now we need to
-		 * sort them in dimension order.
-		 */
-		ts_hypercube_slice_sort(chunk->cube);
-	}
-	else
-		chunk->cube = ts_hypercube_from_constraints(chunk->constraints, ti->mctx);
+	chunk_build_cube_from_stub(chunk, stub, ti->mctx);
 
 	return chunk;
 }
@@ -977,6 +1006,144 @@ chunk_create_from_stub(ChunkStubScanCtx *stubctx)
 	return stubctx->chunk;
 }
 
+typedef struct ChunkStubPosition
+{
+	int32 chunk_id;
+	int position;
+} ChunkStubPosition;
+
+static int
+chunk_stub_position_cmp(const void *left, const void *right)
+{
+	const ChunkStubPosition *l = left;
+	const ChunkStubPosition *r = right;
+
+	return (l->chunk_id > r->chunk_id) - (l->chunk_id < r->chunk_id);
+}
+
+/*
+ * Create the chunks for many stubs at once.
+ *
+ * Instead of scanning the chunk and chunk constraint catalogs once per stub,
+ * as chunk_create_from_stub() does, all the chunks are found in a single pass
+ * over the chunk ID index, using an array of chunk IDs as scan key, and
+ * likewise for the chunk constraints.
+ *
+ * The chunk for stubs[i] is returned in chunks[i], or NULL if the chunk is
+ * dropped. The constraints and hypercube are only filled in if requested, so
+ * that callers that only need the chunk tables can skip scanning for them.
+ */
+static void
+chunks_create_from_stubs(ChunkStub **stubs, int num_stubs, Chunk **chunks, bool with_constraints,
+						 MemoryContext mctx)
+{
+	ScanIterator iterator = ts_scan_iterator_create(CHUNK, AccessShareLock, mctx);
+	ChunkStubPosition *positions;
+	Datum *chunk_ids;
+	bool *found;
+	int i;
+
+	if (num_stubs == 0)
+		return;
+
+	positions = palloc(sizeof(ChunkStubPosition) * num_stubs);
+	chunk_ids = palloc(sizeof(Datum) * num_stubs);
+	found = palloc0(sizeof(bool) * num_stubs);
+
+	for (i = 0; i < num_stubs; i++)
+	{
+		positions[i].chunk_id = stubs[i]->id;
+		positions[i].position = i;
+		chunks[i] = NULL;
+	}
+
+	qsort(positions, num_stubs, sizeof(ChunkStubPosition), chunk_stub_position_cmp);
+
+	for (i = 0; i < num_stubs; i++)
+		chunk_ids[i] = Int32GetDatum(positions[i].chunk_id);
+
+	iterator.ctx.index = catalog_get_index(ts_catalog_get(), CHUNK, CHUNK_ID_INDEX);
+	ts_scan_iterator_scan_key_init_array(&iterator,
+										 Anum_chunk_idx_id,
+										 BTEqualStrategyNumber,
+										 F_INT4EQ,
+										 INT4OID,
+										 chunk_ids,
+										 num_stubs);
+
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		FormData_chunk form;
+		ChunkStubPosition *pos;
+
+		chunk_formdata_fill(&form, ti->tuple, ti->desc);
+		pos = bsearch(&form.id,
+					  positions,
+					  num_stubs,
+					  sizeof(ChunkStubPosition),
+					  chunk_stub_position_cmp);
+
+		if (NULL == pos)
+			elog(ERROR, "unexpected chunk found with ID %d", form.id);
+
+		found[pos->position] = true;
+
+		if (form.dropped)
+			continue;
+
+		chunks[pos->position] = MemoryContextAllocZero(mctx, sizeof(Chunk));
+		chunks[pos->position]->fd = form;
+	}
+
+	for (i = 0; i < num_stubs; i++)
+	{
+		if (!found[i])
+			elog(ERROR, "no chunk found with ID %d", stubs[i]->id);
+	}
+
+	if (with_constraints)
+	{
+		/* Scan for the constraints of all non-dropped chunks in ID order */
+		int32 *constraint_chunk_ids = palloc(sizeof(int32) * num_stubs);
+		ChunkConstraints **constraints = palloc(sizeof(ChunkConstraints *) * num_stubs);
+		int num_chunks = 0;
+
+		for (i = 0; i < num_stubs; i++)
+		{
+			int position = positions[i].position;
+			Chunk *chunk = chunks[position];
+
+			if (NULL == chunk)
+				continue;
+
+			chunk->constraints =
+				ts_chunk_constraints_alloc(stubs[position]->constraints->num_constraints, mctx);
+			constraint_chunk_ids[num_chunks] = chunk->fd.id;
+			constraints[num_chunks] = chunk->constraints;
+			num_chunks++;
+		}
+
+		ts_chunk_constraint_scan_by_chunk_ids(constraint_chunk_ids, constraints, num_chunks);
+	}
+
+	for (i = 0; i < num_stubs; i++)
+	{
+		Chunk *chunk = chunks[i];
+
+		if (NULL == chunk)
+			continue;
+
+		if (with_constraints)
+			chunk_build_cube_from_stub(chunk, stubs[i], mctx);
+
+		/* Fill in table relids, like chunk_tuple_found() */
+		chunk->table_id = get_relname_relid(chunk->fd.table_name.data,
+											get_namespace_oid(chunk->fd.schema_name.data, true));
+		chunk->hypertable_relid = ts_inheritance_parent_relid(chunk->table_id);
+	}
+}
+
 /*
  * Initialize a chunk scan context.
  *
@@ -1150,33 +1317,6 @@ set_complete_chunk(ChunkScanCtx *scanctx, ChunkStub *stub)
 	return CHUNK_IGNORED;
 }
 
-typedef struct ChunkScanCtxAddChunkData
-{
-	Chunk *chunks;
-	uint64 max_chunks;
-	uint64 num_chunks;
-} ChunkScanCtxAddChunkData;
-
-static ChunkResult
-chunk_scan_context_add_chunk(ChunkScanCtx *scanctx, ChunkStub *stub)
-{
-	ChunkScanCtxAddChunkData *data = scanctx->data;
-	ChunkStubScanCtx stubctx = {
-		.chunk = &data->chunks[data->num_chunks],
-		.stub = stub,
-	};
-
-	Assert(data->num_chunks < data->max_chunks);
-	chunk_create_from_stub(&stubctx);
-
-	if (stubctx.is_dropped)
-		return CHUNK_IGNORED;
-
-	data->num_chunks++;
-
-	return CHUNK_PROCESSED;
-}
-
 /* Finds the first chunk that has a complete set of constraints. There should be
  * only one such chunk in the scan context when scanning for the chunk that
  * holds a particular tuple/point. */
@@ -1463,76 +1603,55 @@ chunks_typecheck_and_find_all_in_range_limit(Hyperspace *hs, Dimension *time_dim
 	return chunk_ctx;
 }
 
-static ChunkResult
-append_chunk_common(ChunkScanCtx *scanctx, ChunkStub *stub, Chunk **chunk)
+typedef struct ChunkStubArray
 {
-	ChunkStubScanCtx stubctx = {
-		.stub = stub,
-	};
-
-	*chunk = NULL;
-
-	if (!chunk_stub_is_complete(stub, scanctx->space))
-		return CHUNK_IGNORED;
+	ChunkStub **stubs;
+	int num_stubs;
+	int max_stubs;
+} ChunkStubArray;
 
-	/* Fill in the rest of the chunk's data from the chunk table */
-	*chunk = chunk_create_from_stub(&stubctx);
-
-	if (stubctx.is_dropped)
-		return CHUNK_IGNORED;
-
-	Assert(OidIsValid((*chunk)->table_id));
-
-	if (scanctx->lockmode != NoLock)
-		LockRelationOid((*chunk)->table_id, scanctx->lockmode);
-
-	return CHUNK_PROCESSED;
+static void
+chunk_stub_array_init(ChunkStubArray *array, ChunkScanCtx *scanctx)
+{
+	array->num_stubs = 0;
+	array->max_stubs = hash_get_num_entries(scanctx->htab);
+	array->stubs = palloc(sizeof(ChunkStub *) * Max(array->max_stubs, 1));
 }
 
 static ChunkResult
-append_chunk_oid(ChunkScanCtx *scanctx, ChunkStub *stub)
+append_stub(ChunkScanCtx *scanctx, ChunkStub *stub)
 {
-	Chunk *chunk;
-	ChunkResult res = append_chunk_common(scanctx, stub, &chunk);
+	ChunkStubArray *array = scanctx->data;
 
-	if (res == CHUNK_PROCESSED)
-	{
-		Assert(chunk != NULL);
-		scanctx->data = lappend_oid(scanctx->data, chunk->table_id);
-	}
+	Assert(array->num_stubs < array->max_stubs);
+	array->stubs[array->num_stubs++] = stub;
 
-	return res;
+	return CHUNK_PROCESSED;
 }
 
 static ChunkResult
-append_chunk(ChunkScanCtx *scanctx, ChunkStub *stub)
+append_complete_stub(ChunkScanCtx *scanctx, ChunkStub *stub)
 {
-	Chunk *chunk;
-	ChunkResult res = append_chunk_common(scanctx, stub, &chunk);
-
-	if (res == CHUNK_PROCESSED)
-	{
-		Chunk **chunks = scanctx->data;
-
-		Assert(chunk != NULL);
-
-		if (NULL == chunks && scanctx->num_complete_chunks > 0)
-			scanctx->data = chunks = palloc(sizeof(Chunk *) * scanctx->num_complete_chunks);
-
-		Assert(scanctx->num_processed < scanctx->num_complete_chunks);
-		chunks[scanctx->num_processed] = chunk;
-	}
+	if (!chunk_stub_is_complete(stub, scanctx->space))
+		return CHUNK_IGNORED;
 
-	return res;
+	return append_stub(scanctx, stub);
 }
 
-static void *
-chunk_find_all(Hyperspace *hs, List *dimension_vecs, on_chunk_stub_func on_chunk, LOCKMODE lockmode,
+/*
+ * Find all the chunks matching the dimension slices in the given vectors, in
+ * scan order. Dropped chunks are skipped and the remaining chunk tables are
+ * locked in the given lock mode.
+ */
+static Chunk **
+chunk_find_all(Hyperspace *hs, List *dimension_vecs, bool with_constraints, LOCKMODE lockmode,
 			   unsigned int *num_chunks)
 {
 	ChunkScanCtx ctx;
+	ChunkStubArray array;
+	Chunk **chunks;
 	ListCell *lc;
-	int num_processed;
+	int i;
 
 	/* The scan context will keep the state accumulated during the scan */
 	chunk_scan_ctx_init(&ctx, hs, NULL);
@@ -1549,21 +1668,42 @@ chunk_find_all(Hyperspace *hs, List *dimension_vecs, on_chunk_stub_func on_chunk
 		dimension_slice_and_chunk_constraint_join(&ctx, vec);
 	}
 
-	ctx.data = NULL;
-	num_processed = chunk_scan_ctx_foreach_chunk_stub(&ctx, on_chunk, 0);
+	chunk_stub_array_init(&array, &ctx);
+	ctx.data = &array;
+	chunk_scan_ctx_foreach_chunk_stub(&ctx, append_complete_stub, 0);
 
-	if (NULL != num_chunks)
-		*num_chunks = num_processed;
+	chunks = palloc(sizeof(Chunk *) * Max(array.num_stubs, 1));
+	chunks_create_from_stubs(array.stubs,
+							 array.num_stubs,
+							 chunks,
+							 with_constraints,
+							 CurrentMemoryContext);
+	*num_chunks = 0;
+
+	for (i = 0; i < array.num_stubs; i++)
+	{
+		Chunk *chunk = chunks[i];
+
+		if (NULL == chunk)
+			continue;
+
+		Assert(OidIsValid(chunk->table_id));
+
+		if (lockmode != NoLock)
+			LockRelationOid(chunk->table_id, lockmode);
+
+		chunks[(*num_chunks)++] = chunk;
+	}
 
 	chunk_scan_ctx_destroy(&ctx);
 
-	return ctx.data;
+	return chunks;
 }
 
 Chunk **
 ts_chunk_find_all(Hyperspace *hs, List *dimension_vecs, LOCKMODE lockmode, unsigned int *num_chunks)
 {
-	Chunk **chunks = chunk_find_all(hs, dimension_vecs, append_chunk, lockmode, num_chunks);
+	Chunk **chunks = chunk_find_all(hs, dimension_vecs, true, lockmode, num_chunks);
 
 #ifdef USE_ASSERT_CHECKING
 	/* Assert that we never return dropped chunks */
@@ -1579,20 +1719,28 @@ ts_chunk_find_all(Hyperspace *hs, List *dimension_vecs, LOCKMODE lockmode, unsig
 List *
 ts_chunk_find_all_oids(Hyperspace *hs, List *dimension_vecs, LOCKMODE lockmode)
 {
-	List *chunks = chunk_find_all(hs, dimension_vecs, append_chunk_oid, lockmode, NULL);
+	unsigned int num_chunks;
+	Chunk **chunks = chunk_find_all(hs, dimension_vecs, false, lockmode, &num_chunks);
+	List *chunk_oids = NIL;
+	unsigned int i;
 
-#ifdef USE_ASSERT_CHECKING
-	/* Assert that we never return dropped chunks */
-	ListCell *lc;
+	for (i = 0; i < num_chunks; i++)
+		chunk_oids = lappend_oid(chunk_oids, chunks[i]->table_id);
 
-	foreach (lc, chunks)
+#ifdef USE_ASSERT_CHECKING
 	{
-		Chunk *chunk = ts_chunk_get_by_relid(lfirst_oid(lc), true);
-		ASSERT_IS_VALID_CHUNK(chunk);
+		/* Assert that we never return dropped chunks */
+		ListCell *lc;
+
+		foreach (lc, chunk_oids)
+		{
+			Chunk *chunk = ts_chunk_get_by_relid(lfirst_oid(lc), true);
+			ASSERT_IS_VALID_CHUNK(chunk);
+		}
 	}
 #endif
 
-	return chunks;
+	return chunk_oids;
 }
 
 /* show_chunks SQL function handler */
@@ -1642,7 +1790,6 @@ ts_chunk_get_chunks_in_time_range(Oid table_relid, Datum older_than_datum, Datum
 	MemoryContext oldcontext;
 	ChunkScanCtx **chunk_scan_ctxs;
 	Chunk *chunks;
-	ChunkScanCtxAddChunkData data;
 	Cache *hypertable_cache;
 	Hypertable *ht;
 	Dimension *time_dim;
@@ -1726,17 +1873,31 @@ ts_chunk_get_chunks_in_time_range(Oid table_relid, Datum older_than_datum, Datum
 	}
 
 	chunks = MemoryContextAllocZero(mctx, sizeof(Chunk) * num_chunks);
-	data = (ChunkScanCtxAddChunkData){
-		.chunks = chunks,
-		.max_chunks = num_chunks,
-		.num_chunks = 0,
-	};
+	*num_chunks_returned = 0;
 
 	for (i = 0; i < list_length(hypertables); i++)
 	{
+		ChunkStubArray array;
+		Chunk **ht_chunks;
+		int j;
+
 		/* Get all the chunks from the context */
-		chunk_scan_ctxs[i]->data = &data;
-		chunk_scan_ctx_foreach_chunk_stub(chunk_scan_ctxs[i], chunk_scan_context_add_chunk, -1);
+		chunk_stub_array_init(&array, chunk_scan_ctxs[i]);
+		chunk_scan_ctxs[i]->data = &array;
+		chunk_scan_ctx_foreach_chunk_stub(chunk_scan_ctxs[i], append_stub, -1);
+
+		ht_chunks = palloc(sizeof(Chunk *) * Max(array.num_stubs, 1));
+		chunks_create_from_stubs(array.stubs, array.num_stubs, ht_chunks, true, mctx);
+
+		for (j = 0; j < array.num_stubs; j++)
+		{
+			if (NULL == ht_chunks[j])
+				continue;
+
+			Assert(*num_chunks_returned < num_chunks);
+			chunks[(*num_chunks_returned)++] = *ht_chunks[j];
+		}
+
 		/*
 		 * only affects ctx.htab Got all the chunk already so can now safely
 		 * destroy the context
@@ -1744,7 +1905,6 @@ ts_chunk_get_chunks_in_time_range(Oid table_relid, Datum older_than_datum, Datum
 		chunk_scan_ctx_destroy(chunk_scan_ctxs[i]);
 	}
 
-	*num_chunks_returned = data.num_chunks;
 	qsort(chunks, *num_chunks_returned, sizeof(Chunk), chunk_cmp);
 
 	ts_cache_release(hypertable_cache);
@@ -2225,6 +2385,8 @@ chunk_tuple_delete(TupleInfo *ti, DropBehavior behavior, bool preserve_chunk_cat
 	/* Delete any row in bgw_policy_chunk-stats corresponding to this chunk */
 	ts_bgw_policy_chunk_stats_delete_by_chunk_id(form.id);
 
+	ts_chunk_column_stats_delete_by_chunk_id(form.hypertable_id, form.id);
+
 	if (form.compressed_chunk_id != INVALID_CHUNK_ID)
 	{
 		Chunk *compressed_chunk = ts_chunk_get_by_id(form.compressed_chunk_id, false);
@@ -2365,6 +2527,48 @@ ts_chunk_delete_by_hypertable_id(int32 hypertable_id)
 	return chunk_delete(&iterator, DROP_RESTRICT, false);
 }
 
+/*
+ * Get the IDs and relids of all chunks of a hypertable, skipping dropped
+ * chunks. Returns the number of chunks found.
+ */
+int
+ts_chunk_get_relids_by_hypertable_id(int32 hypertable_id, int32 **chunk_ids, Oid **relids)
+{
+	ScanIterator iterator = ts_scan_iterator_create(CHUNK, AccessShareLock, CurrentMemoryContext);
+	int capacity = 64;
+	int num_chunks = 0;
+
+	*chunk_ids = palloc(sizeof(int32) * capacity);
+	*relids = palloc(sizeof(Oid) * capacity);
+
+	init_scan_by_hypertable_id(&iterator, hypertable_id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		FormData_chunk fd;
+
+		chunk_formdata_fill(&fd, ti->tuple, ti->desc);
+
+		if (fd.dropped)
+			continue;
+
+		if (num_chunks == capacity)
+		{
+			capacity *= 2;
+			*chunk_ids = repalloc(*chunk_ids, sizeof(int32) * capacity);
+			*relids = repalloc(*relids, sizeof(Oid) * capacity);
+		}
+
+		(*chunk_ids)[num_chunks] = fd.id;
+		(*relids)[num_chunks] =
+			get_relname_relid(NameStr(fd.table_name),
+							  get_namespace_oid(NameStr(fd.schema_name), true));
+		num_chunks++;
+	}
+
+	return num_chunks;
+}
+
 bool
 ts_chunk_exists_with_compression(int32 hypertable_id)
 {
@@ -105,6 +105,8 @@ extern Chunk *ts_chunk_find(Hypertable *ht, Point *p);
 extern Chunk **ts_chunk_find_all(Hyperspace *hs, List *dimension_vecs, LOCKMODE lockmode,
 								 unsigned int *num_chunks);
 extern List *ts_chunk_find_all_oids(Hyperspace *hs, List *dimension_vecs, LOCKMODE lockmode);
+extern int ts_chunk_get_relids_by_hypertable_id(int32 hypertable_id, int32 **chunk_ids,
+												Oid **relids);
 extern TSDLLEXPORT int ts_chunk_add_constraints(Chunk *chunk);
 
 extern Chunk *ts_chunk_copy(Chunk *chunk);
@@ -112,6 +114,7 @@ extern Chunk *ts_chunk_get_by_name_with_memory_context(const char *schema_name,
 													   const char *table_name, MemoryContext mctx,
 													   bool fail_if_not_found);
 extern TSDLLEXPORT void ts_chunk_insert_lock(Chunk *chunk, LOCKMODE lock);
+extern TSDLLEXPORT void ts_chunk_invalidate_new(Chunk *chunk);
 
 extern TSDLLEXPORT Oid ts_chunk_create_table(Chunk *chunk, Hypertable *ht,
 											 const char *tablespacename);
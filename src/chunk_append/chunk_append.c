@@ -24,8 +24,9 @@
 #include "func_cache.h"
 #include "guc.h"
 
-static bool contain_param_exec(Node *node);
-static bool contain_param_exec_walker(Node *node, void *context);
+static bool contain_param_kind(Node *node, ParamKind kind);
+static bool contain_param_kind_walker(Node *node, void *context);
+static bool references_partitioning_column(Node *clause, Index relid, Hypertable *ht);
 static Var *find_equality_join_var(Var *sort_var, Index ht_relid, Oid eq_opr,
 								   List *join_conditions);
 
@@ -34,6 +35,13 @@ static CustomPathMethods chunk_append_path_methods = {
 	.PlanCustomPath = ts_chunk_append_plan_create,
 };
 
+bool
+ts_is_chunk_append_path(Path *path)
+{
+	return IsA(path, CustomPath) &&
+		   castNode(CustomPath, path)->methods == &chunk_append_path_methods;
+}
+
 static bool
 has_joins(FromExpr *jointree)
 {
@@ -101,31 +109,24 @@ ts_chunk_append_path_create(PlannerInfo *root, RelOptInfo *rel, Hypertable *ht,
 		if (contain_mutable_functions((Node *) rinfo->clause))
 			path->startup_exclusion = true;
 
-		if (ts_guc_enable_runtime_exclusion && contain_param_exec((Node *) rinfo->clause))
-		{
-			ListCell *lc_var;
+		/*
+		 * External params are only left in generic plans of prepared
+		 * statements, where the plan has all chunks of the hypertable
+		 * and the chunks are excluded on executor startup based on the
+		 * parameter values of each execution
+		 */
+		if (contain_param_kind((Node *) rinfo->clause, PARAM_EXTERN) &&
+			references_partitioning_column((Node *) rinfo->clause, rel->relid, ht))
+			path->startup_exclusion = true;
 
-			/*
-			 * check the param references a partitioning column of the hypertable
-			 * otherwise we skip runtime exclusion
-			 */
-			foreach (lc_var, pull_var_clause((Node *) rinfo->clause, 0))
-			{
-				Var *var = lfirst(lc_var);
-				/*
-				 * varattno 0 is whole row and varattno less than zero are
-				 * system columns so we skip those even though
-				 * ts_is_partitioning_column would return the correct
-				 * answer for those as well
-				 */
-				if (var->varno == rel->relid && var->varattno > 0 &&
-					ts_is_partitioning_column(ht, var->varattno))
-				{
-					path->runtime_exclusion = true;
-					break;
-				}
-			}
-		}
+		/*
+		 * check the param references a partitioning column of the hypertable
+		 * otherwise we skip runtime exclusion
+		 */
+		if (ts_guc_enable_runtime_exclusion &&
+			contain_param_kind((Node *) rinfo->clause, PARAM_EXEC) &&
+			references_partitioning_column((Node *) rinfo->clause, rel->relid, ht))
+			path->runtime_exclusion = true;
 	}
 
 	/*
@@ -407,21 +408,46 @@ ts_ordered_append_should_optimize(PlannerInfo *root, RelOptInfo *rel, Hypertable
 }
 
 static bool
-contain_param_exec(Node *node)
+contain_param_kind(Node *node, ParamKind kind)
 {
-	return contain_param_exec_walker(node, NULL);
+	return contain_param_kind_walker(node, &kind);
 }
 
 static bool
-contain_param_exec_walker(Node *node, void *context)
+contain_param_kind_walker(Node *node, void *context)
 {
 	if (node == NULL)
 		return false;
 
 	if (IsA(node, Param))
-		return castNode(Param, node)->paramkind == PARAM_EXEC;
+		return castNode(Param, node)->paramkind == *(ParamKind *) context;
+
+	return expression_tree_walker(node, contain_param_kind_walker, context);
+}
+
+/*
+ * Check if a clause references a partitioning column of the hypertable
+ */
+static bool
+references_partitioning_column(Node *clause, Index relid, Hypertable *ht)
+{
+	ListCell *lc;
+
+	foreach (lc, pull_var_clause(clause, 0))
+	{
+		Var *var = lfirst(lc);
+		/*
+		 * varattno 0 is whole row and varattno less than zero are
+		 * system columns so we skip those even though
+		 * ts_is_partitioning_column would return the correct
+		 * answer for those as well
+		 */
+		if (var->varno == relid && var->varattno > 0 &&
+			ts_is_partitioning_column(ht, var->varattno))
+			return true;
+	}
 
-	return expression_tree_walker(node, contain_param_exec_walker, context);
+	return false;
 }
 
 /*
@@ -24,6 +24,8 @@ extern Path *ts_chunk_append_path_create(PlannerInfo *root, RelOptInfo *rel, Hyp
 										 Path *subpath, bool parallel_aware, bool ordered,
 										 List *nested_oids);
 
+extern bool ts_is_chunk_append_path(Path *path);
+
 extern bool ts_ordered_append_should_optimize(PlannerInfo *root, RelOptInfo *rel, Hypertable *ht,
 											  List *join_conditions, int *order_attno,
 											  bool *reverse);
@@ -17,6 +17,8 @@
 #include <optimizer/restrictinfo.h>
 #include <parser/parsetree.h>
 #include <rewrite/rewriteManip.h>
+#include <utils/array.h>
+#include <utils/lsyscache.h>
 #include <utils/memutils.h>
 #include <utils/typcache.h>
 
@@ -34,7 +36,13 @@
 #include "chunk_append/chunk_append.h"
 #include "chunk_append/explain.h"
 #include "chunk_append/planner.h"
+#include "chunk.h"
+#include "chunk_column_stats.h"
+#include "dimension.h"
+#include "dimension_slice_index.h"
+#include "hypertable_cache.h"
 #include "loader/lwlocks.h"
+#include "utils.h"
 
 #define INVALID_SUBPLAN_INDEX -1
 #define NO_MATCHING_SUBPLANS -2
@@ -71,11 +79,15 @@ static void choose_next_subplan_for_worker(ChunkAppendState *state);
 
 static List *constify_restrictinfos(PlannerInfo *root, List *restrictinfos);
 static bool can_exclude_chunk(List *constraints, List *restrictinfos);
+static bool can_exclude_chunk_by_slices(List *constraints, List *slice_ranges, Index scanrelid,
+										List *restrictinfos);
 static void do_startup_exclusion(ChunkAppendState *state);
 static Node *constify_param_mutator(Node *node, void *context);
 static List *constify_restrictinfo_params(PlannerInfo *root, EState *state, List *restrictinfos);
 
 static void initialize_constraints(ChunkAppendState *state, List *initial_rt_indexes);
+static List *get_chunk_slice_ranges(Hypertable *ht, Dimension *dimensions, Oid relid,
+									HTAB *column_ranges);
 static LWLock *chunk_append_get_lock_pointer(void);
 
 Node *
@@ -117,17 +129,21 @@ do_startup_exclusion(ChunkAppendState *state)
 	List *filtered_children = NIL;
 	List *filtered_ri_clauses = NIL;
 	List *filtered_constraints = NIL;
+	List *filtered_slice_ranges = NIL;
 	ListCell *lc_plan;
 	ListCell *lc_clauses;
 	ListCell *lc_constraints;
+	ListCell *lc_slice_ranges = list_head(state->initial_slice_ranges);
 	int i = -1;
 	int filtered_first_partial_plan = state->first_partial_plan;
 
 	/*
-	 * create skeleton plannerinfo for estimate_expression_value
+	 * create skeleton plannerinfo for estimate_expression_value, with the
+	 * values of external parameters so that generic plans of prepared
+	 * statements exclude chunks based on the parameters of each execution
 	 */
 	PlannerGlobal glob = {
-		.boundParams = NULL,
+		.boundParams = state->csstate.ss.ps.state->es_param_list_info,
 	};
 	PlannerInfo root = {
 		.glob = &glob,
@@ -138,6 +154,7 @@ do_startup_exclusion(ChunkAppendState *state)
 	 */
 	Assert(list_length(state->initial_subplans) == list_length(state->initial_ri_clauses));
 	Assert(list_length(state->initial_subplans) == list_length(state->initial_constraints));
+	Assert(list_length(state->initial_subplans) == list_length(state->initial_slice_ranges));
 
 	forthree (lc_plan,
 			  state->initial_subplans,
@@ -148,10 +165,12 @@ do_startup_exclusion(ChunkAppendState *state)
 	{
 		List *restrictinfos = NIL;
 		List *ri_clauses = lfirst(lc_clauses);
+		List *slice_ranges = lfirst(lc_slice_ranges);
 		ListCell *lc;
 		Scan *scan = ts_chunk_append_get_scan_plan(lfirst(lc_plan));
 
 		i++;
+		lc_slice_ranges = lnext(lc_slice_ranges);
 
 		/*
 		 * If this is a base rel (chunk), check if it can be
@@ -167,7 +186,10 @@ do_startup_exclusion(ChunkAppendState *state)
 			}
 			restrictinfos = constify_restrictinfos(&root, restrictinfos);
 
-			if (can_exclude_chunk(lfirst(lc_constraints), restrictinfos))
+			if (can_exclude_chunk_by_slices(lfirst(lc_constraints),
+											slice_ranges,
+											scan->scanrelid,
+											restrictinfos))
 			{
 				if (i < state->first_partial_plan)
 					filtered_first_partial_plan--;
@@ -194,11 +216,13 @@ do_startup_exclusion(ChunkAppendState *state)
 		filtered_children = lappend(filtered_children, lfirst(lc_plan));
 		filtered_ri_clauses = lappend(filtered_ri_clauses, ri_clauses);
 		filtered_constraints = lappend(filtered_constraints, lfirst(lc_constraints));
+		filtered_slice_ranges = lappend(filtered_slice_ranges, slice_ranges);
 	}
 
 	state->filtered_subplans = filtered_children;
 	state->filtered_ri_clauses = filtered_ri_clauses;
 	state->filtered_constraints = filtered_constraints;
+	state->filtered_slice_ranges = filtered_slice_ranges;
 	state->filtered_first_partial_plan = filtered_first_partial_plan;
 }
 
@@ -288,7 +312,7 @@ chunk_append_begin(CustomScanState *node, EState *estate, int eflags)
 static void
 initialize_runtime_exclusion(ChunkAppendState *state)
 {
-	ListCell *lc_clauses, *lc_constraints;
+	ListCell *lc_clauses, *lc_constraints, *lc_slice_ranges;
 	int i = 0;
 
 	PlannerGlobal glob = {
@@ -302,6 +326,7 @@ initialize_runtime_exclusion(ChunkAppendState *state)
 
 	lc_clauses = list_head(state->filtered_ri_clauses);
 	lc_constraints = list_head(state->filtered_constraints);
+	lc_slice_ranges = list_head(state->filtered_slice_ranges);
 
 	if (state->num_subplans == 0)
 	{
@@ -337,7 +362,10 @@ initialize_runtime_exclusion(ChunkAppendState *state)
 			}
 			restrictinfos = constify_restrictinfo_params(&root, ps->state, restrictinfos);
 
-			can_exclude = can_exclude_chunk(lfirst(lc_constraints), restrictinfos);
+			can_exclude = can_exclude_chunk_by_slices(lfirst(lc_constraints),
+													  lfirst(lc_slice_ranges),
+													  scan->scanrelid,
+													  restrictinfos);
 
 			MemoryContextReset(state->exclusion_ctx);
 			MemoryContextSwitchTo(old);
@@ -350,6 +378,7 @@ initialize_runtime_exclusion(ChunkAppendState *state)
 
 		lc_clauses = lnext(lc_clauses);
 		lc_constraints = lnext(lc_constraints);
+		lc_slice_ranges = lnext(lc_slice_ranges);
 	}
 
 	state->runtime_initialized = true;
@@ -784,6 +813,458 @@ constify_param_mutator(Node *node, void *context)
 	return expression_tree_mutator(node, constify_param_mutator, context);
 }
 
+/*
+ * The range of a chunk's dimension slice in one dimension.
+ *
+ * Chunks can be excluded by comparing constified restrictions on dimension
+ * columns directly against the slice ranges, which is a lot cheaper than
+ * proving that the restrictions refute the chunk's CHECK constraints. This
+ * matters for runtime exclusion, which happens on every rescan with new
+ * parameter values.
+ *
+ * The ranges of columns with chunk column stats are checked the same way.
+ * They have no dimension.
+ */
+typedef struct ChunkSliceRange
+{
+	AttrNumber attno; /* attribute number of the dimension column in the chunk */
+	Oid column_type;
+	Dimension *dimension; /* NULL for chunk column stats */
+	int64 range_start;
+	int64 range_end;
+} ChunkSliceRange;
+
+/*
+ * Get the slice ranges of a chunk in all its dimensions, followed by the valid
+ * ranges of its columns with chunk column stats, if any. Returns NIL if the
+ * relation is not a chunk of the hypertable or the hypertable has no slice
+ * index, in which case chunks are only excluded based on their constraints.
+ *
+ * The slices are looked up in the hypertable's cached slice index, so that
+ * there is no catalog scan for each chunk. The index is only valid until the
+ * next invalidation, so the ranges are copied and no syscache lookups happen
+ * while the index is used. The ranges reference the given copies of the
+ * hypertable's dimensions, so that the hypertable cache need not stay pinned.
+ */
+static List *
+get_chunk_slice_ranges(Hypertable *ht, Dimension *dimensions, Oid relid, HTAB *column_ranges)
+{
+	HypertableSliceIndex *index;
+	const SliceIndexChunk *index_chunk;
+	ChunkColumnRanges *entry;
+	List *slice_ranges = NIL;
+	AttrNumber *attnos = palloc(sizeof(AttrNumber) * ht->space->num_dimensions);
+	ListCell *lc;
+	int i;
+
+	for (i = 0; i < ht->space->num_dimensions; i++)
+		attnos[i] = get_attnum(relid, NameStr(dimensions[i].fd.column_name));
+
+	index = ts_hypertable_slice_index_get(ht);
+
+	if (NULL == index)
+		return NIL;
+
+	index_chunk = ts_hypertable_slice_index_get_chunk(index, relid);
+
+	if (NULL == index_chunk)
+		return NIL;
+
+	for (i = 0; i < ht->space->num_dimensions; i++)
+	{
+		const DimensionSlice *slice = index_chunk->slices[i];
+		ChunkSliceRange *range;
+
+		if (NULL == slice || attnos[i] == InvalidAttrNumber)
+			continue;
+
+		range = palloc(sizeof(ChunkSliceRange));
+		range->attno = attnos[i];
+		range->column_type = dimensions[i].fd.column_type;
+		range->dimension = &dimensions[i];
+		range->range_start = slice->fd.range_start;
+		range->range_end = slice->fd.range_end;
+		slice_ranges = lappend(slice_ranges, range);
+	}
+
+	if (NULL == column_ranges)
+		return slice_ranges;
+
+	entry = hash_search(column_ranges, &index_chunk->chunk_id, HASH_FIND, NULL);
+
+	if (NULL == entry)
+		return slice_ranges;
+
+	foreach (lc, entry->ranges)
+	{
+		ChunkColumnRange *column_range = lfirst(lc);
+		ChunkSliceRange *range;
+		AttrNumber attno = get_attnum(relid, NameStr(column_range->column_name));
+
+		if (attno == InvalidAttrNumber)
+			continue;
+
+		range = palloc(sizeof(ChunkSliceRange));
+		range->attno = attno;
+		range->column_type = get_atttype(relid, attno);
+		range->dimension = NULL;
+		range->range_start = column_range->range_start;
+		range->range_end = column_range->range_end;
+		slice_ranges = lappend(slice_ranges, range);
+	}
+
+	return slice_ranges;
+}
+
+/*
+ * Copy the dimensions of a hypertable, including their partitioning functions,
+ * into the current memory context.
+ */
+static Dimension *
+copy_dimensions(Hyperspace *space)
+{
+	Dimension *dimensions = palloc(sizeof(Dimension) * space->num_dimensions);
+	int i;
+
+	memcpy(dimensions, space->dimensions, sizeof(Dimension) * space->num_dimensions);
+
+	for (i = 0; i < space->num_dimensions; i++)
+	{
+		PartitioningInfo *partitioning = space->dimensions[i].partitioning;
+		FmgrInfo *flinfo;
+
+		if (NULL == partitioning)
+			continue;
+
+		dimensions[i].partitioning = palloc(sizeof(PartitioningInfo));
+		memcpy(dimensions[i].partitioning, partitioning, sizeof(PartitioningInfo));
+		flinfo = &dimensions[i].partitioning->partfunc.func_fmgr;
+		fmgr_info_copy(flinfo, &partitioning->partfunc.func_fmgr, CurrentMemoryContext);
+		fmgr_info_set_expr(copyObject(partitioning->partfunc.func_fmgr.fn_expr), flinfo);
+	}
+
+	return dimensions;
+}
+
+/*
+ * Transform a constant into the value space of a dimension's slices.
+ * Returns false if the constant cannot be compared against the slices.
+ */
+static bool
+slice_range_get_value(ChunkSliceRange *range, Datum datum, Oid type, Oid collation, int64 *value)
+{
+	Dimension *dim = range->dimension;
+	TimevalInfinity is_infinite = TimevalFinite;
+	Oid restype;
+
+	if (NULL == dim)
+	{
+		if (!ts_chunk_column_stats_types_compatible(range->column_type, type))
+			return false;
+
+		*value = ts_chunk_column_stats_value(datum, type);
+		return true;
+	}
+
+	if (type != range->column_type)
+		return false;
+
+	datum = ts_dimension_transform_value(dim, collation, datum, type, &restype);
+
+	if (dim->type == DIMENSION_TYPE_CLOSED)
+	{
+		*value = DatumGetInt32(datum);
+		return true;
+	}
+
+	*value = ts_time_value_to_internal_or_infinite(datum, restype, &is_infinite);
+
+	return is_infinite == TimevalFinite;
+}
+
+/*
+ * Check if no value in the slice range satisfies "column <strategy> value".
+ */
+static bool
+slice_range_excludes(ChunkSliceRange *range, StrategyNumber strategy, int64 value)
+{
+	int64 last;
+
+	if (NULL == range->dimension)
+		return ts_chunk_column_stats_range_excludes(range->range_start,
+													range->range_end,
+													strategy,
+													value);
+
+	/* Only equality can be checked against hash partitions */
+	if (range->dimension->type == DIMENSION_TYPE_CLOSED && strategy != BTEqualStrategyNumber)
+		return false;
+
+	/*
+	 * The range end is exclusive, except for the unbounded end of the last
+	 * slice, which also holds DIMENSION_SLICE_MAXVALUE itself.
+	 */
+	if (range->range_end == DIMENSION_SLICE_MAXVALUE)
+		last = DIMENSION_SLICE_MAXVALUE;
+	else
+		last = range->range_end - 1;
+
+	switch (strategy)
+	{
+		case BTLessStrategyNumber:
+			return range->range_start >= value;
+		case BTLessEqualStrategyNumber:
+			return range->range_start > value;
+		case BTEqualStrategyNumber:
+			return value < range->range_start || value > last;
+		case BTGreaterEqualStrategyNumber:
+			return value > last;
+		case BTGreaterStrategyNumber:
+			return value >= last;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Find the slice range and comparison strategy for a "Var op Const" clause
+ * on a dimension column. Returns the Const argument, or NULL if the clause
+ * cannot be checked against the slice ranges.
+ */
+static Const *
+slice_range_match_clause(List *slice_ranges, Index scanrelid, List *args, Oid opno,
+						 ChunkSliceRange **range_out, StrategyNumber *strategy)
+{
+	Node *left, *right;
+	Var *var;
+	Node *other;
+	TypeCacheEntry *tce;
+	ChunkSliceRange *range = NULL;
+	ListCell *lc;
+	int op_strategy;
+	Oid lefttype, righttype;
+
+	if (list_length(args) != 2)
+		return NULL;
+
+	left = linitial(args);
+	right = lsecond(args);
+
+	if (IsA(left, RelabelType))
+		left = (Node *) ((RelabelType *) left)->arg;
+	if (IsA(right, RelabelType))
+		right = (Node *) ((RelabelType *) right)->arg;
+
+	if (IsA(left, Var))
+	{
+		var = (Var *) left;
+		other = right;
+	}
+	else if (IsA(right, Var))
+	{
+		var = (Var *) right;
+		other = left;
+		opno = get_commutator(opno);
+	}
+	else
+		return NULL;
+
+	if (var->varno != scanrelid || var->varlevelsup != 0 || !IsA(other, Const) ||
+		!OidIsValid(opno) || !op_strict(opno))
+		return NULL;
+
+	foreach (lc, slice_ranges)
+	{
+		ChunkSliceRange *r = lfirst(lc);
+
+		if (r->attno == var->varattno)
+		{
+			range = r;
+			break;
+		}
+	}
+
+	if (NULL == range)
+		return NULL;
+
+	tce = lookup_type_cache(range->column_type, TYPECACHE_BTREE_OPFAMILY);
+
+	if (!OidIsValid(tce->btree_opf) || !op_in_opfamily(opno, tce->btree_opf))
+		return NULL;
+
+	get_op_opfamily_properties(opno, tce->btree_opf, false, &op_strategy, &lefttype, &righttype);
+
+	/* Column stats also support comparisons with other integer types */
+	if (lefttype != range->column_type ||
+		(NULL == range->dimension ?
+			 !ts_chunk_column_stats_types_compatible(range->column_type, righttype) :
+			 righttype != range->column_type))
+		return NULL;
+
+	*range_out = range;
+	*strategy = op_strategy;
+
+	return (Const *) other;
+}
+
+/*
+ * Check if a clause on a dimension column excludes a chunk based on the
+ * chunk's slice ranges. Sets handled to true if the clause could be fully
+ * checked against the slice ranges, in which case there is no need to also
+ * check it against the chunk's constraints. A clause that is not refuted by
+ * the ranges of a column with chunk column stats is not handled, since the
+ * column might still have constraints that refute it.
+ */
+static bool
+slice_ranges_exclude_clause(List *slice_ranges, Index scanrelid, Expr *clause, bool *handled)
+{
+	ChunkSliceRange *range;
+	StrategyNumber strategy;
+	Const *c;
+	int64 value;
+	bool excluded;
+
+	*handled = false;
+
+	if (IsA(clause, OpExpr))
+	{
+		OpExpr *op = (OpExpr *) clause;
+
+		c = slice_range_match_clause(slice_ranges,
+									 scanrelid,
+									 op->args,
+									 op->opno,
+									 &range,
+									 &strategy);
+
+		if (NULL == c)
+			return false;
+
+		/* strict operators never match NULL */
+		if (c->constisnull)
+		{
+			*handled = true;
+			return true;
+		}
+
+		if (!slice_range_get_value(range, c->constvalue, c->consttype, c->constcollid, &value))
+			return false;
+
+		excluded = slice_range_excludes(range, strategy, value);
+		*handled = excluded || NULL != range->dimension;
+		return excluded;
+	}
+	else if (IsA(clause, ScalarArrayOpExpr))
+	{
+		ScalarArrayOpExpr *op = (ScalarArrayOpExpr *) clause;
+		ArrayType *array;
+		Datum *elems;
+		bool *nulls;
+		int num_elems;
+		int16 elemlen;
+		bool elembyval;
+		char elemalign;
+		int num_excluded = 0;
+		int i;
+
+		c = slice_range_match_clause(slice_ranges,
+									 scanrelid,
+									 op->args,
+									 op->opno,
+									 &range,
+									 &strategy);
+
+		/* The array must be on the right-hand side */
+		if (NULL == c || c != lsecond(op->args) || c->constisnull)
+			return false;
+
+		array = DatumGetArrayTypeP(c->constvalue);
+
+		if (NULL == range->dimension ?
+				!ts_chunk_column_stats_types_compatible(range->column_type, ARR_ELEMTYPE(array)) :
+				ARR_ELEMTYPE(array) != range->column_type)
+			return false;
+
+		get_typlenbyvalalign(ARR_ELEMTYPE(array), &elemlen, &elembyval, &elemalign);
+		deconstruct_array(array,
+						  ARR_ELEMTYPE(array),
+						  elemlen,
+						  elembyval,
+						  elemalign,
+						  &elems,
+						  &nulls,
+						  &num_elems);
+
+		for (i = 0; i < num_elems; i++)
+		{
+			if (nulls[i])
+			{
+				num_excluded++;
+				continue;
+			}
+
+			if (!slice_range_get_value(range,
+									   elems[i],
+									   ARR_ELEMTYPE(array),
+									   c->constcollid,
+									   &value))
+				return false;
+
+			if (slice_range_excludes(range, strategy, value))
+			{
+				/* Excluding a single value is enough to exclude "op ALL" */
+				if (!op->useOr)
+				{
+					*handled = true;
+					return true;
+				}
+
+				num_excluded++;
+			}
+		}
+
+		/* "op ANY" is excluded if all values are excluded */
+		excluded = op->useOr && num_excluded == num_elems;
+		*handled = excluded || NULL != range->dimension;
+		return excluded;
+	}
+
+	return false;
+}
+
+/*
+ * Exclude a chunk based on its dimension slices, falling back to proving that
+ * the chunk's constraints are refuted only for the clauses that cannot be
+ * checked against the slices.
+ */
+static bool
+can_exclude_chunk_by_slices(List *constraints, List *slice_ranges, Index scanrelid,
+							List *restrictinfos)
+{
+	List *remaining = NIL;
+	ListCell *lc;
+
+	if (slice_ranges == NIL)
+		return can_exclude_chunk(constraints, restrictinfos);
+
+	foreach (lc, restrictinfos)
+	{
+		RestrictInfo *ri = lfirst(lc);
+		bool handled;
+
+		if (slice_ranges_exclude_clause(slice_ranges, scanrelid, ri->clause, &handled))
+			return true;
+
+		if (!handled)
+			remaining = lappend(remaining, ri);
+	}
+
+	if (remaining == NIL)
+		return false;
+
+	return can_exclude_chunk(constraints, remaining);
+}
+
 /*
  * stripped down version of postgres get_relation_constraints
  */
@@ -944,11 +1425,39 @@ initialize_constraints(ChunkAppendState *state, List *initial_rt_indexes)
 {
 	ListCell *lc_clauses, *lc_plan, *lc_relid;
 	List *constraints = NIL;
+	List *slice_ranges = NIL;
 	EState *estate = state->csstate.ss.ps.state;
+	Hypertable *ht = NULL;
+	HTAB *column_ranges = NULL;
+	Cache *hcache = NULL;
+	Dimension *dimensions = NULL;
 
 	if (initial_rt_indexes == NIL)
 		return;
 
+	if (state->startup_exclusion || state->runtime_exclusion)
+	{
+		Scan *scan = (Scan *) state->csstate.ss.ps.plan;
+		RangeTblEntry *rte = rt_fetch(scan->scanrelid, estate->es_range_table);
+
+		hcache = ts_hypertable_cache_pin();
+		ht = ts_hypertable_cache_get_entry(hcache, rte->relid, CACHE_FLAG_MISSING_OK);
+
+		if (NULL != ht)
+		{
+			/*
+			 * The slice ranges are used until the end of the scan, which can
+			 * outlive the cache pin, e.g., for a cursor, so they reference
+			 * copies of the dimensions.
+			 */
+			dimensions = copy_dimensions(ht->space);
+
+			/* Get the column ranges of all chunks in a single catalog scan */
+			if (ht->stats_columns != NIL)
+				column_ranges = ts_chunk_column_stats_get_ranges(ht->fd.id, CurrentMemoryContext);
+		}
+	}
+
 	Assert(list_length(state->initial_subplans) == list_length(state->initial_ri_clauses));
 	Assert(list_length(state->initial_subplans) == list_length(initial_rt_indexes));
 
@@ -962,6 +1471,7 @@ initialize_constraints(ChunkAppendState *state, List *initial_rt_indexes)
 		Scan *scan = ts_chunk_append_get_scan_plan(lfirst(lc_plan));
 		Index initial_index = lfirst_oid(lc_relid);
 		List *relation_constraints = NIL;
+		List *relation_slice_ranges = NIL;
 
 		if (scan != NULL && scan->scanrelid > 0)
 		{
@@ -969,6 +1479,10 @@ initialize_constraints(ChunkAppendState *state, List *initial_rt_indexes)
 			RangeTblEntry *rte = rt_fetch(rt_index, estate->es_range_table);
 			relation_constraints = ca_get_relation_constraints(rte->relid, rt_index, true);
 
+			if (NULL != ht)
+				relation_slice_ranges =
+					get_chunk_slice_ranges(ht, dimensions, rte->relid, column_ranges);
+
 			/*
 			 * Adjust the RangeTableEntry indexes in the restrictinfo
 			 * clauses because during planning subquery indexes may be
@@ -978,7 +1492,13 @@ initialize_constraints(ChunkAppendState *state, List *initial_rt_indexes)
 				ChangeVarNodes(lfirst(lc_clauses), initial_index, scan->scanrelid, 0);
 		}
 		constraints = lappend(constraints, relation_constraints);
+		slice_ranges = lappend(slice_ranges, relation_slice_ranges);
 	}
 	state->initial_constraints = constraints;
 	state->filtered_constraints = constraints;
+	state->initial_slice_ranges = slice_ranges;
+	state->filtered_slice_ranges = slice_ranges;
+
+	if (NULL != hcache)
+		ts_cache_release(hcache);
 }
@@ -40,6 +40,8 @@ typedef struct ChunkAppendState
 	List *initial_constraints;
 	/* list of restrictinfo clauses indexed like initial_subplans */
 	List *initial_ri_clauses;
+	/* list of chunk dimension slice ranges indexed like initial_subplans */
+	List *initial_slice_ranges;
 
 	/* list of subplans after startup exclusion */
 	List *filtered_subplans;
@@ -47,6 +49,8 @@ typedef struct ChunkAppendState
 	List *filtered_constraints;
 	/* list of restrictinfo clauses after startup exclusion */
 	List *filtered_ri_clauses;
+	/* list of chunk dimension slice ranges after startup exclusion */
+	List *filtered_slice_ranges;
 
 	/* valid subplans for runtime exclusion */
 	Bitmapset *valid_subplans;
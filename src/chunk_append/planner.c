@@ -310,7 +310,11 @@ make_sort(Plan *lefttree, int numCols, AttrNumber *sortColIdx, Oid *sortOperator
 Scan *
 ts_chunk_append_get_scan_plan(Plan *plan)
 {
-	if (plan != NULL && (IsA(plan, Sort) || IsA(plan, Result)))
+	/*
+	 * Partial aggregates of chunkwise aggregation are run per chunk, and they
+	 * can have both a Sort and a projecting Result below them.
+	 */
+	while (plan != NULL && (IsA(plan, Agg) || IsA(plan, Sort) || IsA(plan, Result)))
 		plan = plan->lefttree;
 
 	if (plan == NULL)
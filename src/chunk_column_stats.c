@@ -0,0 +1,1425 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <access/htup_details.h>
+#include <access/sysattr.h>
+#include <catalog/pg_class.h>
+#include <catalog/pg_type.h>
+#include <executor/executor.h>
+#include <fmgr.h>
+#include <miscadmin.h>
+#include <nodes/makefuncs.h>
+#include <optimizer/clauses.h>
+#include <parser/parsetree.h>
+#include <storage/lmgr.h>
+#include <utils/builtins.h>
+#include <utils/inval.h>
+#include <utils/lsyscache.h>
+#include <utils/memutils.h>
+#include <utils/snapmgr.h>
+#include <utils/typcache.h>
+
+#include "compat.h"
+#if PG12_GE
+#include <optimizer/optimizer.h>
+#else
+#include <utils/tqual.h>
+#endif
+
+#include "chunk_column_stats.h"
+#include "catalog.h"
+#include "chunk.h"
+#include "dimension.h"
+#include "dimension_slice_index.h"
+#include "errors.h"
+#include "extension.h"
+#include "hypertable_cache.h"
+#include "scan_iterator.h"
+#include "scanner.h"
+#include "utils.h"
+
+TS_FUNCTION_INFO_V1(ts_chunk_column_stats_enable);
+TS_FUNCTION_INFO_V1(ts_chunk_column_stats_disable);
+TS_FUNCTION_INFO_V1(ts_chunk_column_stats_refresh);
+
+void _chunk_column_stats_init(void);
+void _chunk_column_stats_fini(void);
+
+static ExecutorStart_hook_type prev_executor_start_hook;
+
+bool
+ts_chunk_column_stats_type_supported(Oid type)
+{
+	switch (type)
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case DATEOID:
+		case TIMESTAMPOID:
+		case TIMESTAMPTZOID:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static bool
+is_integer_type(Oid type)
+{
+	return type == INT2OID || type == INT4OID || type == INT8OID;
+}
+
+/*
+ * Check if a value of value_type can be compared against the ranges of a
+ * column of column_type. The integer types share their representation, but
+ * date and time values differ in units and time zone handling, so they are
+ * only compared against values of the same type.
+ */
+bool
+ts_chunk_column_stats_types_compatible(Oid column_type, Oid value_type)
+{
+	if (column_type == value_type)
+		return ts_chunk_column_stats_type_supported(column_type);
+
+	return is_integer_type(column_type) && is_integer_type(value_type);
+}
+
+/*
+ * Check if no value in the range satisfies "column <strategy> value".
+ *
+ * The range end is exclusive, except that an end of PG_INT64_MAX means the
+ * range is unbounded above. An empty range (start == end) means the chunk has
+ * no non-NULL values in the column, which no strict operator matches.
+ */
+bool
+ts_chunk_column_stats_range_excludes(int64 range_start, int64 range_end, StrategyNumber strategy,
+									 int64 value)
+{
+	bool unbounded_end = (range_end == PG_INT64_MAX);
+
+	if (strategy < BTLessStrategyNumber || strategy > BTGreaterStrategyNumber)
+		return false;
+
+	if (range_start == range_end)
+		return true;
+
+	switch (strategy)
+	{
+		case BTLessStrategyNumber:
+			return range_start >= value;
+		case BTLessEqualStrategyNumber:
+			return range_start > value;
+		case BTEqualStrategyNumber:
+			return value < range_start || (!unbounded_end && value >= range_end);
+		case BTGreaterEqualStrategyNumber:
+			return !unbounded_end && value >= range_end;
+		case BTGreaterStrategyNumber:
+			return !unbounded_end && value >= range_end - 1;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Extend a range to include the inclusive range [lowest, greatest]. Returns
+ * true if the range changed.
+ */
+static bool
+range_include(int64 *range_start, int64 *range_end, int64 lowest, int64 greatest)
+{
+	int64 end = (greatest == PG_INT64_MAX) ? PG_INT64_MAX : greatest + 1;
+	int64 start;
+
+	/* Nothing to include */
+	if (lowest > greatest)
+		return false;
+
+	/* An empty range is replaced rather than extended */
+	if (*range_start != *range_end)
+	{
+		lowest = Min(lowest, *range_start);
+		end = Max(end, *range_end);
+	}
+
+	/* Make sure a range that ends at the maximum value is never empty */
+	start = Min(lowest, end - 1);
+
+	if (start == *range_start && end == *range_end)
+		return false;
+
+	*range_start = start;
+	*range_end = end;
+
+	return true;
+}
+
+static bool
+has_stats_column(Hypertable *ht, const char *column_name)
+{
+	ListCell *lc;
+
+	foreach (lc, ht->stats_columns)
+	{
+		if (strcmp(lfirst(lc), column_name) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+static void
+init_scan_by_hypertable_id(ScanIterator *iterator, int32 hypertable_id)
+{
+	iterator->ctx.index =
+		catalog_get_index(ts_catalog_get(),
+						  CHUNK_COLUMN_STATS,
+						  CHUNK_COLUMN_STATS_HYPERTABLE_ID_CHUNK_ID_COLUMN_NAME_KEY);
+	ts_scan_iterator_scan_key_init(
+		iterator,
+		Anum_chunk_column_stats_ht_id_chunk_id_column_name_key_hypertable_id,
+		BTEqualStrategyNumber,
+		F_INT4EQ,
+		Int32GetDatum(hypertable_id));
+}
+
+static void
+init_scan_by_chunk_id(ScanIterator *iterator, int32 hypertable_id, int32 chunk_id)
+{
+	init_scan_by_hypertable_id(iterator, hypertable_id);
+	ts_scan_iterator_scan_key_init(iterator,
+								   Anum_chunk_column_stats_ht_id_chunk_id_column_name_key_chunk_id,
+								   BTEqualStrategyNumber,
+								   F_INT4EQ,
+								   Int32GetDatum(chunk_id));
+}
+
+static void
+init_scan_by_column_name(ScanIterator *iterator, int32 hypertable_id, int32 chunk_id,
+						 const char *column_name)
+{
+	init_scan_by_chunk_id(iterator, hypertable_id, chunk_id);
+	ts_scan_iterator_scan_key_init(
+		iterator,
+		Anum_chunk_column_stats_ht_id_chunk_id_column_name_key_column_name,
+		BTEqualStrategyNumber,
+		F_NAMEEQ,
+		DirectFunctionCall1(namein, CStringGetDatum(column_name)));
+}
+
+static void
+chunk_column_stats_insert(int32 hypertable_id, int32 chunk_id, const char *column_name,
+						  int64 range_start, int64 range_end, bool valid)
+{
+	Catalog *catalog = ts_catalog_get();
+	Relation rel = table_open(catalog_get_table_id(catalog, CHUNK_COLUMN_STATS), RowExclusiveLock);
+	TupleDesc desc = RelationGetDescr(rel);
+	Datum values[Natts_chunk_column_stats];
+	bool nulls[Natts_chunk_column_stats] = { false };
+	CatalogSecurityContext sec_ctx;
+	NameData name;
+
+	namestrcpy(&name, column_name);
+
+	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
+	values[AttrNumberGetAttrOffset(Anum_chunk_column_stats_id)] =
+		Int32GetDatum(ts_catalog_table_next_seq_id(catalog, CHUNK_COLUMN_STATS));
+	values[AttrNumberGetAttrOffset(Anum_chunk_column_stats_hypertable_id)] =
+		Int32GetDatum(hypertable_id);
+	values[AttrNumberGetAttrOffset(Anum_chunk_column_stats_chunk_id)] = Int32GetDatum(chunk_id);
+	values[AttrNumberGetAttrOffset(Anum_chunk_column_stats_column_name)] = NameGetDatum(&name);
+	values[AttrNumberGetAttrOffset(Anum_chunk_column_stats_range_start)] =
+		Int64GetDatum(range_start);
+	values[AttrNumberGetAttrOffset(Anum_chunk_column_stats_range_end)] = Int64GetDatum(range_end);
+	values[AttrNumberGetAttrOffset(Anum_chunk_column_stats_valid)] = BoolGetDatum(valid);
+	ts_catalog_insert_values(rel, desc, values, nulls);
+	ts_catalog_restore_user(&sec_ctx);
+
+	table_close(rel, RowExclusiveLock);
+}
+
+static void
+chunk_column_stats_update(TupleInfo *ti, int64 range_start, int64 range_end, bool valid)
+{
+	HeapTuple tuple = heap_copytuple(ti->tuple);
+	FormData_chunk_column_stats *fd = (FormData_chunk_column_stats *) GETSTRUCT(tuple);
+
+	fd->range_start = range_start;
+	fd->range_end = range_end;
+	fd->valid = valid;
+	ts_catalog_update(ti->scanrel, tuple);
+	heap_freetuple(tuple);
+}
+
+/*
+ * Get the names of the columns that have stats enabled on a hypertable.
+ */
+List *
+ts_chunk_column_stats_get_columns(int32 hypertable_id, MemoryContext mctx)
+{
+	ScanIterator iterator = ts_scan_iterator_create(CHUNK_COLUMN_STATS, AccessShareLock, mctx);
+	List *columns = NIL;
+
+	init_scan_by_chunk_id(&iterator, hypertable_id, CHUNK_COLUMN_STATS_HYPERTABLE_ENTRY);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		FormData_chunk_column_stats *fd = (FormData_chunk_column_stats *) GETSTRUCT(ti->tuple);
+		MemoryContext old = MemoryContextSwitchTo(ti->mctx);
+
+		columns = lappend(columns, pstrdup(NameStr(fd->column_name)));
+		MemoryContextSwitchTo(old);
+	}
+
+	return columns;
+}
+
+/*
+ * Get the valid ranges of all chunks of a hypertable in a hash table keyed on
+ * chunk ID. Chunks without any valid ranges have no entry.
+ */
+HTAB *
+ts_chunk_column_stats_get_ranges(int32 hypertable_id, MemoryContext mctx)
+{
+	ScanIterator iterator = ts_scan_iterator_create(CHUNK_COLUMN_STATS, AccessShareLock, mctx);
+	HASHCTL hctl = {
+		.keysize = sizeof(int32),
+		.entrysize = sizeof(ChunkColumnRanges),
+		.hcxt = mctx,
+	};
+	HTAB *htab =
+		hash_create("chunk column ranges", 32, &hctl, HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+	init_scan_by_hypertable_id(&iterator, hypertable_id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		FormData_chunk_column_stats *fd = (FormData_chunk_column_stats *) GETSTRUCT(ti->tuple);
+		ChunkColumnRanges *entry;
+		ChunkColumnRange *range;
+		MemoryContext old;
+		bool found;
+
+		if (fd->chunk_id == CHUNK_COLUMN_STATS_HYPERTABLE_ENTRY || !fd->valid)
+			continue;
+
+		entry = hash_search(htab, &fd->chunk_id, HASH_ENTER, &found);
+
+		if (!found)
+			entry->ranges = NIL;
+
+		old = MemoryContextSwitchTo(mctx);
+		range = palloc(sizeof(ChunkColumnRange));
+		range->column_name = fd->column_name;
+		range->range_start = fd->range_start;
+		range->range_end = fd->range_end;
+		entry->ranges = lappend(entry->ranges, range);
+		MemoryContextSwitchTo(old);
+	}
+
+	return htab;
+}
+
+/*
+ * Add empty ranges for a new chunk, which are widened as data is inserted.
+ */
+void
+ts_chunk_column_stats_create_for_chunk(int32 hypertable_id, int32 chunk_id)
+{
+	List *columns = ts_chunk_column_stats_get_columns(hypertable_id, CurrentMemoryContext);
+	ListCell *lc;
+
+	foreach (lc, columns)
+		chunk_column_stats_insert(hypertable_id, chunk_id, lfirst(lc), 0, 0, true);
+}
+
+/*
+ * Lock the ranges of a chunk for modification until the end of the
+ * transaction. Modifications of the same chunk's ranges wait for each other
+ * instead of failing with a concurrent update. Since the catalog is scanned
+ * with SnapshotSelf, the scan after taking the lock finds the rows as last
+ * committed.
+ */
+static void
+chunk_column_stats_lock_chunk(int32 chunk_id)
+{
+	Oid catalog_relid = catalog_get_table_id(ts_catalog_get(), CHUNK_COLUMN_STATS);
+
+	LockDatabaseObject(catalog_relid, chunk_id, 0, ExclusiveLock);
+}
+
+/*
+ * Set the range of a column of a chunk and mark it valid. Returns true if
+ * anything changed.
+ */
+static bool
+chunk_column_stats_set(int32 hypertable_id, int32 chunk_id, const char *column_name,
+					   int64 range_start, int64 range_end)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(CHUNK_COLUMN_STATS, RowExclusiveLock, CurrentMemoryContext);
+	bool found = false;
+	bool changed = false;
+
+	chunk_column_stats_lock_chunk(chunk_id);
+	init_scan_by_column_name(&iterator, hypertable_id, chunk_id, column_name);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		FormData_chunk_column_stats *fd = (FormData_chunk_column_stats *) GETSTRUCT(ti->tuple);
+
+		found = true;
+
+		if (fd->valid && fd->range_start == range_start && fd->range_end == range_end)
+			continue;
+
+		chunk_column_stats_update(ti, range_start, range_end, true);
+		changed = true;
+	}
+
+	if (!found)
+	{
+		chunk_column_stats_insert(hypertable_id,
+								  chunk_id,
+								  column_name,
+								  range_start,
+								  range_end,
+								  true);
+		changed = true;
+	}
+
+	return changed;
+}
+
+/*
+ * Mark all ranges of a chunk as invalid. Returns true if any range changed.
+ */
+static bool
+chunk_column_stats_invalidate(int32 hypertable_id, int32 chunk_id)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(CHUNK_COLUMN_STATS, RowExclusiveLock, CurrentMemoryContext);
+	bool changed = false;
+
+	chunk_column_stats_lock_chunk(chunk_id);
+	init_scan_by_chunk_id(&iterator, hypertable_id, chunk_id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		FormData_chunk_column_stats *fd = (FormData_chunk_column_stats *) GETSTRUCT(ti->tuple);
+
+		if (!fd->valid)
+			continue;
+
+		chunk_column_stats_update(ti, fd->range_start, fd->range_end, false);
+		changed = true;
+	}
+
+	return changed;
+}
+
+/*
+ * Recalculate the ranges of all stats columns of a chunk from its data.
+ *
+ * This is done when a chunk is closed, e.g., before compression, and on
+ * request. The chunk is scanned with SnapshotAny, since the ranges must also
+ * cover tuple versions that are still visible to other snapshots. Taking a
+ * ShareLock on the chunk blocks concurrent modifications during the scan.
+ *
+ * Compressed chunks have their data in a different relation, so their ranges
+ * are invalidated instead.
+ */
+void
+ts_chunk_column_stats_calculate(Hypertable *ht, Chunk *chunk)
+{
+	List *columns = ts_chunk_column_stats_get_columns(ht->fd.id, CurrentMemoryContext);
+	int num_columns = list_length(columns);
+	ChunkInsertColumnRange *ranges;
+	Relation rel;
+	TupleTableSlot *slot;
+	TableScanDesc scan;
+	ListCell *lc;
+	bool changed = false;
+	int i = 0;
+
+	if (num_columns == 0)
+		return;
+
+	if (chunk->fd.compressed_chunk_id != INVALID_CHUNK_ID)
+	{
+		if (chunk_column_stats_invalidate(ht->fd.id, chunk->fd.id))
+			CacheInvalidateRelcacheByRelid(chunk->table_id);
+		return;
+	}
+
+	rel = table_open(chunk->table_id, ShareLock);
+	ranges = palloc0(sizeof(ChunkInsertColumnRange) * num_columns);
+
+	foreach (lc, columns)
+	{
+		ChunkInsertColumnRange *range = &ranges[i++];
+
+		namestrcpy(&range->column_name, lfirst(lc));
+		range->attno = get_attnum(chunk->table_id, NameStr(range->column_name));
+
+		if (range->attno == InvalidAttrNumber)
+			elog(ERROR,
+				 "column \"%s\" not found in chunk \"%s\"",
+				 NameStr(range->column_name),
+				 get_rel_name(chunk->table_id));
+
+		range->type = get_atttype(chunk->table_id, range->attno);
+		range->lowest = PG_INT64_MAX;
+		range->greatest = PG_INT64_MIN;
+	}
+
+	slot = table_slot_create(rel, NULL);
+	scan = table_beginscan(rel, SnapshotAny, 0, NULL);
+
+	while (table_scan_getnextslot(scan, ForwardScanDirection, slot))
+	{
+		for (i = 0; i < num_columns; i++)
+		{
+			ChunkInsertColumnRange *range = &ranges[i];
+			bool isnull;
+			Datum datum = slot_getattr(slot, range->attno, &isnull);
+			int64 value;
+
+			if (isnull)
+				continue;
+
+			value = ts_chunk_column_stats_value(datum, range->type);
+
+			if (value < range->lowest)
+				range->lowest = value;
+			if (value > range->greatest)
+				range->greatest = value;
+		}
+	}
+
+	table_endscan(scan);
+	ExecDropSingleTupleTableSlot(slot);
+
+	for (i = 0; i < num_columns; i++)
+	{
+		ChunkInsertColumnRange *range = &ranges[i];
+		int64 range_start = 0;
+		int64 range_end = 0;
+
+		range_include(&range_start, &range_end, range->lowest, range->greatest);
+
+		if (chunk_column_stats_set(ht->fd.id,
+								   chunk->fd.id,
+								   NameStr(range->column_name),
+								   range_start,
+								   range_end))
+			changed = true;
+	}
+
+	table_close(rel, NoLock);
+
+	/* Invalidate plans that excluded the chunk based on its old ranges */
+	if (changed)
+		CacheInvalidateRelcacheByRelid(chunk->table_id);
+}
+
+/*
+ * Invalidate the ranges of a chunk that is modified without tracking the
+ * modified values, e.g., by a COPY directly into the chunk.
+ */
+void
+ts_chunk_column_stats_invalidate_chunk(Oid chunk_relid)
+{
+	Cache *hcache;
+	Hypertable *ht;
+	Chunk *chunk;
+	Oid parent_relid = ts_inheritance_parent_relid(chunk_relid);
+
+	if (!OidIsValid(parent_relid))
+		return;
+
+	ht = ts_hypertable_cache_get_cache_and_entry(parent_relid, CACHE_FLAG_MISSING_OK, &hcache);
+
+	if (NULL != ht && ht->stats_columns != NIL)
+	{
+		chunk = ts_chunk_get_by_relid(chunk_relid, false);
+
+		if (NULL != chunk && chunk_column_stats_invalidate(ht->fd.id, chunk->fd.id))
+			CacheInvalidateRelcacheByRelid(chunk_relid);
+	}
+
+	ts_cache_release(hcache);
+}
+
+/*
+ * Check if an UPDATE of a hypertable or chunk assigns any of the stats
+ * columns of the hypertable.
+ */
+static bool
+update_modifies_stats_columns(RangeTblEntry *rte, Hypertable *ht)
+{
+	ListCell *lc;
+
+	foreach (lc, ht->stats_columns)
+	{
+		AttrNumber attno = get_attnum(rte->relid, lfirst(lc));
+
+		if (attno != InvalidAttrNumber &&
+			bms_is_member(attno - FirstLowInvalidHeapAttributeNumber, rte->updatedCols))
+			return true;
+	}
+
+	return false;
+}
+
+typedef struct ModifiedChunk
+{
+	int32 chunk_id;
+	Oid relid;
+} ModifiedChunk;
+
+static int
+modified_chunk_cmp(const void *left, const void *right)
+{
+	const ModifiedChunk *l = left;
+	const ModifiedChunk *r = right;
+
+	if (l->chunk_id < r->chunk_id)
+		return -1;
+
+	if (l->chunk_id > r->chunk_id)
+		return 1;
+
+	return 0;
+}
+
+/*
+ * Invalidate the ranges of the chunks that a ModifyTable node modifies
+ * without tracking the modified values, i.e., the chunks updated by an UPDATE
+ * that assigns a stats column and a chunk that is inserted into directly.
+ * Inserts into a hypertable are tracked by the chunk insert state.
+ *
+ * The chunk IDs of the result relations are looked up in the hypertable's
+ * slice index. The index cannot be used across catalog access, so all
+ * lookups in it happen before chunks missing from it are looked up in the
+ * catalog and before any ranges are invalidated. Chunks are invalidated in
+ * chunk ID order, like the chunks of an insert are widened.
+ */
+static void
+invalidate_for_modify_table(ModifyTable *mt, List *rtable, Cache *hcache)
+{
+	RangeTblEntry *rte;
+	Hypertable *ht;
+	HypertableSliceIndex *index;
+	ModifiedChunk *chunks;
+	int num_chunks = 0;
+	ListCell *lc;
+	int i;
+
+	if (mt->operation != CMD_UPDATE && mt->operation != CMD_INSERT)
+		return;
+
+	rte = rt_fetch(mt->nominalRelation, rtable);
+
+	if (rte->rtekind != RTE_RELATION || rte->relkind != RELKIND_RELATION)
+		return;
+
+	ht = ts_hypertable_cache_get_entry(hcache, rte->relid, CACHE_FLAG_MISSING_OK);
+
+	if (NULL != ht)
+	{
+		if (mt->operation == CMD_INSERT)
+			return;
+	}
+	else
+	{
+		Oid parent_relid = ts_inheritance_parent_relid(rte->relid);
+
+		if (!OidIsValid(parent_relid))
+			return;
+
+		ht = ts_hypertable_cache_get_entry(hcache, parent_relid, CACHE_FLAG_MISSING_OK);
+	}
+
+	if (NULL == ht || ht->stats_columns == NIL ||
+		(mt->operation == CMD_UPDATE && !update_modifies_stats_columns(rte, ht)))
+		return;
+
+	/* Only the chunks that are left in the plan are modified */
+	chunks = palloc(sizeof(ModifiedChunk) * list_length(mt->resultRelations));
+	index = ts_hypertable_slice_index_get(ht);
+
+	foreach (lc, mt->resultRelations)
+	{
+		Oid relid = rt_fetch(lfirst_int(lc), rtable)->relid;
+		const SliceIndexChunk *index_chunk;
+
+		if (relid == ht->main_table_relid)
+			continue;
+
+		index_chunk = (NULL != index) ? ts_hypertable_slice_index_get_chunk(index, relid) : NULL;
+		chunks[num_chunks].chunk_id =
+			(NULL != index_chunk) ? index_chunk->chunk_id : INVALID_CHUNK_ID;
+		chunks[num_chunks].relid = relid;
+		num_chunks++;
+	}
+
+	for (i = 0; i < num_chunks; i++)
+	{
+		if (chunks[i].chunk_id == INVALID_CHUNK_ID)
+		{
+			Chunk *chunk = ts_chunk_get_by_relid(chunks[i].relid, false);
+
+			if (NULL != chunk)
+				chunks[i].chunk_id = chunk->fd.id;
+		}
+	}
+
+	qsort(chunks, num_chunks, sizeof(ModifiedChunk), modified_chunk_cmp);
+
+	for (i = 0; i < num_chunks; i++)
+	{
+		if (chunks[i].chunk_id != INVALID_CHUNK_ID &&
+			chunk_column_stats_invalidate(ht->fd.id, chunks[i].chunk_id))
+			CacheInvalidateRelcacheByRelid(chunks[i].relid);
+	}
+
+	pfree(chunks);
+}
+
+/*
+ * Invalidate the ranges that are affected by the modifications of a query
+ * that do not go through the tracked insert path.
+ *
+ * This is done when the query is executed rather than when it is planned, so
+ * that only executed queries invalidate ranges, each execution of a cached
+ * plan does, and only the chunks that the plan modifies are invalidated.
+ * Data-modifying CTEs have their ModifyTable nodes in subplans.
+ */
+static void
+invalidate_for_plan(PlannedStmt *stmt)
+{
+	Cache *hcache;
+	ListCell *lc;
+
+	if (stmt->commandType == CMD_SELECT && !stmt->hasModifyingCTE)
+		return;
+
+	hcache = ts_hypertable_cache_pin();
+
+	if (IsA(stmt->planTree, ModifyTable))
+		invalidate_for_modify_table(castNode(ModifyTable, stmt->planTree), stmt->rtable, hcache);
+
+	foreach (lc, stmt->subplans)
+	{
+		Plan *subplan = lfirst(lc);
+
+		if (NULL != subplan && IsA(subplan, ModifyTable))
+			invalidate_for_modify_table(castNode(ModifyTable, subplan), stmt->rtable, hcache);
+	}
+
+	ts_cache_release(hcache);
+}
+
+static void
+chunk_column_stats_executor_start(QueryDesc *query_desc, int eflags)
+{
+	if (NULL != prev_executor_start_hook)
+		prev_executor_start_hook(query_desc, eflags);
+	else
+		standard_ExecutorStart(query_desc, eflags);
+
+	if ((eflags & EXEC_FLAG_EXPLAIN_ONLY) == 0 && ts_extension_is_loaded())
+		invalidate_for_plan(query_desc->plannedstmt);
+}
+
+/*
+ * Start tracking the values inserted into a chunk. If the values cannot be
+ * tracked, the ranges of the chunk are invalidated at the end of the insert.
+ */
+ChunkInsertColumnStats *
+ts_chunk_column_stats_insert_begin(Hypertable *ht, Chunk *chunk, Relation rel, bool can_track)
+{
+	int num_columns = list_length(ht->stats_columns);
+	ChunkInsertColumnStats *stats;
+	ListCell *lc;
+
+	if (num_columns == 0)
+		return NULL;
+
+	stats = palloc0(sizeof(ChunkInsertColumnStats) + sizeof(ChunkInsertColumnRange) * num_columns);
+	stats->hypertable_id = ht->fd.id;
+	stats->chunk_id = chunk->fd.id;
+	stats->chunk_relid = RelationGetRelid(rel);
+	stats->invalidate = !can_track;
+
+	if (!can_track)
+		return stats;
+
+	foreach (lc, ht->stats_columns)
+	{
+		ChunkInsertColumnRange *column = &stats->columns[stats->num_columns];
+		AttrNumber attno = get_attnum(stats->chunk_relid, lfirst(lc));
+
+		if (attno == InvalidAttrNumber)
+			continue;
+
+		namestrcpy(&column->column_name, lfirst(lc));
+		column->attno = attno;
+		column->type =
+			TupleDescAttr(RelationGetDescr(rel), AttrNumberGetAttrOffset(attno))->atttypid;
+		column->lowest = PG_INT64_MAX;
+		column->greatest = PG_INT64_MIN;
+		stats->num_columns++;
+	}
+
+	return stats;
+}
+
+static ChunkInsertColumnRange *
+insert_stats_get_column(ChunkInsertColumnStats *stats, Name column_name)
+{
+	int i;
+
+	for (i = 0; i < stats->num_columns; i++)
+	{
+		if (namestrcmp(column_name, NameStr(stats->columns[i].column_name)) == 0)
+			return &stats->columns[i];
+	}
+
+	return NULL;
+}
+
+/*
+ * Widen the ranges of a chunk to include the inserted values. Returns true if
+ * any range changed.
+ *
+ * The ranges are updated like any other catalog row, so a rolled back insert
+ * also rolls back its widening, and the chunk is invalidated at commit. The
+ * ranges of the chunk stay locked until then, so concurrent inserts that
+ * widen the same chunk wait for each other. Within a statement, chunks are
+ * widened in chunk ID order so that such inserts cannot deadlock.
+ */
+static bool
+chunk_column_stats_widen(ChunkInsertColumnStats *stats)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(CHUNK_COLUMN_STATS, RowExclusiveLock, CurrentMemoryContext);
+	bool changed = false;
+
+	chunk_column_stats_lock_chunk(stats->chunk_id);
+	init_scan_by_chunk_id(&iterator, stats->hypertable_id, stats->chunk_id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		FormData_chunk_column_stats *fd = (FormData_chunk_column_stats *) GETSTRUCT(ti->tuple);
+		ChunkInsertColumnRange *column = insert_stats_get_column(stats, &fd->column_name);
+		int64 range_start = fd->range_start;
+		int64 range_end = fd->range_end;
+
+		if (NULL == column || !fd->valid ||
+			!range_include(&range_start, &range_end, column->lowest, column->greatest))
+			continue;
+
+		chunk_column_stats_update(ti, range_start, range_end, true);
+		changed = true;
+	}
+
+	if (changed)
+		CacheInvalidateRelcacheByRelid(stats->chunk_relid);
+
+	return changed;
+}
+
+static int
+insert_stats_cmp_chunk_id(const void *left, const void *right)
+{
+	const ChunkInsertColumnStats *l = *((ChunkInsertColumnStats **) left);
+	const ChunkInsertColumnStats *r = *((ChunkInsertColumnStats **) right);
+
+	if (l->chunk_id < r->chunk_id)
+		return -1;
+
+	if (l->chunk_id > r->chunk_id)
+		return 1;
+
+	return 0;
+}
+
+/*
+ * Finish tracking the values inserted by a statement, widening or
+ * invalidating the ranges of the chunks inserted into, in chunk ID order.
+ */
+void
+ts_chunk_column_stats_insert_end(List *column_stats)
+{
+	int num_stats = list_length(column_stats);
+	ChunkInsertColumnStats **sorted;
+	ListCell *lc;
+	int i = 0;
+
+	if (num_stats == 0)
+		return;
+
+	sorted = palloc(sizeof(ChunkInsertColumnStats *) * num_stats);
+
+	foreach (lc, column_stats)
+		sorted[i++] = lfirst(lc);
+
+	qsort(sorted, num_stats, sizeof(ChunkInsertColumnStats *), insert_stats_cmp_chunk_id);
+
+	for (i = 0; i < num_stats; i++)
+	{
+		ChunkInsertColumnStats *stats = sorted[i];
+
+		/* Cached plans might have excluded the chunk based on its old ranges */
+		if (stats->invalidate)
+		{
+			if (chunk_column_stats_invalidate(stats->hypertable_id, stats->chunk_id))
+				CacheInvalidateRelcacheByRelid(stats->chunk_relid);
+		}
+		else
+			chunk_column_stats_widen(stats);
+	}
+
+	pfree(sorted);
+}
+
+/*
+ * Planner support for excluding chunks based on their column ranges.
+ */
+typedef struct ColumnRestriction
+{
+	const char *column_name;
+	StrategyNumber strategy;
+	int64 value;
+} ColumnRestriction;
+
+static const char *
+get_stats_column(Hypertable *ht, Oid relid, AttrNumber attno)
+{
+	ListCell *lc;
+	char *attname;
+
+	if (attno <= 0)
+		return NULL;
+
+	attname = get_attname_compat(relid, attno, false);
+
+	foreach (lc, ht->stats_columns)
+	{
+		if (strcmp(lfirst(lc), attname) == 0)
+			return lfirst(lc);
+	}
+
+	return NULL;
+}
+
+/*
+ * Get a restriction on a stats column from a "Var op Const" clause. Returns
+ * NULL if the clause is not a supported comparison on a stats column.
+ */
+static ColumnRestriction *
+column_restriction_from_clause(PlannerInfo *root, RelOptInfo *rel, Hypertable *ht, Expr *clause)
+{
+	OpExpr *op = (OpExpr *) clause;
+	Expr *left, *right, *other;
+	Var *var;
+	Oid opno = op->opno;
+	const char *column_name;
+	TypeCacheEntry *tce;
+	ColumnRestriction *restriction;
+	int strategy;
+	Oid lefttype, righttype;
+	Const *c;
+
+	if (!IsA(clause, OpExpr) || list_length(op->args) != 2)
+		return NULL;
+
+	left = linitial(op->args);
+	right = lsecond(op->args);
+
+	if (IsA(left, RelabelType))
+		left = ((RelabelType *) left)->arg;
+	if (IsA(right, RelabelType))
+		right = ((RelabelType *) right)->arg;
+
+	if (IsA(left, Var))
+	{
+		var = (Var *) left;
+		other = right;
+	}
+	else if (IsA(right, Var))
+	{
+		var = (Var *) right;
+		other = left;
+		opno = get_commutator(opno);
+	}
+	else
+		return NULL;
+
+	if (var->varno != rel->relid || var->varlevelsup != 0 || !OidIsValid(opno) ||
+		!op_strict(opno))
+		return NULL;
+
+	column_name = get_stats_column(ht, ht->main_table_relid, var->varattno);
+
+	if (NULL == column_name)
+		return NULL;
+
+	other = (Expr *) eval_const_expressions(root, (Node *) other);
+
+	if (!IsA(other, Const) || ((Const *) other)->constisnull)
+		return NULL;
+
+	c = (Const *) other;
+	tce = lookup_type_cache(var->vartype, TYPECACHE_BTREE_OPFAMILY);
+
+	if (!OidIsValid(tce->btree_opf) || !op_in_opfamily(opno, tce->btree_opf))
+		return NULL;
+
+	get_op_opfamily_properties(opno, tce->btree_opf, false, &strategy, &lefttype, &righttype);
+
+	if (lefttype != var->vartype || righttype != c->consttype ||
+		!ts_chunk_column_stats_types_compatible(var->vartype, c->consttype))
+		return NULL;
+
+	restriction = palloc(sizeof(ColumnRestriction));
+	restriction->column_name = column_name;
+	restriction->strategy = strategy;
+	restriction->value = ts_chunk_column_stats_value(c->constvalue, c->consttype);
+
+	return restriction;
+}
+
+static bool
+ranges_exclude_chunk(List *ranges, List *restrictions)
+{
+	ListCell *lc;
+
+	foreach (lc, restrictions)
+	{
+		ColumnRestriction *restriction = lfirst(lc);
+		ListCell *lc_range;
+
+		foreach (lc_range, ranges)
+		{
+			ChunkColumnRange *range = lfirst(lc_range);
+
+			if (namestrcmp(&range->column_name, restriction->column_name) == 0 &&
+				ts_chunk_column_stats_range_excludes(range->range_start,
+													 range->range_end,
+													 restriction->strategy,
+													 restriction->value))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+static int32
+chunk_id_for_relid(HypertableSliceIndex *index, Oid relid)
+{
+	const SliceIndexChunk *index_chunk;
+	Chunk *chunk;
+
+	if (NULL != index)
+	{
+		index_chunk = ts_hypertable_slice_index_get_chunk(index, relid);
+
+		if (NULL != index_chunk)
+			return index_chunk->chunk_id;
+	}
+
+	chunk = ts_chunk_get_by_relid(relid, false);
+
+	return NULL != chunk ? chunk->fd.id : INVALID_CHUNK_ID;
+}
+
+/*
+ * Exclude chunks whose column ranges refute the restrictions on the
+ * hypertable. Returns the remaining chunks and removes the excluded chunks
+ * from the nested (space partitioned) chunk lists, if given.
+ *
+ * Excluded chunks are added to the plan's relation dependencies, since the
+ * plan is no longer valid once their ranges are widened or invalidated.
+ */
+List *
+ts_chunk_column_stats_exclude_chunks(PlannerInfo *root, RelOptInfo *rel, Hypertable *ht,
+									 List *restrictions, List *chunk_oids, List **nested_oids)
+{
+	List *column_restrictions = NIL;
+	List *remaining = NIL;
+	List *excluded = NIL;
+	HypertableSliceIndex *index;
+	HTAB *ranges;
+	ListCell *lc;
+
+	foreach (lc, restrictions)
+	{
+		RestrictInfo *ri = lfirst(lc);
+		ColumnRestriction *restriction;
+
+		/* Same as constraint_exclusion */
+		if (contain_mutable_functions((Node *) ri->clause))
+			continue;
+
+		restriction = column_restriction_from_clause(root, rel, ht, ri->clause);
+
+		if (NULL != restriction)
+			column_restrictions = lappend(column_restrictions, restriction);
+	}
+
+	if (column_restrictions == NIL || chunk_oids == NIL)
+		return chunk_oids;
+
+	ranges = ts_chunk_column_stats_get_ranges(ht->fd.id, CurrentMemoryContext);
+
+	if (hash_get_num_entries(ranges) == 0)
+		return chunk_oids;
+
+	index = ts_hypertable_slice_index_get(ht);
+
+	foreach (lc, chunk_oids)
+	{
+		Oid relid = lfirst_oid(lc);
+		int32 chunk_id = chunk_id_for_relid(index, relid);
+		ChunkColumnRanges *entry = hash_search(ranges, &chunk_id, HASH_FIND, NULL);
+
+		if (NULL != entry && ranges_exclude_chunk(entry->ranges, column_restrictions))
+		{
+			excluded = lappend_oid(excluded, relid);
+			root->glob->relationOids = lappend_oid(root->glob->relationOids, relid);
+		}
+		else
+			remaining = lappend_oid(remaining, relid);
+	}
+
+	if (excluded != NIL && NULL != nested_oids)
+	{
+		List *nested = NIL;
+
+		foreach (lc, *nested_oids)
+		{
+			List *oids = list_difference_oid(lfirst(lc), excluded);
+
+			if (oids != NIL)
+				nested = lappend(nested, oids);
+		}
+
+		*nested_oids = nested;
+	}
+
+	hash_destroy(ranges);
+
+	return remaining;
+}
+
+/*
+ * Delete the ranges of a chunk when the chunk is dropped.
+ */
+void
+ts_chunk_column_stats_delete_by_chunk_id(int32 hypertable_id, int32 chunk_id)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(CHUNK_COLUMN_STATS, RowExclusiveLock, CurrentMemoryContext);
+
+	init_scan_by_chunk_id(&iterator, hypertable_id, chunk_id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+	}
+}
+
+void
+ts_chunk_column_stats_delete_by_hypertable_id(int32 hypertable_id)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(CHUNK_COLUMN_STATS, RowExclusiveLock, CurrentMemoryContext);
+
+	init_scan_by_hypertable_id(&iterator, hypertable_id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+	}
+}
+
+/*
+ * Delete all ranges of a column, e.g., when the column is dropped. Returns
+ * the number of deleted rows.
+ */
+static int
+chunk_column_stats_delete_column(int32 hypertable_id, const char *column_name)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(CHUNK_COLUMN_STATS, RowExclusiveLock, CurrentMemoryContext);
+	int count = 0;
+
+	init_scan_by_hypertable_id(&iterator, hypertable_id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		FormData_chunk_column_stats *fd = (FormData_chunk_column_stats *) GETSTRUCT(ti->tuple);
+
+		if (namestrcmp(&fd->column_name, column_name) != 0)
+			continue;
+
+		ts_catalog_delete(ti->scanrel, ti->tuple);
+		count++;
+	}
+
+	return count;
+}
+
+void
+ts_chunk_column_stats_delete_column(Hypertable *ht, const char *column_name)
+{
+	if (has_stats_column(ht, column_name))
+		chunk_column_stats_delete_column(ht->fd.id, column_name);
+}
+
+void
+ts_chunk_column_stats_rename_column(Hypertable *ht, const char *old_name, const char *new_name)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(CHUNK_COLUMN_STATS, RowExclusiveLock, CurrentMemoryContext);
+
+	if (!has_stats_column(ht, old_name))
+		return;
+
+	init_scan_by_hypertable_id(&iterator, ht->fd.id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		HeapTuple tuple;
+		FormData_chunk_column_stats *fd = (FormData_chunk_column_stats *) GETSTRUCT(ti->tuple);
+
+		if (namestrcmp(&fd->column_name, old_name) != 0)
+			continue;
+
+		tuple = heap_copytuple(ti->tuple);
+		fd = (FormData_chunk_column_stats *) GETSTRUCT(tuple);
+		namestrcpy(&fd->column_name, new_name);
+		ts_catalog_update(ti->scanrel, tuple);
+		heap_freetuple(tuple);
+	}
+}
+
+static void
+chunk_column_stats_calculate_all(Hypertable *ht)
+{
+	int32 *chunk_ids;
+	Oid *relids;
+	int num_chunks = ts_chunk_get_relids_by_hypertable_id(ht->fd.id, &chunk_ids, &relids);
+	int i;
+
+	for (i = 0; i < num_chunks; i++)
+	{
+		Chunk *chunk = ts_chunk_get_by_id(chunk_ids[i], true);
+
+		ts_chunk_column_stats_calculate(ht, chunk);
+	}
+}
+
+/*
+ * Recalculate the ranges of a column after its type changed, since the
+ * ranges are stored in the representation of the type.
+ */
+void
+ts_chunk_column_stats_alter_column_type(Hypertable *ht, const char *column_name)
+{
+	Oid new_type;
+
+	if (!has_stats_column(ht, column_name))
+		return;
+
+	new_type = get_atttype(ht->main_table_relid, get_attnum(ht->main_table_relid, column_name));
+
+	if (!ts_chunk_column_stats_type_supported(new_type))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("cannot change the type of column \"%s\" to %s",
+						column_name,
+						format_type_be(new_type)),
+				 errdetail("Chunk column stats are enabled on the column."),
+				 errhint("Disable chunk column stats on the column first.")));
+
+	chunk_column_stats_calculate_all(ht);
+}
+
+static void
+column_stats_validate_column(Hypertable *ht, const char *column_name)
+{
+	AttrNumber attno = get_attnum(ht->main_table_relid, column_name);
+	Oid type;
+
+	if (attno == InvalidAttrNumber)
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_COLUMN),
+				 errmsg("column \"%s\" does not exist", column_name)));
+
+	if (NULL != ts_hyperspace_get_dimension_by_name(ht->space, DIMENSION_TYPE_ANY, column_name))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("column \"%s\" is a dimension of the hypertable", column_name),
+				 errdetail("Chunks are already excluded on dimension columns.")));
+
+	type = get_atttype(ht->main_table_relid, attno);
+
+	if (!ts_chunk_column_stats_type_supported(type))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("chunk column stats are not supported on column \"%s\" of type %s",
+						column_name,
+						format_type_be(type)),
+				 errhint("Use an integer, date, or timestamp column.")));
+}
+
+/*
+ * Enable chunk column stats on a column of a hypertable and calculate the
+ * ranges of the existing chunks.
+ */
+Datum
+ts_chunk_column_stats_enable(PG_FUNCTION_ARGS)
+{
+	Oid relid = PG_ARGISNULL(0) ? InvalidOid : PG_GETARG_OID(0);
+	Name column_name = PG_ARGISNULL(1) ? NULL : PG_GETARG_NAME(1);
+	bool if_not_exists = PG_ARGISNULL(2) ? false : PG_GETARG_BOOL(2);
+	Cache *hcache;
+	Hypertable *ht;
+
+	if (!OidIsValid(relid))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("invalid hypertable: cannot be NULL")));
+
+	if (NULL == column_name)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("invalid column_name: cannot be NULL")));
+
+	ts_hypertable_permissions_check(relid, GetUserId());
+
+	/* Block concurrent inserts while the ranges of existing chunks are calculated */
+	LockRelationOid(relid, ShareLock);
+
+	ht = ts_hypertable_cache_get_cache_and_entry(relid, CACHE_FLAG_NONE, &hcache);
+	column_stats_validate_column(ht, NameStr(*column_name));
+
+	if (has_stats_column(ht, NameStr(*column_name)))
+	{
+		if (!if_not_exists)
+			ereport(ERROR,
+					(errcode(ERRCODE_DUPLICATE_OBJECT),
+					 errmsg("chunk column stats already enabled on column \"%s\"",
+							NameStr(*column_name))));
+
+		ereport(NOTICE,
+				(errmsg("chunk column stats already enabled on column \"%s\", skipping",
+						NameStr(*column_name))));
+		ts_cache_release(hcache);
+		PG_RETURN_VOID();
+	}
+
+	chunk_column_stats_insert(ht->fd.id,
+							  CHUNK_COLUMN_STATS_HYPERTABLE_ENTRY,
+							  NameStr(*column_name),
+							  0,
+							  0,
+							  true);
+	chunk_column_stats_calculate_all(ht);
+	ts_cache_release(hcache);
+
+	PG_RETURN_VOID();
+}
+
+Datum
+ts_chunk_column_stats_disable(PG_FUNCTION_ARGS)
+{
+	Oid relid = PG_ARGISNULL(0) ? InvalidOid : PG_GETARG_OID(0);
+	Name column_name = PG_ARGISNULL(1) ? NULL : PG_GETARG_NAME(1);
+	bool if_exists = PG_ARGISNULL(2) ? false : PG_GETARG_BOOL(2);
+	Cache *hcache;
+	Hypertable *ht;
+
+	if (!OidIsValid(relid))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("invalid hypertable: cannot be NULL")));
+
+	if (NULL == column_name)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("invalid column_name: cannot be NULL")));
+
+	ts_hypertable_permissions_check(relid, GetUserId());
+	ht = ts_hypertable_cache_get_cache_and_entry(relid, CACHE_FLAG_NONE, &hcache);
+
+	if (chunk_column_stats_delete_column(ht->fd.id, NameStr(*column_name)) == 0)
+	{
+		if (!if_exists)
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_OBJECT),
+					 errmsg("chunk column stats not enabled on column \"%s\"",
+							NameStr(*column_name))));
+
+		ereport(NOTICE,
+				(errmsg("chunk column stats not enabled on column \"%s\", skipping",
+						NameStr(*column_name))));
+	}
+
+	ts_cache_release(hcache);
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * Recalculate the ranges of a chunk, e.g., after they were invalidated by an
+ * UPDATE.
+ */
+Datum
+ts_chunk_column_stats_refresh(PG_FUNCTION_ARGS)
+{
+	Oid relid = PG_ARGISNULL(0) ? InvalidOid : PG_GETARG_OID(0);
+	Chunk *chunk;
+	Hypertable *ht;
+
+	if (!OidIsValid(relid))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("invalid chunk: cannot be NULL")));
+
+	chunk = ts_chunk_get_by_relid(relid, false);
+
+	if (NULL == chunk)
+		ereport(ERROR,
+				(errcode(ERRCODE_TS_HYPERTABLE_NOT_EXIST),
+				 errmsg("\"%s\" is not a chunk", get_rel_name(relid))));
+
+	ts_hypertable_permissions_check(chunk->hypertable_relid, GetUserId());
+	ht = ts_hypertable_get_by_id(chunk->fd.hypertable_id);
+	ts_chunk_column_stats_calculate(ht, chunk);
+
+	PG_RETURN_VOID();
+}
+
+void
+_chunk_column_stats_init(void)
+{
+	prev_executor_start_hook = ExecutorStart_hook;
+	ExecutorStart_hook = chunk_column_stats_executor_start;
+}
+
+void
+_chunk_column_stats_fini(void)
+{
+	ExecutorStart_hook = prev_executor_start_hook;
+}
@@ -0,0 +1,154 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_CHUNK_COLUMN_STATS_H
+#define TIMESCALEDB_CHUNK_COLUMN_STATS_H
+
+#include <postgres.h>
+#include <access/stratnum.h>
+#include <catalog/pg_type.h>
+#include <executor/tuptable.h>
+#include <utils/date.h>
+#include <utils/hsearch.h>
+#include <utils/timestamp.h>
+
+#include "compat.h"
+#if PG12_GE
+#include <nodes/pathnodes.h>
+#else
+#include <nodes/relation.h>
+#endif
+
+#include "export.h"
+#include "chunk.h"
+#include "hypertable.h"
+
+/*
+ * Chunk column stats track the range of values (a "zone map") of a column
+ * in each chunk, so that chunks can be excluded on columns that are not
+ * partitioning dimensions but correlate with time, like sequence numbers.
+ *
+ * Ranges are stored as int64 in the native integer representation of the
+ * column type, so only integer and date/time columns are supported. Values
+ * are only compared against constants of a type with the same representation.
+ */
+
+/* The chunk ID of the rows that enable stats on a column of a hypertable */
+#define CHUNK_COLUMN_STATS_HYPERTABLE_ENTRY 0
+
+/* The range of a column in a chunk */
+typedef struct ChunkColumnRange
+{
+	NameData column_name;
+	int64 range_start;
+	int64 range_end; /* exclusive */
+} ChunkColumnRange;
+
+/* The valid ranges of a chunk, as found in the hash table of a hypertable */
+typedef struct ChunkColumnRanges
+{
+	int32 chunk_id; /* hash key */
+	List *ranges;
+} ChunkColumnRanges;
+
+/* The range of values inserted into a column of a chunk by a statement */
+typedef struct ChunkInsertColumnRange
+{
+	NameData column_name;
+	AttrNumber attno; /* attribute number in the chunk */
+	Oid type;
+	int64 lowest;
+	int64 greatest;
+} ChunkInsertColumnRange;
+
+typedef struct ChunkInsertColumnStats
+{
+	int32 hypertable_id;
+	int32 chunk_id;
+	Oid chunk_relid;
+	/* Set if inserted values cannot be tracked and the ranges are invalidated */
+	bool invalidate;
+	int num_columns;
+	ChunkInsertColumnRange columns[FLEXIBLE_ARRAY_MEMBER];
+} ChunkInsertColumnStats;
+
+static inline int64
+ts_chunk_column_stats_value(Datum value, Oid type)
+{
+	switch (type)
+	{
+		case INT2OID:
+			return DatumGetInt16(value);
+		case INT4OID:
+			return DatumGetInt32(value);
+		case INT8OID:
+			return DatumGetInt64(value);
+		case DATEOID:
+			return DatumGetDateADT(value);
+		case TIMESTAMPOID:
+			return DatumGetTimestamp(value);
+		case TIMESTAMPTZOID:
+			return DatumGetTimestampTz(value);
+		default:
+			elog(ERROR, "unsupported type %u for chunk column stats", type);
+			pg_unreachable();
+	}
+}
+
+/*
+ * Track the values of a tuple (in the chunk's format) that is inserted into a
+ * chunk.
+ */
+static inline void
+ts_chunk_column_stats_track_insert(ChunkInsertColumnStats *stats, TupleTableSlot *slot)
+{
+	int i;
+
+	for (i = 0; i < stats->num_columns; i++)
+	{
+		ChunkInsertColumnRange *column = &stats->columns[i];
+		bool isnull;
+		Datum datum = slot_getattr(slot, column->attno, &isnull);
+		int64 value;
+
+		if (isnull)
+			continue;
+
+		value = ts_chunk_column_stats_value(datum, column->type);
+
+		if (value < column->lowest)
+			column->lowest = value;
+		if (value > column->greatest)
+			column->greatest = value;
+	}
+}
+
+extern bool ts_chunk_column_stats_type_supported(Oid type);
+extern bool ts_chunk_column_stats_types_compatible(Oid column_type, Oid value_type);
+extern bool ts_chunk_column_stats_range_excludes(int64 range_start, int64 range_end,
+												 StrategyNumber strategy, int64 value);
+
+extern List *ts_chunk_column_stats_get_columns(int32 hypertable_id, MemoryContext mctx);
+extern HTAB *ts_chunk_column_stats_get_ranges(int32 hypertable_id, MemoryContext mctx);
+extern List *ts_chunk_column_stats_exclude_chunks(PlannerInfo *root, RelOptInfo *rel,
+												  Hypertable *ht, List *restrictions,
+												  List *chunk_oids, List **nested_oids);
+
+extern void ts_chunk_column_stats_create_for_chunk(int32 hypertable_id, int32 chunk_id);
+extern TSDLLEXPORT void ts_chunk_column_stats_calculate(Hypertable *ht, Chunk *chunk);
+extern void ts_chunk_column_stats_invalidate_chunk(Oid chunk_relid);
+
+extern ChunkInsertColumnStats *ts_chunk_column_stats_insert_begin(Hypertable *ht, Chunk *chunk,
+																  Relation rel, bool can_track);
+extern void ts_chunk_column_stats_insert_end(List *column_stats);
+
+extern void ts_chunk_column_stats_delete_by_chunk_id(int32 hypertable_id, int32 chunk_id);
+extern void ts_chunk_column_stats_delete_by_hypertable_id(int32 hypertable_id);
+extern void ts_chunk_column_stats_delete_column(Hypertable *ht, const char *column_name);
+extern void ts_chunk_column_stats_rename_column(Hypertable *ht, const char *old_name,
+												const char *new_name);
+extern void ts_chunk_column_stats_alter_column_type(Hypertable *ht, const char *column_name);
+
+#endif /* TIMESCALEDB_CHUNK_COLUMN_STATS_H */
@@ -22,6 +22,7 @@
 #include <nodes/makefuncs.h>
 
 #include <catalog/pg_constraint.h>
+#include <catalog/pg_type.h>
 #include "compat.h"
 #if PG11_LT /* PG11 consolidates pg_foo_fn.h -> pg_foo.h */
 #include <catalog/pg_constraint_fn.h>
@@ -416,6 +417,66 @@ ts_chunk_constraint_scan_by_chunk_id(int32 chunk_id, Size num_constraints_hint,
 	return constraints;
 }
 
+static int
+int32_cmp(const void *left, const void *right)
+{
+	int32 l = *((const int32 *) left);
+	int32 r = *((const int32 *) right);
+
+	return (l > r) - (l < r);
+}
+
+/*
+ * Scan for the constraints of many chunks in a single pass over the chunk
+ * constraint index, instead of one scan per chunk.
+ *
+ * The chunk IDs should be sorted in ascending order and the constraints of
+ * the chunk with ID chunk_ids[i] are added to constraints[i].
+ */
+void
+ts_chunk_constraint_scan_by_chunk_ids(const int32 *chunk_ids, ChunkConstraints **constraints,
+									  int num_chunks)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(CHUNK_CONSTRAINT, AccessShareLock, CurrentMemoryContext);
+	Datum *values;
+	int i;
+
+	if (num_chunks == 0)
+		return;
+
+	values = palloc(sizeof(Datum) * num_chunks);
+
+	for (i = 0; i < num_chunks; i++)
+		values[i] = Int32GetDatum(chunk_ids[i]);
+
+	iterator.ctx.index = catalog_get_index(ts_catalog_get(),
+										   CHUNK_CONSTRAINT,
+										   CHUNK_CONSTRAINT_CHUNK_ID_DIMENSION_SLICE_ID_IDX);
+	ts_scan_iterator_scan_key_init_array(&iterator,
+										 Anum_chunk_constraint_chunk_id_dimension_slice_id_idx_chunk_id,
+										 BTEqualStrategyNumber,
+										 F_INT4EQ,
+										 INT4OID,
+										 values,
+										 num_chunks);
+
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		bool isnull;
+		Datum chunk_id_datum =
+			heap_getattr(ti->tuple, Anum_chunk_constraint_chunk_id, ti->desc, &isnull);
+		int32 chunk_id = DatumGetInt32(chunk_id_datum);
+		const int32 *found = bsearch(&chunk_id, chunk_ids, num_chunks, sizeof(int32), int32_cmp);
+
+		if (NULL == found)
+			elog(ERROR, "unexpected constraint found for chunk ID %d", chunk_id);
+
+		chunk_constraints_add_from_tuple(constraints[found - chunk_ids], ti);
+	}
+}
+
 typedef struct ChunkConstraintScanData
 {
 	ChunkScanCtx *scanctx;
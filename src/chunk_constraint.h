@@ -38,6 +38,8 @@ typedef struct ChunkScanCtx ChunkScanCtx;
 extern TSDLLEXPORT ChunkConstraints *ts_chunk_constraints_alloc(int size_hint, MemoryContext mctx);
 extern ChunkConstraints *ts_chunk_constraint_scan_by_chunk_id(int32 chunk_id, Size count_hint,
 															  MemoryContext mctx);
+extern void ts_chunk_constraint_scan_by_chunk_ids(const int32 *chunk_ids,
+												  ChunkConstraints **constraints, int num_chunks);
 extern ChunkConstraints *ts_chunk_constraints_copy(ChunkConstraints *constraints);
 extern int ts_chunk_constraint_scan_by_dimension_slice(DimensionSlice *slice, ChunkScanCtx *ctx,
 													   MemoryContext mctx);
@@ -8,6 +8,7 @@
 #include <nodes/extensible.h>
 #include <nodes/makefuncs.h>
 #include <nodes/nodeFuncs.h>
+#include <utils/memutils.h>
 #include <utils/rel.h>
 #include <catalog/pg_type.h>
 
@@ -30,6 +31,8 @@ ts_chunk_dispatch_create(Hypertable *ht, EState *estate)
 		ts_subspace_store_init(ht->space, estate->es_query_cxt, ts_guc_max_open_chunks_per_insert);
 	cd->prev_cis = NULL;
 	cd->prev_cis_oid = InvalidOid;
+	cd->column_stats = NIL;
+	cd->instrument = NULL;
 
 	return cd;
 }
@@ -99,6 +102,7 @@ void
 ts_chunk_dispatch_destroy(ChunkDispatch *cd)
 {
 	ts_subspace_store_free(cd->cache);
+	ts_chunk_column_stats_insert_end(cd->column_stats);
 }
 
 static void
@@ -107,6 +111,82 @@ destroy_chunk_insert_state(void *cis)
 	ts_chunk_insert_state_destroy((ChunkInsertState *) cis);
 }
 
+/*
+ * Enable collection of routing statistics. Time spent is measured only if
+ * timing is set.
+ */
+void
+ts_chunk_dispatch_instrument(ChunkDispatch *dispatch, bool timing)
+{
+	dispatch->instrument = palloc0(sizeof(ChunkDispatchInstrumentation));
+	dispatch->instrument->timing = timing;
+}
+
+/*
+ * Get the number of chunk insert states that were closed early to make room
+ * for new ones.
+ */
+int
+ts_chunk_dispatch_num_evicted(ChunkDispatch *dispatch)
+{
+	Assert(NULL != dispatch->instrument);
+	return dispatch->instrument->insert_states_created -
+		   (int) ts_subspace_store_num_objects(dispatch->cache);
+}
+
+/*
+ * Get or create the chunk for a point while recording whether it was created
+ * and how long that took. Looking up the chunk first means an extra lookup
+ * when the chunk is created, which is negligible in comparison.
+ */
+static Chunk *
+chunk_dispatch_get_or_create_chunk_instrumented(ChunkDispatch *dispatch, Point *point)
+{
+	ChunkDispatchInstrumentation *instr = dispatch->instrument;
+	Chunk *chunk = ts_hypertable_find_chunk_if_exists(dispatch->hypertable, point);
+	MemoryContext old;
+	instr_time start;
+	instr_time duration;
+
+	INSTR_TIME_SET_ZERO(start);
+
+	if (NULL == chunk)
+	{
+		if (instr->timing)
+			INSTR_TIME_SET_CURRENT(start);
+
+		chunk = ts_hypertable_get_or_create_chunk(dispatch->hypertable, point);
+		instr->chunks_created++;
+
+		if (instr->timing)
+		{
+			INSTR_TIME_SET_CURRENT(duration);
+			INSTR_TIME_SUBTRACT(duration, start);
+			INSTR_TIME_ADD(instr->chunk_creation_time, duration);
+		}
+	}
+
+	instr->insert_states_created++;
+	old = MemoryContextSwitchTo(dispatch->estate->es_query_cxt);
+	instr->chunks = bms_add_member(instr->chunks, chunk->fd.id);
+	MemoryContextSwitchTo(old);
+
+	return chunk;
+}
+
+/*
+ * Find the cached chunk insert state for the given point without creating
+ * one. Returns NULL if there is no open insert state for the point. Routing is
+ * unaffected, so callers must still go through
+ * ts_chunk_dispatch_get_chunk_insert_state() for any other insert state than
+ * the one they used last.
+ */
+ChunkInsertState *
+ts_chunk_dispatch_find_chunk_insert_state(ChunkDispatch *dispatch, Point *point)
+{
+	return ts_subspace_store_get(dispatch->cache, point);
+}
+
 /*
  * Get the chunk insert state for the chunk that matches the given point in the
  * partitioned hyperspace.
@@ -124,7 +204,10 @@ ts_chunk_dispatch_get_chunk_insert_state(ChunkDispatch *dispatch, Point *point,
 	{
 		Chunk *new_chunk;
 
-		new_chunk = ts_hypertable_get_or_create_chunk(dispatch->hypertable, point);
+		if (NULL != dispatch->instrument)
+			new_chunk = chunk_dispatch_get_or_create_chunk_instrumented(dispatch, point);
+		else
+			new_chunk = ts_hypertable_get_or_create_chunk(dispatch->hypertable, point);
 
 		if (NULL == new_chunk)
 			elog(ERROR, "no chunk found or created");
@@ -138,6 +221,9 @@ ts_chunk_dispatch_get_chunk_insert_state(ChunkDispatch *dispatch, Point *point,
 		cis_changed = false;
 	}
 
+	if (cis_changed && NULL != dispatch->instrument)
+		dispatch->instrument->chunk_switches++;
+
 	if (cis_changed && on_chunk_changed)
 		on_chunk_changed(cis, data);
 
@@ -10,6 +10,8 @@
 #include <nodes/parsenodes.h>
 #include <nodes/execnodes.h>
 #include <executor/tuptable.h>
+#include <nodes/bitmapset.h>
+#include <portability/instr_time.h>
 
 #include "hypertable_cache.h"
 #include "cache.h"
@@ -17,6 +19,21 @@
 #include "chunk_dispatch_state.h"
 #include "chunk_insert_state.h"
 
+/*
+ * Statistics on tuple routing, collected for EXPLAIN ANALYZE.
+ */
+typedef struct ChunkDispatchInstrumentation
+{
+	bool timing;				/* measure time spent, not only counts */
+	Bitmapset *chunks;			/* IDs of the chunks that tuples were routed to */
+	int insert_states_created;	/* chunk insert states created, including re-creations
+								 * after eviction */
+	int chunk_switches;			/* tuples routed to another chunk than the previous one */
+	int chunks_created;			/* chunks that did not exist before */
+	instr_time chunk_creation_time;
+	instr_time tuple_conversion_time;
+} ChunkDispatchInstrumentation;
+
 /*
  * ChunkDispatch keeps cached state needed to dispatch tuples to chunks. It is
  * separate from any plan and executor nodes, since it is used both for INSERT
@@ -36,6 +53,10 @@ typedef struct ChunkDispatch
 	ResultRelInfo *hypertable_result_rel_info;
 	ChunkInsertState *prev_cis;
 	Oid prev_cis_oid;
+	/* Values inserted into chunks with column stats, see chunk_column_stats.h */
+	List *column_stats;
+	/* Routing statistics, or NULL if not instrumented */
+	ChunkDispatchInstrumentation *instrument;
 } ChunkDispatch;
 
 typedef struct Point Point;
@@ -44,6 +65,10 @@ typedef void (*on_chunk_changed_func)(ChunkInsertState *state, void *data);
 
 extern ChunkDispatch *ts_chunk_dispatch_create(Hypertable *ht, EState *estate);
 extern void ts_chunk_dispatch_destroy(ChunkDispatch *dispatch);
+extern void ts_chunk_dispatch_instrument(ChunkDispatch *dispatch, bool timing);
+extern int ts_chunk_dispatch_num_evicted(ChunkDispatch *dispatch);
+extern ChunkInsertState *ts_chunk_dispatch_find_chunk_insert_state(ChunkDispatch *dispatch,
+																   Point *point);
 extern ChunkInsertState *
 ts_chunk_dispatch_get_chunk_insert_state(ChunkDispatch *dispatch, Point *p,
 										 const on_chunk_changed_func on_chunk_changed, void *data);
@@ -7,20 +7,44 @@
 #include <utils/lsyscache.h>
 #include <utils/rel.h>
 #include <catalog/pg_class.h>
+#include <commands/explain.h>
 #include <commands/trigger.h>
+#include <executor/instrument.h>
 #include <nodes/nodes.h>
 #include <nodes/extensible.h>
+#include <utils/memutils.h>
 
 #include "compat.h"
+#if PG12_LT
+#include <optimizer/clauses.h>
+#else
+#include <optimizer/optimizer.h>
+#endif
+
 #include "chunk_dispatch_state.h"
 #include "chunk_dispatch_plan.h"
 #include "chunk_dispatch.h"
 #include "chunk_insert_state.h"
 #include "chunk.h"
 #include "cache.h"
+#include "continuous_agg.h"
+#include "cross_module_fn.h"
 #include "hypertable_cache.h"
 #include "dimension.h"
 #include "hypertable.h"
+#include "subspace_store.h"
+#include "trigger.h"
+
+/*
+ * The max number of tuples to read from the subplan and group by chunk before
+ * dispatching them.
+ */
+#define CHUNK_DISPATCH_BATCH_SIZE 1000
+/*
+ * The max number of distinct chunks tracked in a batch. Tuples for chunks
+ * beyond this limit are dispatched in input order at the end of the batch.
+ */
+#define CHUNK_DISPATCH_BATCH_MAX_GROUPS 32
 
 static void
 chunk_dispatch_begin(CustomScanState *node, EState *estate, int eflags)
@@ -37,6 +61,11 @@ chunk_dispatch_begin(CustomScanState *node, EState *estate, int eflags)
 	state->hypertable_cache = hypertable_cache;
 	state->dispatch = ts_chunk_dispatch_create(ht, estate);
 	state->dispatch->dispatch_state = state;
+
+	/* Collect routing statistics for EXPLAIN ANALYZE */
+	if (estate->es_instrument)
+		ts_chunk_dispatch_instrument(state->dispatch,
+									 (estate->es_instrument & INSTRUMENT_TIMER) != 0);
 	node->custom_ps = list_make1(ps);
 }
 
@@ -97,21 +126,148 @@ on_chunk_insert_state_changed(ChunkInsertState *cis, void *data)
 }
 #endif /* PG12_GE */
 
+/*
+ * Get the dispatch group for a chunk's insert state.
+ *
+ * Groups are numbered in order of first appearance in the batch. Tuples for
+ * which no insert state exists yet (key is NULL) share a group so that new
+ * chunks are created in the same order as without batching.
+ */
+static int
+chunk_dispatch_batch_group(void **keys, int *ngroups, void *key)
+{
+	int i;
+
+	for (i = 0; i < *ngroups; i++)
+		if (keys[i] == key)
+			return i;
+
+	/* Out of groups, so treat the chunk as one without an insert state */
+	if (*ngroups >= CHUNK_DISPATCH_BATCH_MAX_GROUPS - 1 && key != NULL)
+		return chunk_dispatch_batch_group(keys, ngroups, NULL);
+
+	keys[*ngroups] = key;
+	return (*ngroups)++;
+}
+
+/*
+ * Read the next batch of tuples from the subplan and compute the order in
+ * which to dispatch them.
+ *
+ * The tuples are grouped by destination chunk using the insert states that
+ * already exist in the dispatch cache. The grouping is only a reordering,
+ * since the insert state of each tuple is looked up again when it is
+ * dispatched. The order of tuples within a chunk is preserved.
+ */
+static void
+chunk_dispatch_batch_fill(ChunkDispatchState *state)
+{
+	ChunkDispatchBatch *batch = state->batch;
+	PlanState *substate = linitial(state->cscan_state.custom_ps);
+	ChunkDispatch *dispatch = state->dispatch;
+	EState *estate = state->cscan_state.ss.ps.state;
+	void *keys[CHUNK_DISPATCH_BATCH_MAX_GROUPS];
+	int offsets[CHUNK_DISPATCH_BATCH_MAX_GROUPS + 1] = { 0 };
+	int ngroups = 0;
+	MemoryContext old;
+	int i;
+
+	MemoryContextReset(batch->mctx);
+	batch->nused = 0;
+	batch->next = 0;
+
+	while (batch->nused < batch->size)
+	{
+		TupleTableSlot *slot = ExecProcNode(substate);
+
+		if (TupIsNull(slot))
+			break;
+
+		if (batch->nused == batch->nslots)
+		{
+			MemoryContext old = MemoryContextSwitchTo(estate->es_query_cxt);
+
+			batch->slots[batch->nslots++] =
+				ExecInitExtraTupleSlotCompat(estate,
+											 slot->tts_tupleDescriptor,
+											 TTSOpsBufferHeapTupleP);
+			MemoryContextSwitchTo(old);
+		}
+
+		ExecCopySlot(batch->slots[batch->nused], slot);
+		batch->nused++;
+	}
+
+	if (batch->nused == 0)
+		return;
+
+	/* Calculate the points of all tuples in the batch at once */
+	old = MemoryContextSwitchTo(batch->mctx);
+	ts_hyperspace_calculate_points(dispatch->hypertable->space,
+								   batch->slots,
+								   batch->nused,
+								   batch->points);
+	MemoryContextSwitchTo(old);
+
+	for (i = 0; i < batch->nused; i++)
+		batch->groups[i] =
+			chunk_dispatch_batch_group(keys,
+									   &ngroups,
+									   ts_subspace_store_get(dispatch->cache, batch->points[i]));
+
+	/* Stable counting sort of the tuples on their group */
+	for (i = 0; i < batch->nused; i++)
+		offsets[batch->groups[i] + 1]++;
+
+	for (i = 0; i < ngroups; i++)
+		offsets[i + 1] += offsets[i];
+
+	for (i = 0; i < batch->nused; i++)
+		batch->order[offsets[batch->groups[i]]++] = i;
+}
+
+/*
+ * Get the next tuple to dispatch from the batch, reading a new batch from the
+ * subplan when the current one is exhausted.
+ */
+static TupleTableSlot *
+chunk_dispatch_batch_next(ChunkDispatchState *state, Point **point)
+{
+	ChunkDispatchBatch *batch = state->batch;
+	int pos;
+
+	if (batch->next >= batch->nused)
+	{
+		chunk_dispatch_batch_fill(state);
+
+		if (batch->nused == 0)
+			return NULL;
+	}
+
+	pos = batch->order[batch->next++];
+	*point = batch->points[pos];
+
+	return batch->slots[pos];
+}
+
 static TupleTableSlot *
 chunk_dispatch_exec(CustomScanState *node)
 {
 	ChunkDispatchState *state = (ChunkDispatchState *) node;
 	PlanState *substate = linitial(node->custom_ps);
 	TupleTableSlot *slot;
-	Point *point;
+	Point *point = NULL;
 	ChunkInsertState *cis;
 	ChunkDispatch *dispatch = state->dispatch;
 	Hypertable *ht = dispatch->hypertable;
 	EState *estate = node->ss.ps.state;
 	MemoryContext old;
 
-	/* Get the next tuple from the subplan state node */
-	slot = ExecProcNode(substate);
+	/* Get the next tuple from the batch or the subplan state node */
+	if (NULL != state->batch)
+		slot = chunk_dispatch_batch_next(state, &point);
+	else
+		slot = ExecProcNode(substate);
 
 	if (TupIsNull(slot))
 		return NULL;
@@ -120,7 +276,8 @@ chunk_dispatch_exec(CustomScanState *node)
 	old = MemoryContextSwitchTo(GetPerTupleMemoryContext(estate));
 
 	/* Calculate the tuple's point in the N-dimensional hyperspace */
-	point = ts_hyperspace_calculate_point(ht->space, slot);
+	if (NULL == point)
+		point = ts_hyperspace_calculate_point(ht->space, slot);
 
 	/* Save the main table's (hypertable's) ResultRelInfo */
 	if (NULL == dispatch->hypertable_result_rel_info)
@@ -141,12 +298,39 @@ chunk_dispatch_exec(CustomScanState *node)
 	 */
 	estate->es_result_relation_info = cis->result_relation_info;
 
+	/* Track the tuple for continuous aggregate invalidation */
+	if (NULL != cis->invalidation)
+		ts_chunk_insert_state_track_invalidation(cis, point);
+
 	MemoryContextSwitchTo(old);
 
 	/* Convert the tuple to the chunk's rowtype, if necessary */
 	if (cis->hyper_to_chunk_map != NULL)
+	{
+		ChunkDispatchInstrumentation *instr = dispatch->instrument;
+		instr_time start;
+
+		INSTR_TIME_SET_ZERO(start);
+
+		if (NULL != instr && instr->timing)
+			INSTR_TIME_SET_CURRENT(start);
+
 		slot = execute_attr_map_slot(cis->hyper_to_chunk_map->attrMap, slot, cis->slot);
 
+		if (NULL != instr && instr->timing)
+		{
+			instr_time duration;
+
+			INSTR_TIME_SET_CURRENT(duration);
+			INSTR_TIME_SUBTRACT(duration, start);
+			INSTR_TIME_ADD(instr->tuple_conversion_time, duration);
+		}
+	}
+
+	/* Track the values of columns with chunk column stats */
+	if (NULL != cis->column_stats)
+		ts_chunk_column_stats_track_insert(cis->column_stats, slot);
+
 	return slot;
 }
 
@@ -164,17 +348,76 @@ chunk_dispatch_end(CustomScanState *node)
 static void
 chunk_dispatch_rescan(CustomScanState *node)
 {
+	ChunkDispatchState *state = (ChunkDispatchState *) node;
 	PlanState *substate = linitial(node->custom_ps);
 
+	if (NULL != state->batch)
+	{
+		state->batch->nused = 0;
+		state->batch->next = 0;
+	}
+
 	ExecReScan(substate);
 }
 
+/*
+ * Show tuple routing statistics in EXPLAIN ANALYZE. Like PostgreSQL does for
+ * filtered rows, counters that are zero are left out of the text format.
+ */
+static void
+chunk_dispatch_explain(CustomScanState *node, List *ancestors, ExplainState *es)
+{
+	ChunkDispatchState *state = (ChunkDispatchState *) node;
+	ChunkDispatchInstrumentation *instr = state->dispatch->instrument;
+	bool show_all = es->format != EXPLAIN_FORMAT_TEXT;
+	int num_evicted;
+
+	if (NULL == instr)
+		return;
+
+	num_evicted = ts_chunk_dispatch_num_evicted(state->dispatch);
+
+	if (show_all || instr->insert_states_created > 0)
+	{
+		ExplainPropertyIntegerCompat("Chunks Touched", NULL, bms_num_members(instr->chunks), es);
+		ExplainPropertyIntegerCompat("Chunk Insert States Created",
+									 NULL,
+									 instr->insert_states_created,
+									 es);
+		ExplainPropertyIntegerCompat("Chunk Switches", NULL, instr->chunk_switches, es);
+	}
+
+	if (show_all || num_evicted > 0)
+		ExplainPropertyIntegerCompat("Chunk Insert States Evicted", NULL, num_evicted, es);
+
+	if (show_all || instr->chunks_created > 0)
+		ExplainPropertyIntegerCompat("Chunks Created", NULL, instr->chunks_created, es);
+
+	if (!instr->timing || !es->timing)
+		return;
+
+	if (show_all || !INSTR_TIME_IS_ZERO(instr->chunk_creation_time))
+		ExplainPropertyFloatCompat("Chunk Creation Time",
+								   "ms",
+								   INSTR_TIME_GET_MILLISEC(instr->chunk_creation_time),
+								   3,
+								   es);
+
+	if (show_all || !INSTR_TIME_IS_ZERO(instr->tuple_conversion_time))
+		ExplainPropertyFloatCompat("Tuple Conversion Time",
+								   "ms",
+								   INSTR_TIME_GET_MILLISEC(instr->tuple_conversion_time),
+								   3,
+								   es);
+}
+
 static CustomExecMethods chunk_dispatch_state_methods = {
 	.CustomName = CHUNK_DISPATCH_STATE_NAME,
 	.BeginCustomScan = chunk_dispatch_begin,
 	.EndCustomScan = chunk_dispatch_end,
 	.ExecCustomScan = chunk_dispatch_exec,
 	.ReScanCustomScan = chunk_dispatch_rescan,
+	.ExplainCustomScan = chunk_dispatch_explain,
 };
 
 ChunkDispatchState *
@@ -258,6 +501,174 @@ setup_tuple_slots_for_on_conflict_handling(ChunkDispatchState *state)
 }
 #endif
 
+/*
+ * Check if the hypertable has row triggers that fire on inserts into its
+ * chunks.
+ *
+ * The insert blocker on the root table never fires on chunks. Neither does
+ * the continuous aggregate invalidation trigger, since the chunk insert
+ * states track the inserted tuples instead, unless the invalidation functions
+ * are not available.
+ */
+static bool
+chunk_dispatch_has_insert_row_triggers(TriggerDesc *trigdesc)
+{
+	int i;
+
+	if (NULL == trigdesc)
+		return false;
+
+	for (i = 0; i < trigdesc->numtriggers; i++)
+	{
+		Trigger *trigger = &trigdesc->triggers[i];
+
+		if (!trigger_is_chunk_trigger(trigger) || !TRIGGER_FOR_INSERT(trigger->tgtype))
+			continue;
+
+		if (strcmp(trigger->tgname, CAGGINVAL_TRIGGER_NAME) == 0 &&
+			NULL != ts_cm_functions->continuous_agg_invalidate_range)
+			continue;
+
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ * Check if a plan tree evaluates volatile functions anywhere.
+ *
+ * Only plan nodes whose expressions are all known here are looked into. Any
+ * other node is treated as volatile. Index, merge and hash clauses are not
+ * checked, since the planner never uses volatile clauses as such.
+ */
+static bool
+chunk_dispatch_plan_is_volatile(Plan *plan)
+{
+	List *exprs = NIL;
+	List *children = NIL;
+	ListCell *lc;
+
+	if (NULL == plan)
+		return false;
+
+	switch (nodeTag(plan))
+	{
+		case T_Result:
+			exprs = list_make1(((Result *) plan)->resconstantqual);
+			break;
+		case T_ValuesScan:
+			exprs = ((ValuesScan *) plan)->values_lists;
+			break;
+		case T_FunctionScan:
+			exprs = ((FunctionScan *) plan)->functions;
+			break;
+		case T_SubqueryScan:
+			children = list_make1(((SubqueryScan *) plan)->subplan);
+			break;
+		case T_Append:
+			children = ((Append *) plan)->appendplans;
+			break;
+		case T_MergeAppend:
+			children = ((MergeAppend *) plan)->mergeplans;
+			break;
+		case T_NestLoop:
+		case T_MergeJoin:
+		case T_HashJoin:
+			exprs = ((Join *) plan)->joinqual;
+			break;
+		case T_Limit:
+			exprs = list_make2(((Limit *) plan)->limitOffset, ((Limit *) plan)->limitCount);
+			break;
+		case T_CustomScan:
+			exprs = ((CustomScan *) plan)->custom_exprs;
+			children = ((CustomScan *) plan)->custom_plans;
+			break;
+		case T_SeqScan:
+		case T_IndexScan:
+		case T_IndexOnlyScan:
+		case T_BitmapHeapScan:
+		case T_Sort:
+		case T_Material:
+		case T_Hash:
+		case T_Unique:
+		case T_Agg:
+			break;
+		default:
+			return true;
+	}
+
+	if (contain_volatile_functions_not_nextval((Node *) plan->targetlist) ||
+		contain_volatile_functions_not_nextval((Node *) plan->qual) ||
+		contain_volatile_functions_not_nextval((Node *) exprs))
+		return true;
+
+	if (chunk_dispatch_plan_is_volatile(plan->lefttree) ||
+		chunk_dispatch_plan_is_volatile(plan->righttree))
+		return true;
+
+	foreach (lc, children)
+	{
+		if (chunk_dispatch_plan_is_volatile(lfirst(lc)))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Check if the tuples of the insert can be dispatched grouped by chunk rather
+ * than in input order.
+ *
+ * Reordering must not be visible to the user, so it is not done for inserts
+ * with RETURNING or ON CONFLICT, or when the hypertable has row triggers that
+ * fire on its chunks. Nor is it done if the subplan, or any subquery of the
+ * statement, produces tuples using volatile functions, since these could
+ * read the hypertable and expect to see the tuples inserted so far.
+ */
+static bool
+chunk_dispatch_can_batch(ChunkDispatchState *state)
+{
+	PlannedStmt *pstmt = state->mtstate->ps.state->es_plannedstmt;
+	ListCell *lc;
+
+	if (ts_chunk_dispatch_has_returning(state->dispatch) ||
+		ts_chunk_dispatch_get_on_conflict_action(state->dispatch) != ONCONFLICT_NONE)
+		return false;
+
+	if (chunk_dispatch_has_insert_row_triggers(state->mtstate->resultRelInfo->ri_TrigDesc))
+		return false;
+
+	if (chunk_dispatch_plan_is_volatile(state->subplan))
+		return false;
+
+	/* SubPlans in expressions refer to these by index, so check them all */
+	foreach (lc, pstmt->subplans)
+	{
+		if (chunk_dispatch_plan_is_volatile(lfirst(lc)))
+			return false;
+	}
+
+	return true;
+}
+
+static ChunkDispatchBatch *
+chunk_dispatch_batch_create(EState *estate, int size)
+{
+	ChunkDispatchBatch *batch = palloc0(sizeof(ChunkDispatchBatch));
+
+	batch->size = size;
+	batch->slots = palloc0(sizeof(TupleTableSlot *) * size);
+	batch->points = palloc(sizeof(Point *) * size);
+	batch->groups = palloc(sizeof(int) * size);
+	batch->order = palloc(sizeof(int) * size);
+	batch->mctx = AllocSetContextCreate(estate->es_query_cxt,
+										"ChunkDispatch batch",
+										ALLOCSET_DEFAULT_SIZES);
+
+	return batch;
+}
+
 /*
  * This function is called during the init phase of the INSERT (ModifyTable)
  * plan, and gives the ChunkDispatchState node the access it needs to the
@@ -277,4 +688,7 @@ ts_chunk_dispatch_state_set_parent(ChunkDispatchState *state, ModifyTableState *
 	state->mtstate = mtstate;
 	setup_tuple_slots_for_on_conflict_handling(state);
 	state->arbiter_indexes = mt_plan->arbiterIndexes;
+
+	if (chunk_dispatch_can_batch(state))
+		state->batch = chunk_dispatch_batch_create(mtstate->ps.state, CHUNK_DISPATCH_BATCH_SIZE);
 }
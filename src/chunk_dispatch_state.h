@@ -12,6 +12,26 @@
 
 typedef struct ChunkDispatch ChunkDispatch;
 typedef struct Cache Cache;
+typedef struct Point Point;
+
+/*
+ * A batch of tuples read from the subplan. The tuples are handed to the
+ * ModifyTable node grouped by destination chunk to avoid switching between
+ * chunks (result relations) for every tuple when the input interleaves
+ * chunks.
+ */
+typedef struct ChunkDispatchBatch
+{
+	int size;				/* max number of tuples in the batch */
+	int nslots;				/* number of slots created */
+	int nused;				/* number of tuples in the batch */
+	int next;				/* next position in the dispatch order */
+	TupleTableSlot **slots; /* the batched tuples, in input order */
+	Point **points;			/* the point of each tuple */
+	int *groups;			/* the dispatch group of each tuple */
+	int *order;				/* input positions in dispatch order */
+	MemoryContext mctx;		/* memory for the points, reset every batch */
+} ChunkDispatchBatch;
 
 /* State used for every tuple in an insert statement */
 typedef struct ChunkDispatchState
@@ -41,6 +61,11 @@ typedef struct ChunkDispatchState
 	 * relations) for each chunk.
 	 */
 	ChunkDispatch *dispatch;
+	/*
+	 * Batch of input tuples reordered by chunk, or NULL if tuples are
+	 * dispatched in input order.
+	 */
+	ChunkDispatchBatch *batch;
 } ChunkDispatchState;
 
 #define CHUNK_DISPATCH_STATE_NAME "ChunkDispatchState"
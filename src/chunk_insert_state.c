@@ -20,7 +20,9 @@
 #include <parser/parsetree.h>
 #include <rewrite/rewriteManip.h>
 #include <nodes/makefuncs.h>
+#include <catalog/pg_trigger.h>
 #include <catalog/pg_type.h>
+#include <commands/trigger.h>
 
 #include "compat.h"
 #if PG12_LT
@@ -36,6 +38,8 @@
 #include "chunk_dispatch.h"
 #include "chunk_dispatch_state.h"
 #include "chunk_index.h"
+#include "continuous_agg.h"
+#include "cross_module_fn.h"
 #include "compat/tupconvert.h"
 
 /* Just like ExecPrepareExpr except that it doesn't switch to the query memory context */
@@ -532,6 +536,128 @@ adjust_projections(ChunkInsertState *cis, ChunkDispatch *dispatch, Oid rowtype)
 	}
 }
 
+/*
+ * Stop the continuous aggregate invalidation trigger from firing on inserts
+ * into the chunk. The result relation has its own copy of the trigger
+ * descriptor, so this does not affect other users of the chunk, and the
+ * trigger still fires on updates, e.g., for ON CONFLICT DO UPDATE.
+ *
+ * Returns false if the chunk has no invalidation trigger.
+ */
+static bool
+disable_invalidation_trigger_on_insert(TriggerDesc *trigdesc)
+{
+	bool found = false;
+	int i;
+
+	if (NULL == trigdesc)
+		return false;
+
+	trigdesc->trig_insert_after_row = false;
+
+	for (i = 0; i < trigdesc->numtriggers; i++)
+	{
+		Trigger *trigger = &trigdesc->triggers[i];
+
+		if (strcmp(trigger->tgname, CAGGINVAL_TRIGGER_NAME) == 0)
+		{
+			trigger->tgtype &= ~TRIGGER_TYPE_INSERT;
+			found = true;
+		}
+
+		if (TRIGGER_TYPE_MATCHES(trigger->tgtype,
+								 TRIGGER_TYPE_ROW,
+								 TRIGGER_TYPE_AFTER,
+								 TRIGGER_TYPE_INSERT))
+			trigdesc->trig_insert_after_row = true;
+	}
+
+	return found;
+}
+
+/*
+ * Track the range of inserted time values in the chunk insert state instead
+ * of invalidating continuous aggregates in a row trigger, which is expensive
+ * since every inserted tuple is queued as an after trigger event.
+ *
+ * This is only done for plain inserts, since the row trigger sees the tuple
+ * that is actually inserted, and tuples might be skipped or changed by ON
+ * CONFLICT handling or BEFORE triggers.
+ */
+static void
+setup_invalidation(ChunkInsertState *state, ChunkDispatch *dispatch)
+{
+	ResultRelInfo *rri = state->result_relation_info;
+	Hyperspace *hs = dispatch->hypertable->space;
+	ChunkInsertInvalidation *inval;
+	int i;
+
+	if (NULL == ts_cm_functions->continuous_agg_invalidate_range ||
+		ts_chunk_dispatch_get_cmd_type(dispatch) != CMD_INSERT ||
+		ts_chunk_dispatch_get_on_conflict_action(dispatch) != ONCONFLICT_NONE ||
+		NULL == rri->ri_TrigDesc || rri->ri_TrigDesc->trig_insert_before_row)
+		return;
+
+	if (!disable_invalidation_trigger_on_insert(rri->ri_TrigDesc))
+		return;
+
+	inval = palloc(sizeof(ChunkInsertInvalidation));
+	inval->hypertable_id = dispatch->hypertable->fd.id;
+	inval->dimension_index = 0;
+
+	for (i = 0; i < hs->num_dimensions; i++)
+	{
+		if (hs->dimensions[i].type == DIMENSION_TYPE_OPEN)
+		{
+			inval->dimension_index = i;
+			break;
+		}
+	}
+
+	inval->minimum = ts_cm_functions->continuous_agg_invalidation_minimum(inval->hypertable_id);
+	inval->lowest = PG_INT64_MAX;
+	inval->greatest = PG_INT64_MIN;
+	state->invalidation = inval;
+}
+
+/*
+ * Track the range of inserted values of columns with chunk column stats, so
+ * that the ranges of the chunk can be widened once at the end of the
+ * statement. Like for continuous aggregate invalidation, values can only be
+ * tracked when the tuple seen here is the tuple that is inserted. Otherwise,
+ * the ranges of the chunk are invalidated.
+ */
+static void
+setup_column_stats(ChunkInsertState *state, ChunkDispatch *dispatch, Chunk *chunk)
+{
+	ResultRelInfo *rri = state->result_relation_info;
+	Hypertable *ht = dispatch->hypertable;
+	MemoryContext old_mcxt;
+	bool can_track;
+
+	if (ht->stats_columns == NIL)
+		return;
+
+	can_track = ts_chunk_dispatch_get_cmd_type(dispatch) == CMD_INSERT &&
+				ts_chunk_dispatch_get_on_conflict_action(dispatch) != ONCONFLICT_UPDATE &&
+				(NULL == rri->ri_TrigDesc || !rri->ri_TrigDesc->trig_insert_before_row);
+#if PG12_GE
+	/* Stored generated columns are computed after the tuple is tracked */
+	if (NULL != state->rel->rd_att->constr && state->rel->rd_att->constr->has_generated_stored)
+		can_track = false;
+#endif
+
+	/*
+	 * The ranges are widened once for all chunks at the end of the statement,
+	 * so the tracked values have to outlive the chunk insert state, which
+	 * might be evicted before.
+	 */
+	old_mcxt = MemoryContextSwitchTo(dispatch->estate->es_query_cxt);
+	state->column_stats = ts_chunk_column_stats_insert_begin(ht, chunk, state->rel, can_track);
+	dispatch->column_stats = lappend(dispatch->column_stats, state->column_stats);
+	MemoryContextSwitchTo(old_mcxt);
+}
+
 /*
  * Create new insert chunk state.
  *
@@ -589,6 +715,9 @@ ts_chunk_insert_state_create(Chunk *chunk, ChunkDispatch *dispatch)
 			elog(ERROR, "insert trigger on chunk table not supported");
 	}
 
+	setup_invalidation(state, dispatch);
+	setup_column_stats(state, dispatch, chunk);
+
 	parent_rel = table_open(dispatch->hypertable->main_table_relid, AccessShareLock);
 
 	/* Set tuple conversion map, if tuple needs conversion. */
@@ -631,6 +760,11 @@ ts_chunk_insert_state_destroy(ChunkInsertState *state)
 	if (state == NULL)
 		return;
 
+	if (NULL != state->invalidation && state->invalidation->lowest <= state->invalidation->greatest)
+		ts_cm_functions->continuous_agg_invalidate_range(state->invalidation->hypertable_id,
+														 state->invalidation->lowest,
+														 state->invalidation->greatest);
+
 	destroy_on_conflict_state(state);
 	ExecCloseIndices(state->result_relation_info);
 	table_close(state->rel, NoLock);
@@ -12,8 +12,25 @@
 #include <access/tupconvert.h>
 
 #include "chunk.h"
+#include "chunk_column_stats.h"
 #include "cache.h"
 
+/*
+ * Range of time values inserted into a chunk, used to invalidate continuous
+ * aggregates on the hypertable once per chunk and statement instead of in a
+ * row trigger.
+ */
+typedef struct ChunkInsertInvalidation
+{
+	int32 hypertable_id;
+	/* Index of the time dimension in the hyperspace */
+	int dimension_index;
+	/* Time values below the minimum do not invalidate anything */
+	int64 minimum;
+	int64 lowest;
+	int64 greatest;
+} ChunkInsertInvalidation;
+
 typedef struct ChunkInsertState
 {
 	Relation rel;
@@ -50,6 +67,10 @@ typedef struct ChunkInsertState
 	TupleTableSlot *slot;
 	/* Map for converting tuple from hypertable (root table) format to chunk format */
 	TupleConversionMap *hyper_to_chunk_map;
+	/* Set if inserts are tracked for continuous aggregate invalidation */
+	ChunkInsertInvalidation *invalidation;
+	/* Set if the chunk has column stats, which track the inserted values */
+	ChunkInsertColumnStats *column_stats;
 	MemoryContext mctx;
 	EState *estate;
 } ChunkInsertState;
@@ -59,4 +80,19 @@ typedef struct ChunkDispatch ChunkDispatch;
 extern ChunkInsertState *ts_chunk_insert_state_create(Chunk *chunk, ChunkDispatch *dispatch);
 extern void ts_chunk_insert_state_destroy(ChunkInsertState *state);
 
+static inline void
+ts_chunk_insert_state_track_invalidation(ChunkInsertState *state, Point *p)
+{
+	ChunkInsertInvalidation *inval = state->invalidation;
+	int64 value = p->coordinates[inval->dimension_index];
+
+	if (value < inval->minimum)
+		return;
+
+	if (value < inval->lowest)
+		inval->lowest = value;
+	if (value > inval->greatest)
+		inval->greatest = value;
+}
+
 #endif /* TIMESCALEDB_CHUNK_INSERT_STATE_H */
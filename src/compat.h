@@ -664,6 +664,19 @@ get_attname_compat(Oid relid, AttrNumber attnum, bool missing_ok)
 	ExplainPropertyInteger(label, unit, value, es)
 #endif
 
+/*
+ * ExplainPropertyFloat
+ *
+ * PG11 added a unit parameter to ExplainPropertyFloat
+ */
+#if PG11_LT
+#define ExplainPropertyFloatCompat(label, unit, value, ndigits, es)                                \
+	ExplainPropertyFloat(label, value, ndigits, es)
+#else
+#define ExplainPropertyFloatCompat(label, unit, value, ndigits, es)                                \
+	ExplainPropertyFloat(label, unit, value, ndigits, es)
+#endif
+
 /* ParseFuncOrColumn */
 #if PG96
 #define ParseFuncOrColumnCompat(pstate, funcname, fargs, fn, location)                             \
@@ -736,12 +749,11 @@ get_attname_compat(Oid relid, AttrNumber attnum, bool missing_ok)
  *
  * PG11 renames FooTransactionChain -> FooTransactionBlock. (See:
  * https://github.com/postgres/postgres/commit/04700b685f31508036456bea4d92533e5ceee9d6).
- * Map them back to TransactionChain for previous versions. (We currently only
- * use one of the functions in this family, but making this general in case we
- * use the others in the future).
+ * Map them back to TransactionChain for previous versions.
  */
 #if PG11_LT
 #define PreventInTransactionBlock PreventTransactionChain
+#define IsInTransactionBlock IsInTransactionChain
 #endif
 
 /*
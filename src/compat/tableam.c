@@ -44,6 +44,22 @@ ts_table_tuple_insert(Relation rel, TupleTableSlot *slot, CommandId cid, int opt
 		pfree(tuple);
 }
 
+void
+ts_table_multi_insert(Relation rel, TupleTableSlot **slots, int nslots, CommandId cid, int options,
+					  struct BulkInsertStateData *bistate)
+{
+	HeapTuple *tuples = palloc(sizeof(HeapTuple) * nslots);
+	int i;
+
+	/* The slots own the materialized tuples, so heap_multi_insert() copies
+	 * the resulting ItemPointers back into the slots' tuples */
+	for (i = 0; i < nslots; i++)
+		tuples[i] = ExecMaterializeSlot(slots[i]);
+
+	heap_multi_insert(rel, tuples, nslots, cid, options, bistate);
+	pfree(tuples);
+}
+
 bool
 ts_table_scan_getnextslot(TableScanDesc scan, const ScanDirection direction, TupleTableSlot *slot)
 {
@@ -4,6 +4,7 @@
  * LICENSE-APACHE for a copy of the license.
  */
 #include <postgres.h>
+#include <access/htup_details.h>
 
 #include "compression_chunk_size.h"
 #include "catalog.h"
@@ -48,17 +49,64 @@ ts_compression_chunk_size_totals()
 	ts_scanner_foreach(&iterator)
 	{
 		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
-		FormData_compression_chunk_size *fd = STRUCT_FROM_TUPLE(ti->tuple,
-																ti->mctx,
-																FormData_compression_chunk_size,
-																FormData_compression_chunk_size);
-		sizes.uncompressed_heap_size += fd->uncompressed_heap_size;
-		sizes.uncompressed_index_size += fd->uncompressed_index_size;
-		sizes.uncompressed_toast_size += fd->uncompressed_toast_size;
-		sizes.compressed_heap_size += fd->compressed_heap_size;
-		sizes.compressed_index_size += fd->compressed_index_size;
-		sizes.compressed_toast_size += fd->compressed_toast_size;
+		Datum values[Natts_compression_chunk_size];
+		bool nulls[Natts_compression_chunk_size];
+
+		/* the row count columns are nullable, so we cannot use STRUCT_FROM_TUPLE here */
+		heap_deform_tuple(ti->tuple, ti->desc, values, nulls);
+
+		sizes.uncompressed_heap_size += DatumGetInt64(
+			values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_uncompressed_heap_size)]);
+		sizes.uncompressed_index_size += DatumGetInt64(
+			values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_uncompressed_index_size)]);
+		sizes.uncompressed_toast_size += DatumGetInt64(
+			values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_uncompressed_toast_size)]);
+		sizes.compressed_heap_size += DatumGetInt64(
+			values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_compressed_heap_size)]);
+		sizes.compressed_index_size += DatumGetInt64(
+			values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_compressed_index_size)]);
+		sizes.compressed_toast_size += DatumGetInt64(
+			values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_compressed_toast_size)]);
 	}
 
 	return sizes;
 }
+
+/*
+ * Get the number of rows in a chunk before and after compression.
+ *
+ * Returns false if the chunk is not compressed or was compressed by a version
+ * that did not record row counts.
+ */
+TSDLLEXPORT bool
+ts_compression_chunk_size_row_counts(int32 uncompressed_chunk_id, int64 *rowcnt_pre_compression,
+									 int64 *rowcnt_post_compression)
+{
+	ScanIterator iterator =
+		ts_scan_iterator_create(COMPRESSION_CHUNK_SIZE, AccessShareLock, CurrentMemoryContext);
+	bool found = false;
+
+	init_scan_by_uncompressed_chunk_id(&iterator, uncompressed_chunk_id);
+	ts_scanner_foreach(&iterator)
+	{
+		TupleInfo *ti = ts_scan_iterator_tuple_info(&iterator);
+		bool pre_isnull, post_isnull;
+		Datum pre = heap_getattr(ti->tuple,
+								 Anum_compression_chunk_size_numrows_pre_compression,
+								 ti->desc,
+								 &pre_isnull);
+		Datum post = heap_getattr(ti->tuple,
+								  Anum_compression_chunk_size_numrows_post_compression,
+								  ti->desc,
+								  &post_isnull);
+
+		if (pre_isnull || post_isnull)
+			continue;
+
+		*rowcnt_pre_compression = DatumGetInt64(pre);
+		*rowcnt_post_compression = DatumGetInt64(post);
+		found = true;
+	}
+
+	return found;
+}
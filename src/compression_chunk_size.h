@@ -21,5 +21,8 @@ typedef struct TotalSizes
 } TotalSizes;
 
 extern TSDLLEXPORT TotalSizes ts_compression_chunk_size_totals(void);
+extern TSDLLEXPORT bool ts_compression_chunk_size_row_counts(int32 uncompressed_chunk_id,
+															 int64 *rowcnt_pre_compression,
+															 int64 *rowcnt_post_compression);
 
 #endif
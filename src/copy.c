@@ -26,6 +26,7 @@
 #include <parser/parse_coerce.h>
 #include <parser/parse_collate.h>
 #include <parser/parse_relation.h>
+#include <rewrite/rewriteHandler.h>
 #include <storage/bufmgr.h>
 #include <utils/builtins.h>
 #include <utils/guc.h>
@@ -38,11 +39,12 @@
 #include "dimension.h"
 #include "chunk_insert_state.h"
 #include "chunk_dispatch.h"
-#include "subspace_store.h"
 #include "compat.h"
 
 #if PG12_GE
 #include <optimizer/optimizer.h>
+#else
+#include <optimizer/clauses.h>
 #endif
 
 /*
@@ -82,6 +84,10 @@ copy_chunk_state_create(Hypertable *ht, Relation rel, CopyFromFunc from_func, Co
 	ccstate->rel = rel;
 	ccstate->estate = estate;
 	ccstate->dispatch = ts_chunk_dispatch_create(ht, estate);
+
+	/* Only collect routing statistics if they are going to be reported */
+	if (log_min_messages <= DEBUG1 || client_min_messages <= DEBUG1)
+		ts_chunk_dispatch_instrument(ccstate->dispatch, false);
 	ccstate->cstate = cstate;
 	ccstate->scandesc = scandesc;
 	ccstate->next_copy_from = from_func;
@@ -90,9 +96,214 @@ copy_chunk_state_create(Hypertable *ht, Relation rel, CopyFromFunc from_func, Co
 	return ccstate;
 }
 
+/*
+ * Rows are buffered per chunk and written using multi-inserts. The buffer is
+ * bounded both in the number of rows and in the (approximate) number of bytes
+ * it holds. Only one chunk is buffered at a time, so the buffer is flushed
+ * whenever the COPY switches to another chunk, which means that the data
+ * should be (mostly) ordered on time for buffering to be effective. This is
+ * usually the case for time-series data.
+ */
+#define MAX_BUFFERED_TUPLES 1000
+#define MAX_BUFFERED_BYTES 65535
+
+typedef struct CopyMultiInsertBuffer
+{
+	/* The chunk that the buffered rows are inserted into */
+	ChunkInsertState *cis;
+	/* The descriptor that the slots were created with */
+	TupleDesc tupdesc;
+	TupleTableSlot *slots[MAX_BUFFERED_TUPLES];
+	int nslots; /* number of slots created */
+	int nused;  /* number of slots holding buffered rows */
+	Size bytes; /* approximate size of the buffered rows */
+	MemoryContext mctx;
+	CommandId mycid;
+	int ti_options;
+	BulkInsertState bistate;
+} CopyMultiInsertBuffer;
+
+static CopyMultiInsertBuffer *
+copy_multi_insert_buffer_create(EState *estate, CommandId mycid, int ti_options,
+								BulkInsertState bistate)
+{
+	CopyMultiInsertBuffer *buffer = palloc0(sizeof(CopyMultiInsertBuffer));
+
+	buffer->mctx = estate->es_query_cxt;
+	buffer->mycid = mycid;
+	buffer->ti_options = ti_options;
+	buffer->bistate = bistate;
+
+	return buffer;
+}
+
+static void
+copy_multi_insert_buffer_drop_slots(CopyMultiInsertBuffer *buffer)
+{
+	int i;
+
+	Assert(buffer->nused == 0);
+
+	for (i = 0; i < buffer->nslots; i++)
+		ExecDropSingleTupleTableSlot(buffer->slots[i]);
+
+	buffer->nslots = 0;
+	buffer->tupdesc = NULL;
+}
+
+/*
+ * Add a row to the buffer.
+ *
+ * The row is copied into one of the buffer's slots, so the given slot can be
+ * reused for the next row. Returns true if the buffer is full and needs to be
+ * flushed.
+ */
+static bool
+copy_multi_insert_buffer_add(CopyMultiInsertBuffer *buffer, ChunkInsertState *cis,
+							 TupleTableSlot *slot)
+{
+	TupleTableSlot *bufslot;
+	HeapTuple tuple;
+
+	Assert(buffer->nused == 0 || buffer->cis == cis);
+	Assert(buffer->nused < MAX_BUFFERED_TUPLES);
+
+	/*
+	 * Rows that need no conversion all share the hypertable's descriptor,
+	 * while converted rows use the slot of the chunk's insert state. The
+	 * buffered slots must match the descriptor of the rows they hold.
+	 */
+	if (buffer->tupdesc != slot->tts_tupleDescriptor)
+	{
+		copy_multi_insert_buffer_drop_slots(buffer);
+		buffer->tupdesc = slot->tts_tupleDescriptor;
+	}
+
+	if (buffer->nused == buffer->nslots)
+	{
+		MemoryContext old = MemoryContextSwitchTo(buffer->mctx);
+
+		buffer->slots[buffer->nslots++] =
+			MakeSingleTupleTableSlotCompat(buffer->tupdesc, TTSOpsHeapTupleP);
+		MemoryContextSwitchTo(old);
+	}
+
+	bufslot = buffer->slots[buffer->nused++];
+	ExecCopySlot(bufslot, slot);
+	tuple = ExecFetchSlotHeapTuple(bufslot, false, NULL);
+	buffer->bytes += tuple->t_len;
+	buffer->cis = cis;
+
+	return buffer->nused == MAX_BUFFERED_TUPLES || buffer->bytes >= MAX_BUFFERED_BYTES;
+}
+
+/*
+ * The error context of COPY reports the line currently being read, which is
+ * not the line of the row that failed when flushing buffered rows. Report the
+ * chunk instead.
+ */
+static void
+copy_multi_insert_buffer_error_callback(void *arg)
+{
+	CopyMultiInsertBuffer *buffer = arg;
+
+	errcontext("inserting %d buffered rows into chunk \"%s\"",
+			   buffer->nused,
+			   RelationGetRelationName(buffer->cis->rel));
+}
+
+/*
+ * Write all buffered rows to the buffer's chunk.
+ *
+ * The rows are inserted in one go using a multi-insert, after which index
+ * entries are created and AFTER ROW triggers are queued for each row.
+ */
+static void
+copy_multi_insert_buffer_flush(CopyMultiInsertBuffer *buffer, EState *estate)
+{
+	ResultRelInfo *saved_resultRelInfo = estate->es_result_relation_info;
+	ResultRelInfo *resultRelInfo;
+	ErrorContextCallback *saved_context = error_context_stack;
+	ErrorContextCallback errcallback = {
+		.callback = copy_multi_insert_buffer_error_callback,
+		.arg = buffer,
+		.previous = error_context_stack,
+	};
+	MemoryContext old;
+	int i;
+
+	if (buffer->nused == 0)
+		return;
+
+	/* Skip the COPY line context since it refers to the wrong line */
+	if (error_context_stack != NULL && error_context_stack->callback == CopyFromErrorCallback)
+		errcallback.previous = error_context_stack->previous;
+	error_context_stack = &errcallback;
+
+	resultRelInfo = buffer->cis->result_relation_info;
+	estate->es_result_relation_info = resultRelInfo;
+
+	old = MemoryContextSwitchTo(GetPerTupleMemoryContext(estate));
+	table_multi_insert(resultRelInfo->ri_RelationDesc,
+					   buffer->slots,
+					   buffer->nused,
+					   buffer->mycid,
+					   buffer->ti_options,
+					   buffer->bistate);
+	MemoryContextSwitchTo(old);
+
+	for (i = 0; i < buffer->nused; i++)
+	{
+		TupleTableSlot *slot = buffer->slots[i];
+		List *recheckIndexes = NIL;
+
+		if (resultRelInfo->ri_NumIndices > 0)
+			recheckIndexes = ExecInsertIndexTuplesCompat(slot, estate, false, NULL, NIL);
+
+		/* AFTER ROW INSERT Triggers */
+		ExecARInsertTriggersCompat(estate,
+								   resultRelInfo,
+								   slot,
+								   recheckIndexes,
+								   NULL /* transition capture */);
+
+		list_free(recheckIndexes);
+		ExecClearTuple(slot);
+	}
+
+	buffer->nused = 0;
+	buffer->bytes = 0;
+	estate->es_result_relation_info = saved_resultRelInfo;
+	error_context_stack = saved_context;
+}
+
+/*
+ * Report the tuple routing statistics of the COPY. These are the same counters
+ * that EXPLAIN ANALYZE shows for inserts.
+ */
+static void
+copy_chunk_state_report_routing(CopyChunkState *ccstate)
+{
+	ChunkDispatchInstrumentation *instr = ccstate->dispatch->instrument;
+
+	if (NULL == instr)
+		return;
+
+	elog(DEBUG1,
+		 "tuple routing into \"%s\": %d chunks touched, %d chunk insert states created, %d chunk "
+		 "switches, %d chunk insert states evicted, %d chunks created",
+		 RelationGetRelationName(ccstate->rel),
+		 bms_num_members(instr->chunks),
+		 instr->insert_states_created,
+		 instr->chunk_switches,
+		 ts_chunk_dispatch_num_evicted(ccstate->dispatch),
+		 instr->chunks_created);
+}
+
 static void
 copy_chunk_state_destroy(CopyChunkState *ccstate)
 {
+	copy_chunk_state_report_routing(ccstate);
 	ts_chunk_dispatch_destroy(ccstate->dispatch);
 	FreeExecutorState(ccstate->estate);
 }
@@ -124,6 +335,46 @@ on_chunk_insert_state_changed(ChunkInsertState *state, void *data)
 	bistate->current_buf = InvalidBuffer;
 }
 
+/*
+ * Check if rows can be buffered and written using multi-inserts.
+ *
+ * Like PostgreSQL's COPY, we cannot buffer rows if column defaults or the
+ * WHERE clause are volatile, since these could query the table that we are
+ * inserting into and expect to see the rows written so far. BEFORE ROW
+ * triggers are checked per chunk when inserting.
+ */
+static bool
+copy_use_multi_insert(CopyChunkState *ccstate)
+{
+	TupleDesc tupdesc = RelationGetDescr(ccstate->rel);
+	int i;
+
+#if PG12_GE
+	if (ccstate->where_clause != NULL && contain_volatile_functions(ccstate->where_clause))
+		return false;
+#endif
+
+	/* Moving data from the main table does not evaluate defaults */
+	if (NULL == ccstate->cstate)
+		return true;
+
+	for (i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+		Node *defexpr;
+
+		if (attr->attisdropped || !attr->atthasdef)
+			continue;
+
+		defexpr = build_column_default(ccstate->rel, attr->attnum);
+
+		if (defexpr != NULL && contain_volatile_functions_not_nextval(defexpr))
+			return false;
+	}
+
+	return true;
+}
+
 /*
  * Copy FROM file to relation.
  */
@@ -142,6 +393,7 @@ copyfrom(CopyChunkState *ccstate, List *range_table, Hypertable *ht)
 	CommandId mycid = GetCurrentCommandId(true);
 	int ti_options = 0; /* start with default options for insert */
 	BulkInsertState bistate;
+	CopyMultiInsertBuffer *buffer = NULL;
 	uint64 processed = 0;
 #if PG12_GE
 	ExprState *qualexpr;
@@ -280,6 +532,9 @@ copyfrom(CopyChunkState *ccstate, List *range_table, Hypertable *ht)
 	bistate = GetBulkInsertState();
 	econtext = GetPerTupleExprContext(estate);
 
+	if (copy_use_multi_insert(ccstate))
+		buffer = copy_multi_insert_buffer_create(estate, mycid, ti_options, bistate);
+
 	/* Set up callback to identify error line number.
 	 *
 	 * It is not necessary to add an entry to the error context stack if we do
@@ -297,6 +552,7 @@ copyfrom(CopyChunkState *ccstate, List *range_table, Hypertable *ht)
 	{
 		TupleTableSlot *myslot;
 		bool skip_tuple;
+		bool has_before_row_triggers;
 		Point *point;
 		ChunkDispatch *dispatch = ccstate->dispatch;
 		ChunkInsertState *cis;
@@ -324,11 +580,31 @@ copyfrom(CopyChunkState *ccstate, List *range_table, Hypertable *ht)
 		if (NULL == dispatch->hypertable_result_rel_info)
 			dispatch->hypertable_result_rel_info = estate->es_result_relation_info;
 
+		/*
+		 * Buffered rows must be flushed before switching to another chunk,
+		 * since looking up the new chunk might close the buffered chunk's
+		 * insert state. If the row belongs to the buffered chunk we already
+		 * have its insert state.
+		 */
+		cis = NULL;
+
+		if (NULL != buffer && buffer->nused > 0)
+		{
+			cis = ts_chunk_dispatch_find_chunk_insert_state(dispatch, point);
+
+			if (cis != buffer->cis)
+			{
+				copy_multi_insert_buffer_flush(buffer, estate);
+				cis = NULL;
+			}
+		}
+
 		/* Find or create the insert state matching the point */
-		cis = ts_chunk_dispatch_get_chunk_insert_state(dispatch,
-													   point,
-													   on_chunk_insert_state_changed,
-													   bistate);
+		if (NULL == cis)
+			cis = ts_chunk_dispatch_get_chunk_insert_state(dispatch,
+														   point,
+														   on_chunk_insert_state_changed,
+														   bistate);
 
 		Assert(cis != NULL);
 
@@ -348,6 +624,14 @@ copyfrom(CopyChunkState *ccstate, List *range_table, Hypertable *ht)
 		}
 #endif
 
+		/* Track the tuple for continuous aggregate invalidation */
+		if (NULL != cis->invalidation)
+			ts_chunk_insert_state_track_invalidation(cis, point);
+
+		/* Track the values of columns with chunk column stats */
+		if (NULL != cis->column_stats)
+			ts_chunk_column_stats_track_insert(cis->column_stats, myslot);
+
 		/*
 		 * Set the result relation in the executor state to the target chunk.
 		 * This makes sure that the tuple gets inserted into the correct
@@ -361,9 +645,11 @@ copyfrom(CopyChunkState *ccstate, List *range_table, Hypertable *ht)
 		ts_tuptableslot_set_table_oid(myslot, RelationGetRelid(resultRelInfo->ri_RelationDesc));
 
 		skip_tuple = false;
+		has_before_row_triggers =
+			resultRelInfo->ri_TrigDesc && resultRelInfo->ri_TrigDesc->trig_insert_before_row;
 
 		/* BEFORE ROW INSERT Triggers */
-		if (resultRelInfo->ri_TrigDesc && resultRelInfo->ri_TrigDesc->trig_insert_before_row)
+		if (has_before_row_triggers)
 		{
 #if PG12_LT
 			myslot = ExecBRInsertTriggers(estate, resultRelInfo, myslot);
@@ -398,20 +684,33 @@ copyfrom(CopyChunkState *ccstate, List *range_table, Hypertable *ht)
 				ExecConstraints(resultRelInfo, myslot, estate);
 			}
 
-			/* OK, store the tuple and create index entries for it */
-			table_tuple_insert(resultRelInfo->ri_RelationDesc, myslot, mycid, ti_options, bistate);
-
-			if (resultRelInfo->ri_NumIndices > 0)
-				recheckIndexes = ExecInsertIndexTuplesCompat(myslot, estate, false, NULL, NIL);
-
-			/* AFTER ROW INSERT Triggers */
-			ExecARInsertTriggersCompat(estate,
-									   resultRelInfo,
-									   myslot,
-									   recheckIndexes,
-									   NULL /* transition capture */);
-
-			list_free(recheckIndexes);
+			if (NULL != buffer && !has_before_row_triggers)
+			{
+				/* Buffer the tuple and write it when the buffer is full */
+				if (copy_multi_insert_buffer_add(buffer, cis, myslot))
+					copy_multi_insert_buffer_flush(buffer, estate);
+			}
+			else
+			{
+				/* OK, store the tuple and create index entries for it */
+				table_tuple_insert(resultRelInfo->ri_RelationDesc,
+								   myslot,
+								   mycid,
+								   ti_options,
+								   bistate);
+
+				if (resultRelInfo->ri_NumIndices > 0)
+					recheckIndexes = ExecInsertIndexTuplesCompat(myslot, estate, false, NULL, NIL);
+
+				/* AFTER ROW INSERT Triggers */
+				ExecARInsertTriggersCompat(estate,
+										   resultRelInfo,
+										   myslot,
+										   recheckIndexes,
+										   NULL /* transition capture */);
+
+				list_free(recheckIndexes);
+			}
 
 			/*
 			 * We count only tuples not suppressed by a BEFORE INSERT trigger;
@@ -425,6 +724,12 @@ copyfrom(CopyChunkState *ccstate, List *range_table, Hypertable *ht)
 		estate->es_result_relation_info = resultRelInfo;
 	}
 
+	if (NULL != buffer)
+	{
+		copy_multi_insert_buffer_flush(buffer, estate);
+		copy_multi_insert_buffer_drop_slots(buffer);
+	}
+
 	estate->es_result_relation_info = ccstate->dispatch->hypertable_result_rel_info;
 
 	/* Done, clean up */
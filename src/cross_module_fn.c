@@ -16,9 +16,11 @@
 TS_FUNCTION_INFO_V1(ts_add_drop_chunks_policy);
 TS_FUNCTION_INFO_V1(ts_add_reorder_policy);
 TS_FUNCTION_INFO_V1(ts_add_compress_chunks_policy);
+TS_FUNCTION_INFO_V1(ts_add_precreate_chunks_policy);
 TS_FUNCTION_INFO_V1(ts_remove_drop_chunks_policy);
 TS_FUNCTION_INFO_V1(ts_remove_reorder_policy);
 TS_FUNCTION_INFO_V1(ts_remove_compress_chunks_policy);
+TS_FUNCTION_INFO_V1(ts_remove_precreate_chunks_policy);
 TS_FUNCTION_INFO_V1(ts_alter_job_schedule);
 TS_FUNCTION_INFO_V1(ts_reorder_chunk);
 TS_FUNCTION_INFO_V1(ts_move_chunk);
@@ -63,6 +65,12 @@ ts_add_compress_chunks_policy(PG_FUNCTION_ARGS)
 	PG_RETURN_DATUM(ts_cm_functions->add_compress_chunks_policy(fcinfo));
 }
 
+Datum
+ts_add_precreate_chunks_policy(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_DATUM(ts_cm_functions->add_precreate_chunks_policy(fcinfo));
+}
+
 Datum
 ts_remove_drop_chunks_policy(PG_FUNCTION_ARGS)
 {
@@ -81,6 +89,12 @@ ts_remove_compress_chunks_policy(PG_FUNCTION_ARGS)
 	return ts_cm_functions->remove_compress_chunks_policy(fcinfo);
 }
 
+Datum
+ts_remove_precreate_chunks_policy(PG_FUNCTION_ARGS)
+{
+	PG_RETURN_DATUM(ts_cm_functions->remove_precreate_chunks_policy(fcinfo));
+}
+
 Datum
 ts_alter_job_schedule(PG_FUNCTION_ARGS)
 {
@@ -371,9 +385,11 @@ TSDLLEXPORT CrossModuleFunctions ts_cm_functions_default = {
 	.add_drop_chunks_policy = error_no_default_fn_pg_community,
 	.add_reorder_policy = error_no_default_fn_pg_community,
 	.add_compress_chunks_policy = error_no_default_fn_pg_community,
+	.add_precreate_chunks_policy = error_no_default_fn_pg_community,
 	.remove_drop_chunks_policy = error_no_default_fn_pg_community,
 	.remove_reorder_policy = error_no_default_fn_pg_community,
 	.remove_compress_chunks_policy = error_no_default_fn_pg_community,
+	.remove_precreate_chunks_policy = error_no_default_fn_pg_community,
 	.create_upper_paths_hook = NULL,
 	.set_rel_pathlist_dml = NULL,
 	.set_rel_pathlist_query = NULL,
@@ -396,6 +412,8 @@ TSDLLEXPORT CrossModuleFunctions ts_cm_functions_default = {
 	.process_cagg_viewstmt = process_cagg_viewstmt_default,
 	.continuous_agg_drop_chunks_by_chunk_id = continuous_agg_drop_chunks_by_chunk_id_default,
 	.continuous_agg_trigfn = error_no_default_fn_pg_community,
+	.continuous_agg_invalidation_minimum = NULL,
+	.continuous_agg_invalidate_range = NULL,
 	.continuous_agg_update_options = continuous_agg_update_options_default,
 
 	.compressed_data_send = error_no_default_fn_pg_community,
@@ -405,6 +423,7 @@ TSDLLEXPORT CrossModuleFunctions ts_cm_functions_default = {
 	.process_compress_table = process_compress_table_default,
 	.compress_chunk = error_no_default_fn_pg_community,
 	.decompress_chunk = error_no_default_fn_pg_community,
+	.analyze_compressed_chunk = NULL,
 	.compressed_data_decompress_forward = error_no_default_fn_pg_community,
 	.compressed_data_decompress_reverse = error_no_default_fn_pg_community,
 	.deltadelta_compressor_append = error_no_default_fn_pg_community,
@@ -41,9 +41,11 @@ typedef struct CrossModuleFunctions
 	Datum (*add_drop_chunks_policy)(PG_FUNCTION_ARGS);
 	Datum (*add_reorder_policy)(PG_FUNCTION_ARGS);
 	Datum (*add_compress_chunks_policy)(PG_FUNCTION_ARGS);
+	Datum (*add_precreate_chunks_policy)(PG_FUNCTION_ARGS);
 	Datum (*remove_drop_chunks_policy)(PG_FUNCTION_ARGS);
 	Datum (*remove_reorder_policy)(PG_FUNCTION_ARGS);
 	Datum (*remove_compress_chunks_policy)(PG_FUNCTION_ARGS);
+	Datum (*remove_precreate_chunks_policy)(PG_FUNCTION_ARGS);
 	void (*create_upper_paths_hook)(PlannerInfo *, UpperRelationKind, RelOptInfo *, RelOptInfo *);
 	void (*set_rel_pathlist_dml)(PlannerInfo *, RelOptInfo *, Index, RangeTblEntry *, Hypertable *);
 	void (*set_rel_pathlist_query)(PlannerInfo *, RelOptInfo *, Index, RangeTblEntry *,
@@ -74,6 +76,8 @@ typedef struct CrossModuleFunctions
 												   bool cascade, int32 log_level,
 												   bool user_supplied_table_name);
 	PGFunction continuous_agg_trigfn;
+	int64 (*continuous_agg_invalidation_minimum)(int32 hypertable_id);
+	void (*continuous_agg_invalidate_range)(int32 hypertable_id, int64 lowest, int64 greatest);
 	void (*continuous_agg_update_options)(ContinuousAgg *cagg,
 										  WithClauseResult *with_clause_options);
 
@@ -85,6 +89,7 @@ typedef struct CrossModuleFunctions
 								   WithClauseResult *with_clause_options);
 	PGFunction compress_chunk;
 	PGFunction decompress_chunk;
+	void (*analyze_compressed_chunk)(Chunk *chunk);
 	/* The compression functions below are not installed in SQL as part of create extension;
 	 *  They are installed and tested during testing scripts. They are exposed in cross-module
 	 *  functions because they may be very useful for debugging customer problems if the sql
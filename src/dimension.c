@@ -718,6 +718,34 @@ point_create(int16 num_dimensions)
 	return p;
 }
 
+static void
+point_add_coordinate(Point *p, Dimension *d, Datum datum, bool isnull)
+{
+	Oid dimtype;
+
+	switch (d->type)
+	{
+		case DIMENSION_TYPE_OPEN:
+			dimtype = ts_dimension_get_partition_type(d);
+
+			if (isnull)
+				ereport(ERROR,
+						(errcode(ERRCODE_NOT_NULL_VIOLATION),
+						 errmsg("NULL value in column \"%s\" violates not-null constraint",
+								NameStr(d->fd.column_name)),
+						 errhint("Columns used for time partitioning cannot be NULL")));
+
+			p->coordinates[p->num_coords++] = ts_time_value_to_internal(datum, dimtype);
+			break;
+		case DIMENSION_TYPE_CLOSED:
+			p->coordinates[p->num_coords++] = (int64) DatumGetInt32(datum);
+			break;
+		case DIMENSION_TYPE_ANY:
+			elog(ERROR, "invalid dimension type when inserting tuple");
+			break;
+	}
+}
+
 TSDLLEXPORT Point *
 ts_hyperspace_calculate_point(Hyperspace *hs, TupleTableSlot *slot)
 {
@@ -729,39 +757,54 @@ ts_hyperspace_calculate_point(Hyperspace *hs, TupleTableSlot *slot)
 		Dimension *d = &hs->dimensions[i];
 		Datum datum;
 		bool isnull;
-		Oid dimtype;
 
 		if (NULL != d->partitioning)
 			datum = ts_partitioning_func_apply_slot(d->partitioning, slot, &isnull);
 		else
 			datum = slot_getattr(slot, d->column_attno, &isnull);
 
-		switch (d->type)
-		{
-			case DIMENSION_TYPE_OPEN:
-				dimtype = ts_dimension_get_partition_type(d);
-
-				if (isnull)
-					ereport(ERROR,
-							(errcode(ERRCODE_NOT_NULL_VIOLATION),
-							 errmsg("NULL value in column \"%s\" violates not-null constraint",
-									NameStr(d->fd.column_name)),
-							 errhint("Columns used for time partitioning cannot be NULL")));
-
-				p->coordinates[p->num_coords++] = ts_time_value_to_internal(datum, dimtype);
-				break;
-			case DIMENSION_TYPE_CLOSED:
-				p->coordinates[p->num_coords++] = (int64) DatumGetInt32(datum);
-				break;
-			case DIMENSION_TYPE_ANY:
-				elog(ERROR, "invalid dimension type when inserting tuple");
-				break;
-		}
+		point_add_coordinate(p, d, datum, isnull);
 	}
 
 	return p;
 }
 
+/*
+ * Calculate the points of a set of tuples in the hyperspace.
+ *
+ * Same as calling ts_hyperspace_calculate_point() on each slot, but the
+ * points are computed one dimension at a time so that the partitioning
+ * function of a dimension is set up once for all the tuples.
+ */
+void
+ts_hyperspace_calculate_points(Hyperspace *hs, TupleTableSlot **slots, int num_slots,
+							   Point **points)
+{
+	Datum *values = palloc(sizeof(Datum) * num_slots);
+	bool *isnull = palloc(sizeof(bool) * num_slots);
+	int i, j;
+
+	for (j = 0; j < num_slots; j++)
+		points[j] = point_create(hs->num_dimensions);
+
+	for (i = 0; i < hs->num_dimensions; i++)
+	{
+		Dimension *d = &hs->dimensions[i];
+
+		if (NULL != d->partitioning)
+			ts_partitioning_func_apply_slots(d->partitioning, slots, num_slots, values, isnull);
+		else
+			for (j = 0; j < num_slots; j++)
+				values[j] = slot_getattr(slots[j], d->column_attno, &isnull[j]);
+
+		for (j = 0; j < num_slots; j++)
+			point_add_coordinate(points[j], d, values[j], isnull[j]);
+	}
+
+	pfree(values);
+	pfree(isnull);
+}
+
 static inline int64
 interval_to_usec(Interval *interval)
 {
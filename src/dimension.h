@@ -126,6 +126,8 @@ extern Hyperspace *ts_dimension_scan(int32 hypertable_id, Oid main_table_relid,
 									 MemoryContext mctx);
 extern DimensionSlice *ts_dimension_calculate_default_slice(Dimension *dim, int64 value);
 extern TSDLLEXPORT Point *ts_hyperspace_calculate_point(Hyperspace *h, TupleTableSlot *slot);
+extern void ts_hyperspace_calculate_points(Hyperspace *hs, TupleTableSlot **slots,
+										   int num_slots, Point **points);
 extern Dimension *ts_hyperspace_get_dimension_by_id(Hyperspace *hs, int32 id);
 extern TSDLLEXPORT Dimension *ts_hyperspace_get_dimension(Hyperspace *hs, DimensionType type,
 														  Index n);
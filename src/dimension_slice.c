@@ -14,6 +14,10 @@
 #include <utils/lsyscache.h>
 #include <catalog/pg_opfamily.h>
 #include <catalog/pg_type.h>
+#include <access/hash.h>
+#include <access/htup_details.h>
+#include <miscadmin.h>
+#include <utils/syscache.h>
 
 #include "bgw_policy/chunk_stats.h"
 #include "catalog.h"
@@ -24,6 +28,7 @@
 #include "dimension_vector.h"
 #include "hypertable.h"
 #include "scanner.h"
+#include "loader/shared_slice_cache.h"
 
 #include "compat.h"
 
@@ -55,6 +60,229 @@ dimension_slice_from_tuple(HeapTuple tuple)
 	return dimension_slice_from_form_data((Form_dimension_slice) GETSTRUCT(tuple));
 }
 
+/*
+ * Get the shared slice cache set up by the loader, or NULL if there is none
+ * (e.g., the loader is not preloaded or the cache is disabled).
+ */
+static SharedSliceCache *
+shared_slice_cache_get(void)
+{
+	static SharedSliceCache **cache_pointer = NULL;
+
+	if (NULL == cache_pointer)
+		cache_pointer =
+			(SharedSliceCache **) find_rendezvous_variable(RENDEZVOUS_SHARED_SLICE_CACHE);
+
+	if (NULL == *cache_pointer || (*cache_pointer)->version != SHARED_SLICE_CACHE_VERSION)
+		return NULL;
+
+	return *cache_pointer;
+}
+
+/*
+ * Get the generation of the extension in the current database, which is the
+ * transaction that created the dimension slice catalog table.
+ */
+static TransactionId
+shared_slice_cache_catalog_generation(Oid catalog_relid)
+{
+	HeapTuple tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(catalog_relid));
+	TransactionId xmin;
+
+	if (!HeapTupleIsValid(tuple))
+		elog(ERROR, "cache lookup failed for relation %u", catalog_relid);
+
+	xmin = HeapTupleHeaderGetRawXmin(tuple->t_data);
+	ReleaseSysCache(tuple);
+
+	return xmin;
+}
+
+static void
+shared_slice_cache_key_init(SharedSliceCacheKey *key, int32 dimension_slice_id)
+{
+	memset(key, 0, sizeof(SharedSliceCacheKey));
+	key->dbid = MyDatabaseId;
+	key->catalog_relid = ts_catalog_get()->tables[DIMENSION_SLICE].id;
+	key->catalog_xmin = shared_slice_cache_catalog_generation(key->catalog_relid);
+	key->slice_id = dimension_slice_id;
+}
+
+static SharedSliceCacheEntry *
+shared_slice_cache_get_set(SharedSliceCache *cache, const SharedSliceCacheKey *key, LWLock **lock)
+{
+	uint32 set = DatumGetUInt32(hash_any((const unsigned char *) key, sizeof(*key))) %
+				 (uint32) cache->num_sets;
+
+	*lock = SHARED_SLICE_CACHE_PARTITION_LOCK(cache, set);
+
+	return &cache->entries[set * SHARED_SLICE_CACHE_SET_SIZE];
+}
+
+static inline bool
+shared_slice_cache_entry_matches(SharedSliceCacheEntry *entry, const SharedSliceCacheKey *key)
+{
+	return entry->valid && memcmp(&entry->key, key, sizeof(*key)) == 0;
+}
+
+/*
+ * Find a slice in a shared slice cache. Returns true and fills in the slice
+ * if found.
+ */
+bool
+ts_shared_slice_cache_find(SharedSliceCache *cache, const SharedSliceCacheKey *key,
+						   DimensionSlice *slice)
+{
+	LWLock *lock;
+	SharedSliceCacheEntry *set = shared_slice_cache_get_set(cache, key, &lock);
+	bool found = false;
+	int i;
+
+	LWLockAcquire(lock, LW_SHARED);
+
+	for (i = 0; i < SHARED_SLICE_CACHE_SET_SIZE; i++)
+	{
+		SharedSliceCacheEntry *entry = &set[i];
+
+		if (shared_slice_cache_entry_matches(entry, key))
+		{
+			slice->fd.id = key->slice_id;
+			slice->fd.dimension_id = entry->dimension_id;
+			slice->fd.range_start = entry->range_start;
+			slice->fd.range_end = entry->range_end;
+			pg_atomic_write_u32(&entry->referenced, 1);
+			found = true;
+			break;
+		}
+	}
+
+	LWLockRelease(lock);
+
+	return found;
+}
+
+/*
+ * Add a slice to a shared slice cache.
+ *
+ * A full set replaces an entry that was not looked up since the references of
+ * the set were last cleared, which happens when all entries were looked up.
+ * New entries start out unreferenced, so entries that are never looked up are
+ * replaced first.
+ */
+void
+ts_shared_slice_cache_insert(SharedSliceCache *cache, const SharedSliceCacheKey *key,
+							 const DimensionSlice *slice)
+{
+	LWLock *lock;
+	SharedSliceCacheEntry *set = shared_slice_cache_get_set(cache, key, &lock);
+	SharedSliceCacheEntry *entry = NULL;
+	int i;
+
+	LWLockAcquire(lock, LW_EXCLUSIVE);
+
+	for (i = 0; i < SHARED_SLICE_CACHE_SET_SIZE; i++)
+	{
+		if (shared_slice_cache_entry_matches(&set[i], key))
+		{
+			entry = &set[i];
+			break;
+		}
+
+		if (NULL == entry && !set[i].valid)
+			entry = &set[i];
+	}
+
+	for (i = 0; NULL == entry && i < SHARED_SLICE_CACHE_SET_SIZE; i++)
+	{
+		if (pg_atomic_read_u32(&set[i].referenced) == 0)
+			entry = &set[i];
+	}
+
+	if (NULL == entry)
+	{
+		/* All entries were referenced, so give them another chance */
+		for (i = 0; i < SHARED_SLICE_CACHE_SET_SIZE; i++)
+			pg_atomic_write_u32(&set[i].referenced, 0);
+
+		entry = &set[(uint32) key->slice_id % SHARED_SLICE_CACHE_SET_SIZE];
+	}
+
+	entry->key = *key;
+	entry->valid = true;
+	entry->dimension_id = slice->fd.dimension_id;
+	entry->range_start = slice->fd.range_start;
+	entry->range_end = slice->fd.range_end;
+	pg_atomic_write_u32(&entry->referenced, 0);
+
+	LWLockRelease(lock);
+}
+
+void
+ts_shared_slice_cache_remove(SharedSliceCache *cache, const SharedSliceCacheKey *key)
+{
+	LWLock *lock;
+	SharedSliceCacheEntry *set = shared_slice_cache_get_set(cache, key, &lock);
+	int i;
+
+	LWLockAcquire(lock, LW_EXCLUSIVE);
+
+	for (i = 0; i < SHARED_SLICE_CACHE_SET_SIZE; i++)
+	{
+		if (shared_slice_cache_entry_matches(&set[i], key))
+			set[i].valid = false;
+	}
+
+	LWLockRelease(lock);
+}
+
+static DimensionSlice *
+shared_slice_cache_lookup(int32 dimension_slice_id, MemoryContext mctx)
+{
+	SharedSliceCache *cache = shared_slice_cache_get();
+	SharedSliceCacheKey key;
+	DimensionSlice *slice;
+
+	if (NULL == cache)
+		return NULL;
+
+	shared_slice_cache_key_init(&key, dimension_slice_id);
+	slice = MemoryContextAllocZero(mctx, sizeof(DimensionSlice));
+
+	if (!ts_shared_slice_cache_find(cache, &key, slice))
+	{
+		pfree(slice);
+		return NULL;
+	}
+
+	return slice;
+}
+
+static void
+shared_slice_cache_add(DimensionSlice *slice)
+{
+	SharedSliceCache *cache = shared_slice_cache_get();
+	SharedSliceCacheKey key;
+
+	if (NULL == cache)
+		return;
+
+	shared_slice_cache_key_init(&key, slice->fd.id);
+	ts_shared_slice_cache_insert(cache, &key, slice);
+}
+
+static void
+shared_slice_cache_delete(int32 dimension_slice_id)
+{
+	SharedSliceCache *cache = shared_slice_cache_get();
+	SharedSliceCacheKey key;
+
+	if (NULL == cache)
+		return;
+
+	shared_slice_cache_key_init(&key, dimension_slice_id);
+	ts_shared_slice_cache_remove(cache, &key);
+}
+
 DimensionSlice *
 ts_dimension_slice_create(int dimension_id, int64 range_start, int64 range_end)
 {
@@ -192,6 +420,89 @@ ts_dimension_slice_scan_limit(int32 dimension_id, int64 coordinate, int limit)
 	return ts_dimension_vec_sort(&slices);
 }
 
+/*
+ * Get the value to compare a slice's range_end with for a range search.
+ */
+static int64
+dimension_slice_range_end_value(int64 end_value)
+{
+	/*
+	 * range_end is stored as exclusive, so add 1 to the value being
+	 * searched. Also avoid overflow
+	 */
+	if (end_value != PG_INT64_MAX)
+	{
+		end_value++;
+
+		/*
+		 * If getting as input INT64_MAX-1, need to remap the incremented
+		 * value back to INT64_MAX-1
+		 */
+		return REMAP_LAST_COORDINATE(end_value);
+	}
+
+	/*
+	 * The point with INT64_MAX gets mapped to INT64_MAX-1 so incrementing
+	 * that gets you to INT_64MAX
+	 */
+	return PG_INT64_MAX;
+}
+
+static bool
+int64_cmp_strategy(int64 value, StrategyNumber strategy, int64 other)
+{
+	switch (strategy)
+	{
+		case BTLessStrategyNumber:
+			return value < other;
+		case BTLessEqualStrategyNumber:
+			return value <= other;
+		case BTEqualStrategyNumber:
+			return value == other;
+		case BTGreaterEqualStrategyNumber:
+			return value >= other;
+		case BTGreaterStrategyNumber:
+			return value > other;
+		default:
+			return true;
+	}
+}
+
+/*
+ * Check if a slice's range_start matches the start of a range.
+ */
+bool
+ts_dimension_slice_range_start_matches(int64 range_start, const DimensionSliceRange *range)
+{
+	return range->start_strategy == InvalidStrategy ||
+		   int64_cmp_strategy(range_start, range->start_strategy, range->start_value);
+}
+
+/*
+ * Check if a slice's range_end matches the end of a range.
+ */
+bool
+ts_dimension_slice_range_end_matches(int64 range_end, const DimensionSliceRange *range)
+{
+	return range->end_strategy == InvalidStrategy ||
+		   int64_cmp_strategy(range_end,
+							  range->end_strategy,
+							  dimension_slice_range_end_value(range->end_value));
+}
+
+/*
+ * Check if a slice matches a range in the same way as
+ * ts_dimension_slice_scan_range_limit() does, i.e., if range_start compares
+ * to start_value using start_strategy and range_end compares to end_value
+ * using end_strategy.
+ */
+bool
+ts_dimension_slice_matches_range(const DimensionSlice *slice, const DimensionSliceRange *range)
+{
+	return ts_dimension_slice_range_start_matches(slice->fd.range_start, range) &&
+		   ts_dimension_slice_range_end_matches(slice->fd.range_end, range);
+}
+
 static void
 dimension_slice_scan_with_strategies(int32 dimension_id, StrategyNumber start_strategy,
 									 int64 start_value, StrategyNumber end_strategy,
@@ -230,34 +541,11 @@ dimension_slice_scan_with_strategies(int32 dimension_id, StrategyNumber start_st
 
 		Assert(OidIsValid(proc));
 
-		/*
-		 * range_end is stored as exclusive, so add 1 to the value being
-		 * searched. Also avoid overflow
-		 */
-		if (end_value != PG_INT64_MAX)
-		{
-			end_value++;
-
-			/*
-			 * If getting as input INT64_MAX-1, need to remap the incremented
-			 * value back to INT64_MAX-1
-			 */
-			end_value = REMAP_LAST_COORDINATE(end_value);
-		}
-		else
-		{
-			/*
-			 * The point with INT64_MAX gets mapped to INT64_MAX-1 so
-			 * incrementing that gets you to INT_64MAX
-			 */
-			end_value = PG_INT64_MAX;
-		}
-
 		ScanKeyInit(&scankey[nkeys++],
 					Anum_dimension_slice_dimension_id_range_start_range_end_idx_range_end,
 					end_strategy,
 					proc,
-					Int64GetDatum(end_value));
+					Int64GetDatum(dimension_slice_range_end_value(end_value)));
 	}
 
 	dimension_slice_scan_limit_internal(DIMENSION_SLICE_DIMENSION_ID_RANGE_START_RANGE_END_IDX,
@@ -419,6 +707,12 @@ dimension_slice_tuple_delete(TupleInfo *ti, void *data)
 	ts_catalog_delete(ti->scanrel, ti->tuple);
 	ts_catalog_restore_user(&sec_ctx);
 
+	/*
+	 * Slice IDs are never reused, so removing the slice from the shared cache
+	 * only frees up space even if the deletion is rolled back.
+	 */
+	shared_slice_cache_delete(DatumGetInt32(dimension_slice_id));
+
 	return SCAN_CONTINUE;
 }
 
@@ -522,12 +816,22 @@ dimension_slice_tuple_found(TupleInfo *ti, void *data)
 	return SCAN_DONE;
 }
 
+/*
+ * Get a dimension slice by its ID.
+ *
+ * Slices are looked up in the shared slice cache first, and slices read from
+ * the catalog are added to the cache for other backends. This is the only
+ * slice lookup that uses the shared cache.
+ */
 DimensionSlice *
 ts_dimension_slice_scan_by_id(int32 dimension_slice_id, MemoryContext mctx)
 {
-	DimensionSlice *slice = NULL;
+	DimensionSlice *slice = shared_slice_cache_lookup(dimension_slice_id, mctx);
 	ScanKeyData scankey[1];
 
+	if (NULL != slice)
+		return slice;
+
 	ScanKeyInit(&scankey[0],
 				Anum_dimension_slice_id_idx_id,
 				BTEqualStrategyNumber,
@@ -543,6 +847,9 @@ ts_dimension_slice_scan_by_id(int32 dimension_slice_id, MemoryContext mctx)
 										AccessShareLock,
 										mctx);
 
+	if (NULL != slice)
+		shared_slice_cache_add(slice);
+
 	return slice;
 }
 
@@ -10,6 +10,7 @@
 #include <nodes/pg_list.h>
 
 #include "chunk_constraint.h"
+#include "loader/shared_slice_cache.h"
 
 #define DIMENSION_SLICE_MAXVALUE ((int64) PG_INT64_MAX)
 #define DIMENSION_SLICE_MINVALUE ((int64) PG_INT64_MIN)
@@ -39,6 +40,19 @@ typedef struct DimensionSlice
 	void *storage;
 } DimensionSlice;
 
+/*
+ * A range to match slices against, with the same meaning as the arguments of
+ * ts_dimension_slice_scan_range_limit(). An invalid strategy matches any
+ * value.
+ */
+typedef struct DimensionSliceRange
+{
+	StrategyNumber start_strategy;
+	int64 start_value;
+	StrategyNumber end_strategy;
+	int64 end_value;
+} DimensionSliceRange;
+
 typedef struct DimensionVec DimensionVec;
 typedef struct Hypercube Hypercube;
 
@@ -69,6 +83,11 @@ extern void ts_dimension_slice_free(DimensionSlice *slice);
 extern void ts_dimension_slice_insert_multi(DimensionSlice **slice, Size num_slices);
 extern int ts_dimension_slice_cmp(const DimensionSlice *left, const DimensionSlice *right);
 extern int ts_dimension_slice_cmp_coordinate(const DimensionSlice *slice, int64 coord);
+extern bool ts_dimension_slice_range_start_matches(int64 range_start,
+												   const DimensionSliceRange *range);
+extern bool ts_dimension_slice_range_end_matches(int64 range_end, const DimensionSliceRange *range);
+extern bool ts_dimension_slice_matches_range(const DimensionSlice *slice,
+											 const DimensionSliceRange *range);
 
 extern TSDLLEXPORT DimensionSlice *ts_dimension_slice_nth_latest_slice(int32 dimension_id, int n);
 extern TSDLLEXPORT int
@@ -88,4 +107,13 @@ extern TSDLLEXPORT int32 ts_dimension_slice_get_chunkid_to_compress(int32 dimens
 #define dimension_slice_collision_scan(dimension_id, range_start, range_end)                       \
 	ts_dimension_slice_collision_scan_limit(dimension_id, range_start, range_end, 0)
 
+extern TSDLLEXPORT bool ts_shared_slice_cache_find(SharedSliceCache *cache,
+													const SharedSliceCacheKey *key,
+													DimensionSlice *slice);
+extern TSDLLEXPORT void ts_shared_slice_cache_insert(SharedSliceCache *cache,
+													  const SharedSliceCacheKey *key,
+													  const DimensionSlice *slice);
+extern TSDLLEXPORT void ts_shared_slice_cache_remove(SharedSliceCache *cache,
+													  const SharedSliceCacheKey *key);
+
 #endif /* TIMESCALEDB_DIMENSION_SLICE_H */
@@ -0,0 +1,508 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <access/stratnum.h>
+#include <nodes/bitmapset.h>
+#include <utils/hsearch.h>
+#include <utils/memutils.h>
+
+#include "dimension_slice_index.h"
+#include "chunk.h"
+#include "chunk_constraint.h"
+#include "dimension.h"
+#include "dimension_vector.h"
+#include "guc.h"
+
+/*
+ * The dimension slice index is an in-memory index of the chunks of a
+ * hypertable, which is used to find the chunks matching a query's
+ * restrictions without scanning the dimension slice and chunk constraint
+ * catalog tables.
+ *
+ * For each dimension, the index holds the dimension's slices sorted on
+ * range_start together with the largest range_end of all preceding slices
+ * (i.e., an interval index in a sorted array). The slices matching a range
+ * are found with binary searches on both ends, followed by a scan of the
+ * slices in between, which are typically all matching since slices in a
+ * dimension rarely overlap. Each slice has the IDs of the chunks that use it.
+ *
+ * The index of a hypertable is built on first use and cached until the chunk
+ * catalog changes.
+ */
+typedef struct SliceIndexEntry
+{
+	DimensionSlice *slice;
+	/* Largest range_end of this slice and all preceding slices */
+	int64 max_range_end;
+	/* The chunks that have this slice, in chunk constraint scan order */
+	int num_chunks;
+	int32 *chunk_ids;
+} SliceIndexEntry;
+
+typedef struct DimensionSliceIndex
+{
+	int num_entries;
+	SliceIndexEntry *entries;
+} DimensionSliceIndex;
+
+typedef struct SliceIndexChunkEntry
+{
+	int32 chunk_id;
+	SliceIndexChunk *chunk;
+} SliceIndexChunkEntry;
+
+typedef struct SliceIndexRelidEntry
+{
+	Oid table_id;
+	SliceIndexChunk *chunk;
+} SliceIndexRelidEntry;
+
+struct HypertableSliceIndex
+{
+	int32 hypertable_id;
+	MemoryContext mcxt;
+	int num_dimensions;
+	/* Chunk ID to SliceIndexChunk, for all chunks that are not dropped */
+	HTAB *chunks;
+	/* Chunk table relid to SliceIndexChunk */
+	HTAB *chunks_by_relid;
+	DimensionSliceIndex dimensions[FLEXIBLE_ARRAY_MEMBER];
+};
+
+typedef struct SliceIndexCacheEntry
+{
+	Oid hypertable_relid;
+	HypertableSliceIndex *index;
+} SliceIndexCacheEntry;
+
+#define SLICE_INDEX_CHUNK_SIZE(num_dimensions)                                                     \
+	(sizeof(SliceIndexChunk) + sizeof(DimensionSlice *) * (num_dimensions))
+
+static HTAB *slice_index_cache = NULL;
+
+/*
+ * Incremented on every invalidation of the index being built, so that an
+ * index built while an invalidation happened is not cached.
+ */
+static uint64 slice_index_generation = 0;
+static Oid slice_index_building_relid = InvalidOid;
+
+static HTAB *
+slice_index_cache_get(void)
+{
+	HASHCTL hctl = {
+		.keysize = sizeof(Oid),
+		.entrysize = sizeof(SliceIndexCacheEntry),
+		.hcxt = CacheMemoryContext,
+	};
+
+	if (NULL == slice_index_cache)
+		slice_index_cache = hash_create("dimension slice index cache",
+										16,
+										&hctl,
+										HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+	return slice_index_cache;
+}
+
+/*
+ * Invalidate the slice indexes of all hypertables. Called on invalidation of
+ * the whole hypertable cache.
+ */
+void
+ts_hypertable_slice_index_invalidate(void)
+{
+	HASH_SEQ_STATUS status;
+	SliceIndexCacheEntry *entry;
+
+	slice_index_generation++;
+
+	if (NULL == slice_index_cache)
+		return;
+
+	hash_seq_init(&status, slice_index_cache);
+
+	while ((entry = hash_seq_search(&status)) != NULL)
+	{
+		MemoryContextDelete(entry->index->mcxt);
+		hash_search(slice_index_cache, &entry->hypertable_relid, HASH_REMOVE, NULL);
+	}
+}
+
+/*
+ * Invalidate the slice index of a single hypertable, given the relid of the
+ * hypertable. Any other relid is ignored.
+ */
+void
+ts_hypertable_slice_index_invalidate_relid(Oid relid)
+{
+	SliceIndexCacheEntry *entry;
+
+	if (relid == slice_index_building_relid)
+		slice_index_generation++;
+
+	if (NULL == slice_index_cache)
+		return;
+
+	entry = hash_search(slice_index_cache, &relid, HASH_FIND, NULL);
+
+	if (NULL == entry)
+		return;
+
+	MemoryContextDelete(entry->index->mcxt);
+	hash_search(slice_index_cache, &relid, HASH_REMOVE, NULL);
+}
+
+static void
+dimension_slice_index_build(HypertableSliceIndex *index, int dimension_index, Dimension *dim)
+{
+	DimensionSliceIndex *dimindex = &index->dimensions[dimension_index];
+	DimensionVec *vec = ts_dimension_slice_scan_by_dimension(dim->fd.id, 0);
+	int64 max_range_end = DIMENSION_SLICE_MINVALUE;
+	int i;
+
+	dimindex->num_entries = vec->num_slices;
+	dimindex->entries = palloc0(sizeof(SliceIndexEntry) * Max(vec->num_slices, 1));
+
+	for (i = 0; i < vec->num_slices; i++)
+	{
+		SliceIndexEntry *entry = &dimindex->entries[i];
+		List *chunk_ids = NIL;
+		ListCell *lc;
+
+		entry->slice = vec->slices[i];
+		max_range_end = Max(max_range_end, entry->slice->fd.range_end);
+		entry->max_range_end = max_range_end;
+
+		ts_chunk_constraint_scan_by_dimension_slice_to_list(entry->slice,
+															&chunk_ids,
+															CurrentMemoryContext);
+
+		entry->chunk_ids = palloc(sizeof(int32) * Max(list_length(chunk_ids), 1));
+
+		foreach (lc, chunk_ids)
+		{
+			int32 chunk_id = lfirst_int(lc);
+			SliceIndexChunkEntry *chunk_entry =
+				hash_search(index->chunks, &chunk_id, HASH_FIND, NULL);
+
+			entry->chunk_ids[entry->num_chunks++] = chunk_id;
+
+			if (NULL != chunk_entry)
+				chunk_entry->chunk->slices[dimension_index] = entry->slice;
+		}
+
+		list_free(chunk_ids);
+	}
+}
+
+static HypertableSliceIndex *
+slice_index_build(Hypertable *ht, MemoryContext mcxt)
+{
+	Hyperspace *hs = ht->space;
+	MemoryContext old = MemoryContextSwitchTo(mcxt);
+	HypertableSliceIndex *index = palloc0(sizeof(HypertableSliceIndex) +
+										  sizeof(DimensionSliceIndex) * hs->num_dimensions);
+	HASHCTL hctl = {
+		.keysize = sizeof(int32),
+		.entrysize = sizeof(SliceIndexChunkEntry),
+		.hcxt = mcxt,
+	};
+	HASHCTL relid_hctl = {
+		.keysize = sizeof(Oid),
+		.entrysize = sizeof(SliceIndexRelidEntry),
+		.hcxt = mcxt,
+	};
+	int32 *chunk_ids;
+	Oid *relids;
+	int num_chunks;
+	int i;
+
+	index->hypertable_id = ht->fd.id;
+	index->mcxt = mcxt;
+	index->num_dimensions = hs->num_dimensions;
+
+	num_chunks = ts_chunk_get_relids_by_hypertable_id(ht->fd.id, &chunk_ids, &relids);
+	index->chunks = hash_create("dimension slice index chunks",
+								Max(num_chunks, 16),
+								&hctl,
+								HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	index->chunks_by_relid = hash_create("dimension slice index chunk relids",
+										 Max(num_chunks, 16),
+										 &relid_hctl,
+										 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+	for (i = 0; i < num_chunks; i++)
+	{
+		SliceIndexChunkEntry *entry = hash_search(index->chunks, &chunk_ids[i], HASH_ENTER, NULL);
+		SliceIndexRelidEntry *relid_entry =
+			hash_search(index->chunks_by_relid, &relids[i], HASH_ENTER, NULL);
+
+		entry->chunk = palloc0(SLICE_INDEX_CHUNK_SIZE(hs->num_dimensions));
+		entry->chunk->chunk_id = chunk_ids[i];
+		entry->chunk->table_id = relids[i];
+		relid_entry->chunk = entry->chunk;
+	}
+
+	pfree(chunk_ids);
+	pfree(relids);
+
+	for (i = 0; i < hs->num_dimensions; i++)
+		dimension_slice_index_build(index, i, &hs->dimensions[i]);
+
+	MemoryContextSwitchTo(old);
+
+	return index;
+}
+
+/*
+ * Get the slice index of a hypertable, building it if it is not cached.
+ *
+ * Returns NULL if the slice index is disabled. The index is only valid until
+ * the next invalidation, so it should not be used across anything that can
+ * process invalidation messages, such as taking a lock.
+ */
+HypertableSliceIndex *
+ts_hypertable_slice_index_get(Hypertable *ht)
+{
+	HTAB *cache;
+	SliceIndexCacheEntry *entry;
+	HypertableSliceIndex *index;
+	MemoryContext mcxt;
+	uint64 generation;
+
+	if (!ts_guc_enable_slice_index)
+		return NULL;
+
+	cache = slice_index_cache_get();
+	entry = hash_search(cache, &ht->main_table_relid, HASH_FIND, NULL);
+
+	if (NULL != entry)
+		return entry->index;
+
+	generation = slice_index_generation;
+	slice_index_building_relid = ht->main_table_relid;
+	mcxt = AllocSetContextCreate(CacheMemoryContext,
+								 "dimension slice index",
+								 ALLOCSET_DEFAULT_SIZES);
+	index = slice_index_build(ht, mcxt);
+	slice_index_building_relid = InvalidOid;
+
+	/*
+	 * Building the index scans the catalog, which can process invalidations.
+	 * An index built across an invalidation is used for the current query
+	 * only.
+	 */
+	if (generation != slice_index_generation)
+	{
+		MemoryContextSetParent(mcxt, CurrentMemoryContext);
+		return index;
+	}
+
+	entry = hash_search(cache, &ht->main_table_relid, HASH_ENTER, NULL);
+	entry->index = index;
+
+	return index;
+}
+
+/*
+ * Get a chunk in the slice index by the relid of the chunk's table.
+ *
+ * Returns NULL if the relation is not a chunk of the index's hypertable.
+ */
+const SliceIndexChunk *
+ts_hypertable_slice_index_get_chunk(HypertableSliceIndex *index, Oid relid)
+{
+	SliceIndexRelidEntry *entry = hash_search(index->chunks_by_relid, &relid, HASH_FIND, NULL);
+
+	return NULL == entry ? NULL : entry->chunk;
+}
+
+/*
+ * Get the number of chunks in the slice index.
+ */
+int
+ts_hypertable_slice_index_num_chunks(HypertableSliceIndex *index)
+{
+	return hash_get_num_entries(index->chunks);
+}
+
+/*
+ * Add the entries of the slices matching a range to a list of entries,
+ * skipping entries that are already in the list.
+ */
+static List *
+dimension_slice_index_find(DimensionSliceIndex *dimindex, const DimensionSliceRange *range,
+						   List *entries, Bitmapset **found)
+{
+	int lo = 0;
+	int hi = dimindex->num_entries;
+	int i;
+
+	/* Slices are sorted on range_start, so an upper bound matches a prefix */
+	if (range->start_strategy == BTLessStrategyNumber ||
+		range->start_strategy == BTLessEqualStrategyNumber)
+	{
+		int left = 0;
+		int right = hi;
+
+		while (left < right)
+		{
+			int mid = left + (right - left) / 2;
+
+			if (ts_dimension_slice_range_start_matches(dimindex->entries[mid].slice->fd.range_start,
+													   range))
+				left = mid + 1;
+			else
+				right = mid;
+		}
+
+		hi = left;
+	}
+
+	/*
+	 * The largest range_end of the preceding slices never decreases, so a
+	 * lower bound excludes a prefix
+	 */
+	if (range->end_strategy == BTGreaterStrategyNumber ||
+		range->end_strategy == BTGreaterEqualStrategyNumber)
+	{
+		int left = 0;
+		int right = hi;
+
+		while (left < right)
+		{
+			int mid = left + (right - left) / 2;
+
+			if (ts_dimension_slice_range_end_matches(dimindex->entries[mid].max_range_end, range))
+				right = mid;
+			else
+				left = mid + 1;
+		}
+
+		lo = left;
+	}
+
+	for (i = lo; i < hi; i++)
+	{
+		SliceIndexEntry *entry = &dimindex->entries[i];
+
+		if (!ts_dimension_slice_matches_range(entry->slice, range) || bms_is_member(i, *found))
+			continue;
+
+		*found = bms_add_member(*found, i);
+		entries = lappend(entries, entry);
+	}
+
+	return entries;
+}
+
+typedef struct SliceIndexJoinEntry
+{
+	int32 chunk_id;
+	int num_slices;
+} SliceIndexJoinEntry;
+
+/*
+ * Find the chunks that match a set of ranges in each dimension.
+ *
+ * The dimension_ranges array has a list of DimensionSliceRange for each
+ * dimension of the hypertable, and a slice matches a dimension if it matches
+ * any of the ranges in that dimension's list.
+ *
+ * The matching slices are joined on their chunks like the catalog scan in
+ * chunk_find_all() does, with the same kind of hash table and in the same
+ * order, so that the chunks are returned in the same order as the catalog
+ * scan returns them. The returned chunks point into the index.
+ */
+SliceIndexChunk **
+ts_hypertable_slice_index_find_chunks(HypertableSliceIndex *index, List **dimension_ranges,
+									  int *num_chunks)
+{
+	List **dimension_entries = palloc0(sizeof(List *) * index->num_dimensions);
+	HASHCTL hctl = {
+		.keysize = sizeof(int32),
+		.entrysize = sizeof(SliceIndexJoinEntry),
+		.hcxt = CurrentMemoryContext,
+	};
+	HASH_SEQ_STATUS status;
+	SliceIndexJoinEntry *join_entry;
+	SliceIndexChunk **chunks;
+	int num_complete = 0;
+	HTAB *htab;
+	int i;
+
+	*num_chunks = 0;
+
+	for (i = 0; i < index->num_dimensions; i++)
+	{
+		Bitmapset *found = NULL;
+		ListCell *lc;
+
+		foreach (lc, dimension_ranges[i])
+			dimension_entries[i] = dimension_slice_index_find(&index->dimensions[i],
+															  lfirst(lc),
+															  dimension_entries[i],
+															  &found);
+
+		/*
+		 * If there are no matching slices in any single dimension, the result
+		 * will be empty
+		 */
+		if (dimension_entries[i] == NIL)
+			return NULL;
+	}
+
+	htab = hash_create("dimension slice index join",
+					   20,
+					   &hctl,
+					   HASH_ELEM | HASH_CONTEXT | HASH_BLOBS);
+
+	for (i = 0; i < index->num_dimensions; i++)
+	{
+		ListCell *lc;
+
+		foreach (lc, dimension_entries[i])
+		{
+			SliceIndexEntry *entry = lfirst(lc);
+			int j;
+
+			for (j = 0; j < entry->num_chunks; j++)
+			{
+				bool found;
+
+				join_entry = hash_search(htab, &entry->chunk_ids[j], HASH_ENTER, &found);
+
+				if (!found)
+					join_entry->num_slices = 0;
+
+				if (++join_entry->num_slices == index->num_dimensions)
+					num_complete++;
+			}
+		}
+	}
+
+	chunks = palloc(sizeof(SliceIndexChunk *) * Max(num_complete, 1));
+	hash_seq_init(&status, htab);
+
+	while ((join_entry = hash_seq_search(&status)) != NULL)
+	{
+		SliceIndexChunkEntry *chunk_entry;
+
+		if (join_entry->num_slices != index->num_dimensions)
+			continue;
+
+		/* Dropped chunks are not in the index */
+		chunk_entry = hash_search(index->chunks, &join_entry->chunk_id, HASH_FIND, NULL);
+
+		if (NULL != chunk_entry && OidIsValid(chunk_entry->chunk->table_id))
+			chunks[(*num_chunks)++] = chunk_entry->chunk;
+	}
+
+	hash_destroy(htab);
+
+	return chunks;
+}
@@ -0,0 +1,36 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_DIMENSION_SLICE_INDEX_H
+#define TIMESCALEDB_DIMENSION_SLICE_INDEX_H
+
+#include <postgres.h>
+#include <nodes/pg_list.h>
+
+#include "dimension_slice.h"
+#include "hypertable.h"
+
+/* A chunk in the slice index */
+typedef struct SliceIndexChunk
+{
+	int32 chunk_id;
+	Oid table_id;
+	/* The chunk's slices in hyperspace dimension order */
+	const DimensionSlice *slices[FLEXIBLE_ARRAY_MEMBER];
+} SliceIndexChunk;
+
+typedef struct HypertableSliceIndex HypertableSliceIndex;
+
+extern HypertableSliceIndex *ts_hypertable_slice_index_get(Hypertable *ht);
+extern SliceIndexChunk **ts_hypertable_slice_index_find_chunks(HypertableSliceIndex *index,
+															   List **dimension_ranges,
+															   int *num_chunks);
+extern const SliceIndexChunk *ts_hypertable_slice_index_get_chunk(HypertableSliceIndex *index,
+																  Oid relid);
+extern int ts_hypertable_slice_index_num_chunks(HypertableSliceIndex *index);
+extern void ts_hypertable_slice_index_invalidate(void);
+extern void ts_hypertable_slice_index_invalidate_relid(Oid relid);
+
+#endif /* TIMESCALEDB_DIMENSION_SLICE_INDEX_H */
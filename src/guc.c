@@ -42,9 +42,13 @@ bool ts_guc_enable_ordered_append = true;
 bool ts_guc_enable_chunk_append = true;
 bool ts_guc_enable_parallel_chunk_append = true;
 bool ts_guc_enable_runtime_exclusion = true;
+bool ts_guc_enable_chunkwise_aggregation = true;
 bool ts_guc_enable_constraint_exclusion = true;
+bool ts_guc_enable_slice_index = true;
 bool ts_guc_enable_cagg_reorder_groupby = true;
+bool ts_guc_track_planning = false;
 TSDLLEXPORT bool ts_guc_enable_transparent_decompression = true;
+TSDLLEXPORT bool ts_guc_enable_skip_scan = true;
 int ts_guc_max_open_chunks_per_insert = 10;
 int ts_guc_max_cached_chunks_per_hypertable = 10;
 int ts_guc_telemetry_level = TELEMETRY_DEFAULT;
@@ -159,6 +163,18 @@ _guc_init(void)
 							 NULL,
 							 NULL);
 
+	DefineCustomBoolVariable("timescaledb.enable_chunkwise_aggregation",
+							 "Enable chunkwise aggregation",
+							 "Enable partial aggregation per chunk for queries grouping by "
+							 "partitioning columns",
+							 &ts_guc_enable_chunkwise_aggregation,
+							 true,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
 	DefineCustomBoolVariable("timescaledb.enable_constraint_exclusion",
 							 "Enable constraint exclusion",
 							 "Enable planner constraint exclusion",
@@ -170,6 +186,18 @@ _guc_init(void)
 							 NULL,
 							 NULL);
 
+	DefineCustomBoolVariable("timescaledb.enable_slice_index",
+							 "Enable the dimension slice index",
+							 "Enable using a cached in-memory index of dimension slices to find "
+							 "the chunks matching a query",
+							 &ts_guc_enable_slice_index,
+							 true,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
 	DefineCustomBoolVariable("timescaledb.enable_transparent_decompression",
 							 "Enable transparent decompression",
 							 "Enable transparent decompression when querying hypertable",
@@ -181,6 +209,18 @@ _guc_init(void)
 							 NULL,
 							 NULL);
 
+	DefineCustomBoolVariable("timescaledb.enable_skipscan",
+							 "Enable SkipScan",
+							 "Enable SkipScan for DISTINCT queries, which skips over duplicate "
+							 "values in an index instead of reading all index entries",
+							 &ts_guc_enable_skip_scan,
+							 true,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
 	DefineCustomBoolVariable("timescaledb.enable_cagg_reorder_groupby",
 							 "Enable group by reordering",
 							 "Enable group by clause reordering for continuous aggregates",
@@ -192,6 +232,18 @@ _guc_init(void)
 							 NULL,
 							 NULL);
 
+	DefineCustomBoolVariable("timescaledb.track_planning",
+							 "Track planning statistics of hypertables",
+							 "Collect the time spent and the chunks handled when planning queries "
+							 "on hypertables, and show them in EXPLAIN",
+							 &ts_guc_track_planning,
+							 false,
+							 PGC_USERSET,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL);
+
 	DefineCustomIntVariable("timescaledb.max_open_chunks_per_insert",
 							"Maximum open chunks per insert",
 							"Maximum number of open chunk tables per insert",
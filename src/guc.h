@@ -18,9 +18,13 @@ extern bool ts_guc_enable_ordered_append;
 extern bool ts_guc_enable_chunk_append;
 extern bool ts_guc_enable_parallel_chunk_append;
 extern bool ts_guc_enable_runtime_exclusion;
+extern bool ts_guc_enable_chunkwise_aggregation;
 extern bool ts_guc_enable_constraint_exclusion;
+extern bool ts_guc_enable_slice_index;
 extern bool ts_guc_enable_cagg_reorder_groupby;
+extern bool ts_guc_track_planning;
 extern TSDLLEXPORT bool ts_guc_enable_transparent_decompression;
+extern TSDLLEXPORT bool ts_guc_enable_skip_scan;
 extern bool ts_guc_restoring;
 extern int ts_guc_max_open_chunks_per_insert;
 extern int ts_guc_max_cached_chunks_per_hypertable;
@@ -42,6 +42,7 @@
 #include "dimension.h"
 #include "chunk.h"
 #include "chunk_adaptive.h"
+#include "chunk_column_stats.h"
 #include "hypertable_compression.h"
 
 #include "subspace_store.h"
@@ -236,6 +237,7 @@ hypertable_from_tuple(HeapTuple tuple, MemoryContext mctx, TupleDesc desc)
 	h->chunk_cache =
 		ts_subspace_store_init(h->space, mctx, ts_guc_max_cached_chunks_per_hypertable);
 	h->chunk_sizing_func = get_chunk_sizing_func_oid(&h->fd);
+	h->stats_columns = ts_chunk_column_stats_get_columns(h->fd.id, mctx);
 	h->max_ignore_invalidation_older_than = -1;
 
 	return h;
@@ -659,6 +661,8 @@ hypertable_tuple_delete(TupleInfo *ti, void *data)
 	/* remove any associated compression definitions */
 	ts_hypertable_compression_delete_by_hypertable_id(hypertable_id);
 
+	ts_chunk_column_stats_delete_by_hypertable_id(hypertable_id);
+
 	if (!compressed_hypertable_id_isnull)
 	{
 		Hypertable *compressed_hypertable = ts_hypertable_get_by_id(compressed_hypertable_id);
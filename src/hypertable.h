@@ -40,6 +40,8 @@ typedef struct Hypertable
 	Oid chunk_sizing_func;
 	Hyperspace *space;
 	SubspaceStore *chunk_cache;
+	/* Names of the columns with chunk column stats */
+	List *stats_columns;
 	int64 max_ignore_invalidation_older_than; /* lazy-loaded, do not access directly, use
 											ts_hypertable_get_ignore_invalidation_older_than */
 } Hypertable;
@@ -104,8 +106,8 @@ extern TSDLLEXPORT void ts_hypertable_drop(Hypertable *hypertable, DropBehavior
 extern int ts_hypertable_reset_associated_schema_name(const char *associated_schema);
 extern TSDLLEXPORT Oid ts_hypertable_id_to_relid(int32 hypertable_id);
 extern TSDLLEXPORT int32 ts_hypertable_relid_to_id(Oid relid);
-extern Chunk *ts_hypertable_find_chunk_if_exists(Hypertable *h, Point *point);
-extern Chunk *ts_hypertable_get_or_create_chunk(Hypertable *h, Point *point);
+extern TSDLLEXPORT Chunk *ts_hypertable_find_chunk_if_exists(Hypertable *h, Point *point);
+extern TSDLLEXPORT Chunk *ts_hypertable_get_or_create_chunk(Hypertable *h, Point *point);
 extern Oid ts_hypertable_relid(RangeVar *rv);
 extern TSDLLEXPORT bool ts_is_hypertable(Oid relid);
 extern bool ts_hypertable_has_tablespace(Hypertable *ht, Oid tspc_oid);
@@ -38,6 +38,8 @@ hypertable_cache_get_key(CacheQuery *query)
 typedef struct
 {
 	Oid relid;
+	/* Set while the entry is created, which can process invalidations */
+	bool in_progress;
 	Hypertable *hypertable;
 } HypertableCacheEntry;
 
@@ -98,6 +100,9 @@ hypertable_cache_create_entry(Cache *cache, CacheQuery *query)
 	HypertableCacheEntry *cache_entry = query->result;
 	int number_found;
 
+	cache_entry->in_progress = true;
+	cache_entry->hypertable = NULL;
+
 	if (NULL == hq->schema)
 		hq->schema = get_namespace_name(get_rel_namespace(hq->relid));
 
@@ -129,6 +134,8 @@ hypertable_cache_create_entry(Cache *cache, CacheQuery *query)
 			break;
 	}
 
+	cache_entry->in_progress = false;
+
 	return cache_entry->hypertable == NULL ? NULL : cache_entry;
 }
 
@@ -148,11 +155,56 @@ hypertable_cache_missing_error(const Cache *cache, const CacheQuery *query)
 				 errmsg("table \"%s\" is not a hypertable", rel_name)));
 }
 
+/*
+ * Evicted entries remain allocated in the cache's memory context, since they
+ * might still be referenced by someone that pinned the cache. To bound the
+ * memory held by evicted entries, the cache is replaced once too many entries
+ * have been evicted.
+ */
+#define HYPERTABLE_CACHE_MAX_EVICTIONS 256
+
+static int hypertable_cache_evictions = 0;
+
 void
 ts_hypertable_cache_invalidate_callback(void)
 {
 	ts_cache_invalidate(hypertable_cache_current);
 	hypertable_cache_current = hypertable_cache_create();
+	hypertable_cache_evictions = 0;
+}
+
+/*
+ * Evict the entry of a single table from the hypertable cache. Called on
+ * relcache invalidation of any table, so entries for tables that are not
+ * hypertables are also evicted, which is also needed to remove negative
+ * entries when a table becomes a hypertable.
+ */
+void
+ts_hypertable_cache_invalidate_entry(Oid relid)
+{
+	HypertableCacheEntry *entry =
+		hash_search(hypertable_cache_current->htab, &relid, HASH_FIND, NULL);
+	bool is_hypertable;
+
+	if (NULL == entry)
+		return;
+
+	/*
+	 * An entry that is being created is still written to after this, so it
+	 * cannot be removed. Replace the whole cache instead, which keeps the
+	 * entry allocated for the caller, who has pinned the cache.
+	 */
+	if (entry->in_progress)
+	{
+		ts_hypertable_cache_invalidate_callback();
+		return;
+	}
+
+	is_hypertable = entry->hypertable != NULL;
+	ts_cache_remove(hypertable_cache_current, &relid);
+
+	if (is_hypertable && ++hypertable_cache_evictions > HYPERTABLE_CACHE_MAX_EVICTIONS)
+		ts_hypertable_cache_invalidate_callback();
 }
 
 /* Get hypertable cache entry. If the entry is not in the cache, add it. */
@@ -23,6 +23,7 @@
 #include "chunk.h"
 #include "hypercube.h"
 #include "dimension_vector.h"
+#include "dimension_slice_index.h"
 #include "partitioning.h"
 
 typedef struct DimensionRestrictInfo
@@ -283,6 +284,69 @@ dimension_restrict_info_closed_slices(DimensionRestrictInfoClosed *dri)
 											   0);
 }
 
+static DimensionSliceRange *
+dimension_slice_range_create(StrategyNumber start_strategy, int64 start_value,
+							 StrategyNumber end_strategy, int64 end_value)
+{
+	DimensionSliceRange *range = palloc(sizeof(DimensionSliceRange));
+
+	range->start_strategy = start_strategy;
+	range->start_value = start_value;
+	range->end_strategy = end_strategy;
+	range->end_value = end_value;
+
+	return range;
+}
+
+static List *
+dimension_restrict_info_closed_ranges(DimensionRestrictInfoClosed *dri)
+{
+	List *ranges = NIL;
+	ListCell *cell;
+
+	if (dri->strategy != BTEqualStrategyNumber)
+		return list_make1(
+			dimension_slice_range_create(InvalidStrategy, -1, InvalidStrategy, -1));
+
+	foreach (cell, dri->partitions)
+	{
+		int32 partition = lfirst_int(cell);
+
+		ranges = lappend(ranges,
+						 dimension_slice_range_create(BTLessEqualStrategyNumber,
+													  partition,
+													  BTGreaterEqualStrategyNumber,
+													  partition));
+	}
+
+	return ranges;
+}
+
+/*
+ * Get the ranges of slices matching the restrictions of a dimension, in the
+ * same way as dimension_restrict_info_slices() scans for them.
+ */
+static List *
+dimension_restrict_info_ranges(DimensionRestrictInfo *dri)
+{
+	DimensionRestrictInfoOpen *open;
+
+	switch (dri->dimension->type)
+	{
+		case DIMENSION_TYPE_OPEN:
+			open = (DimensionRestrictInfoOpen *) dri;
+			return list_make1(dimension_slice_range_create(open->upper_strategy,
+														   open->upper_bound,
+														   open->lower_strategy,
+														   open->lower_bound));
+		case DIMENSION_TYPE_CLOSED:
+			return dimension_restrict_info_closed_ranges((DimensionRestrictInfoClosed *) dri);
+		default:
+			elog(ERROR, "unknown dimension type");
+			return NIL;
+	}
+}
+
 static DimensionVec *
 dimension_restrict_info_slices(DimensionRestrictInfo *dri)
 {
@@ -552,14 +616,66 @@ gather_restriction_dimension_vectors(HypertableRestrictInfo *hri)
 	return dimension_vecs;
 }
 
+/*
+ * Find the chunks matching the restrictions in the hypertable's dimension
+ * slice index.
+ */
+static SliceIndexChunk **
+hypertable_restrict_info_find_in_slice_index(HypertableRestrictInfo *hri,
+											 HypertableSliceIndex *index, int *num_chunks)
+{
+	List **dimension_ranges = palloc(sizeof(List *) * hri->num_dimensions);
+	int i;
+
+	for (i = 0; i < hri->num_dimensions; i++)
+		dimension_ranges[i] = dimension_restrict_info_ranges(hri->dimension_restriction[i]);
+
+	return ts_hypertable_slice_index_find_chunks(index, dimension_ranges, num_chunks);
+}
+
+static void
+lock_chunk_oids(List *chunk_oids, LOCKMODE lockmode)
+{
+	ListCell *lc;
+
+	if (lockmode == NoLock)
+		return;
+
+	foreach (lc, chunk_oids)
+		LockRelationOid(lfirst_oid(lc), lockmode);
+}
+
 List *
 ts_hypertable_restrict_info_get_chunk_oids(HypertableRestrictInfo *hri, Hypertable *ht,
 										   LOCKMODE lockmode)
 {
-	List *dimension_vecs = gather_restriction_dimension_vectors(hri);
+	HypertableSliceIndex *index = ts_hypertable_slice_index_get(ht);
+	List *dimension_vecs;
 
 	Assert(hri->num_dimensions == ht->space->num_dimensions);
 
+	if (NULL != index)
+	{
+		int num_chunks;
+		SliceIndexChunk **chunks =
+			hypertable_restrict_info_find_in_slice_index(hri, index, &num_chunks);
+		List *chunk_oids = NIL;
+		int i;
+
+		for (i = 0; i < num_chunks; i++)
+			chunk_oids = lappend_oid(chunk_oids, chunks[i]->table_id);
+
+		/*
+		 * Lock the chunks only when done with the index, since taking a lock
+		 * can invalidate it
+		 */
+		lock_chunk_oids(chunk_oids, lockmode);
+
+		return chunk_oids;
+	}
+
+	dimension_vecs = gather_restriction_dimension_vectors(hri);
+
 	return ts_chunk_find_all_oids(ht->space, dimension_vecs, lockmode);
 }
 
@@ -574,17 +690,27 @@ hypertable_restrict_info_get_chunks(HypertableRestrictInfo *hri, Hypertable *ht,
 	return ts_chunk_find_all(ht->space, dimension_vecs, lockmode, num_chunks);
 }
 
+/*
+ * A chunk to order on its slice in the first dimension
+ */
+typedef struct OrderedChunk
+{
+	DimensionSlice slice;
+	int32 chunk_id;
+	Oid table_id;
+} OrderedChunk;
+
 /*
  * Compare two chunks along first dimension and chunk ID (in that priority and
  * order).
  */
 static int
-chunk_cmp_impl(const Chunk *c1, const Chunk *c2)
+chunk_cmp_impl(const OrderedChunk *c1, const OrderedChunk *c2)
 {
-	int cmp = ts_dimension_slice_cmp(c1->cube->slices[0], c2->cube->slices[0]);
+	int cmp = ts_dimension_slice_cmp(&c1->slice, &c2->slice);
 
 	if (cmp == 0)
-		cmp = VALUE_CMP(c1->fd.id, c2->fd.id);
+		cmp = VALUE_CMP(c1->chunk_id, c2->chunk_id);
 
 	return cmp;
 }
@@ -592,13 +718,60 @@ chunk_cmp_impl(const Chunk *c1, const Chunk *c2)
 static int
 chunk_cmp(const void *c1, const void *c2)
 {
-	return chunk_cmp_impl(*((const Chunk **) c1), *((const Chunk **) c2));
+	return chunk_cmp_impl((const OrderedChunk *) c1, (const OrderedChunk *) c2);
 }
 
 static int
 chunk_cmp_reverse(const void *c1, const void *c2)
 {
-	return chunk_cmp_impl(*((const Chunk **) c2), *((const Chunk **) c1));
+	return chunk_cmp_impl((const OrderedChunk *) c2, (const OrderedChunk *) c1);
+}
+
+static OrderedChunk *
+hypertable_restrict_info_get_ordered_chunks(HypertableRestrictInfo *hri, Hypertable *ht,
+											LOCKMODE lockmode, unsigned int *num_chunks)
+{
+	HypertableSliceIndex *index = ts_hypertable_slice_index_get(ht);
+	OrderedChunk *ordered;
+	unsigned int i;
+
+	if (NULL != index)
+	{
+		int num_found;
+		SliceIndexChunk **chunks =
+			hypertable_restrict_info_find_in_slice_index(hri, index, &num_found);
+		List *chunk_oids = NIL;
+
+		*num_chunks = num_found;
+		ordered = palloc(sizeof(OrderedChunk) * Max(num_found, 1));
+
+		for (i = 0; i < *num_chunks; i++)
+		{
+			ordered[i].slice = *chunks[i]->slices[0];
+			ordered[i].chunk_id = chunks[i]->chunk_id;
+			ordered[i].table_id = chunks[i]->table_id;
+			chunk_oids = lappend_oid(chunk_oids, chunks[i]->table_id);
+		}
+
+		/* Lock the chunks only when done with the index */
+		lock_chunk_oids(chunk_oids, lockmode);
+		list_free(chunk_oids);
+	}
+	else
+	{
+		Chunk **chunks = hypertable_restrict_info_get_chunks(hri, ht, lockmode, num_chunks);
+
+		ordered = palloc(sizeof(OrderedChunk) * Max(*num_chunks, 1));
+
+		for (i = 0; i < *num_chunks; i++)
+		{
+			ordered[i].slice = *chunks[i]->cube->slices[0];
+			ordered[i].chunk_id = chunks[i]->fd.id;
+			ordered[i].table_id = chunks[i]->table_id;
+		}
+	}
+
+	return ordered;
 }
 
 /*
@@ -615,7 +788,8 @@ ts_hypertable_restrict_info_get_chunk_oids_ordered(HypertableRestrictInfo *hri,
 												   bool reverse)
 {
 	unsigned num_chunks;
-	Chunk **chunks = hypertable_restrict_info_get_chunks(hri, ht, lockmode, &num_chunks);
+	OrderedChunk *chunks =
+		hypertable_restrict_info_get_ordered_chunks(hri, ht, lockmode, &num_chunks);
 	List *chunk_oids = NIL;
 	List *slot_chunk_oids = NIL;
 	DimensionSlice *slice = NULL;
@@ -628,15 +802,15 @@ ts_hypertable_restrict_info_get_chunk_oids_ordered(HypertableRestrictInfo *hri,
 	Assert(IS_OPEN_DIMENSION(&ht->space->dimensions[0]));
 
 	if (reverse)
-		qsort(chunks, num_chunks, sizeof(Chunk *), chunk_cmp_reverse);
+		qsort(chunks, num_chunks, sizeof(OrderedChunk), chunk_cmp_reverse);
 	else
-		qsort(chunks, num_chunks, sizeof(Chunk *), chunk_cmp);
+		qsort(chunks, num_chunks, sizeof(OrderedChunk), chunk_cmp);
 
 	for (i = 0; i < num_chunks; i++)
 	{
-		Chunk *chunk = chunks[i];
+		OrderedChunk *chunk = &chunks[i];
 
-		if (NULL != slice && ts_dimension_slice_cmp(slice, chunk->cube->slices[0]) != 0 &&
+		if (NULL != slice && ts_dimension_slice_cmp(slice, &chunk->slice) != 0 &&
 			slot_chunk_oids != NIL)
 		{
 			*nested_oids = lappend(*nested_oids, slot_chunk_oids);
@@ -647,7 +821,7 @@ ts_hypertable_restrict_info_get_chunk_oids_ordered(HypertableRestrictInfo *hri,
 			slot_chunk_oids = lappend_oid(slot_chunk_oids, chunk->table_id);
 
 		chunk_oids = lappend_oid(chunk_oids, chunk->table_id);
-		slice = chunk->cube->slices[0];
+		slice = &chunk->slice;
 	}
 
 	if (slot_chunk_oids != NIL)
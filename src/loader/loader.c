@@ -33,6 +33,7 @@
 #include "loader/bgw_launcher.h"
 #include "loader/bgw_message_queue.h"
 #include "loader/lwlocks.h"
+#include "loader/shared_slice_cache.h"
 
 /*
  * Loading process:
@@ -478,6 +479,7 @@ timescale_shmem_startup_hook(void)
 	ts_bgw_counter_shmem_startup();
 	ts_bgw_message_queue_shmem_startup();
 	ts_lwlocks_shmem_startup();
+	ts_shared_slice_cache_shmem_startup();
 }
 
 static void
@@ -502,6 +504,7 @@ _PG_init(void)
 	ts_bgw_counter_shmem_alloc();
 	ts_bgw_message_queue_alloc();
 	ts_lwlocks_shmem_alloc();
+	ts_shared_slice_cache_shmem_alloc();
 	ts_bgw_cluster_launcher_register();
 	ts_bgw_counter_setup_gucs();
 	ts_bgw_interface_register_api_version();
@@ -0,0 +1,110 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <fmgr.h>
+#include <miscadmin.h>
+#include <storage/lwlock.h>
+#include <storage/shmem.h>
+#include <utils/guc.h>
+
+#include "loader/shared_slice_cache.h"
+
+#define SHARED_SLICE_CACHE_SHMEM_NAME "ts_shared_slice_cache"
+#define SHARED_SLICE_CACHE_LWLOCK_TRANCHE_NAME "ts_shared_slice_cache_lwlock_tranche"
+
+/*
+ * The cache lets backends share dimension slices that were looked up by ID,
+ * which is how the hypercube of a chunk is built from its constraints. Only
+ * these lookups use the cache. Scans of slices by dimension or range, as well
+ * as the chunk and chunk constraint scans, still read the catalog in every
+ * backend. Readers take the lock of the entry's partition in shared mode, so
+ * lookups only contend with backends adding or removing entries in the same
+ * partition.
+ *
+ * Like the other shared state, the cache has to be set up by the loader
+ * since shared memory can only be requested by a library in
+ * shared_preload_libraries. The cache has a fixed number of entries, and
+ * entries that were not used recently are replaced by new ones.
+ */
+static int ts_guc_shared_slice_cache_size = 32768;
+
+static SharedSliceCache shared_slice_cache = {
+	.version = SHARED_SLICE_CACHE_VERSION,
+};
+
+static int32
+shared_slice_cache_num_sets(void)
+{
+	return (ts_guc_shared_slice_cache_size + SHARED_SLICE_CACHE_SET_SIZE - 1) /
+		   SHARED_SLICE_CACHE_SET_SIZE;
+}
+
+static Size
+shared_slice_cache_entries_size(void)
+{
+	return mul_size(mul_size(shared_slice_cache_num_sets(), SHARED_SLICE_CACHE_SET_SIZE),
+					sizeof(SharedSliceCacheEntry));
+}
+
+static void
+shared_slice_cache_setup_gucs(void)
+{
+	DefineCustomIntVariable("timescaledb.shared_slice_cache_size",
+							"Maximum number of dimension slices in the shared slice cache",
+							"Dimension slices looked up by ID are cached in shared memory "
+							"for all backends. Set to 0 to disable the cache",
+							&ts_guc_shared_slice_cache_size,
+							ts_guc_shared_slice_cache_size,
+							0,
+							INT_MAX / 2,
+							PGC_POSTMASTER,
+							0,
+							NULL,
+							NULL,
+							NULL);
+}
+
+void
+ts_shared_slice_cache_shmem_startup()
+{
+	SharedSliceCache **cache_pointer;
+	bool found;
+	int i;
+
+	if (ts_guc_shared_slice_cache_size <= 0)
+		return;
+
+	shared_slice_cache.num_sets = shared_slice_cache_num_sets();
+
+	LWLockAcquire(AddinShmemInitLock, LW_EXCLUSIVE);
+	shared_slice_cache.entries =
+		ShmemInitStruct(SHARED_SLICE_CACHE_SHMEM_NAME, shared_slice_cache_entries_size(), &found);
+	if (!found)
+	{
+		memset(shared_slice_cache.entries, 0, shared_slice_cache_entries_size());
+
+		for (i = 0; i < shared_slice_cache.num_sets * SHARED_SLICE_CACHE_SET_SIZE; i++)
+			pg_atomic_init_u32(&shared_slice_cache.entries[i].referenced, 0);
+	}
+	shared_slice_cache.locks = GetNamedLWLockTranche(SHARED_SLICE_CACHE_LWLOCK_TRANCHE_NAME);
+	LWLockRelease(AddinShmemInitLock);
+
+	cache_pointer = (SharedSliceCache **) find_rendezvous_variable(RENDEZVOUS_SHARED_SLICE_CACHE);
+	*cache_pointer = &shared_slice_cache;
+}
+
+void
+ts_shared_slice_cache_shmem_alloc()
+{
+	shared_slice_cache_setup_gucs();
+
+	if (ts_guc_shared_slice_cache_size <= 0)
+		return;
+
+	RequestNamedLWLockTranche(SHARED_SLICE_CACHE_LWLOCK_TRANCHE_NAME,
+							  SHARED_SLICE_CACHE_NUM_PARTITIONS);
+	RequestAddinShmemSpace(shared_slice_cache_entries_size());
+}
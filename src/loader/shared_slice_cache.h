@@ -0,0 +1,70 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_LOADER_SHARED_SLICE_CACHE_H
+#define TIMESCALEDB_LOADER_SHARED_SLICE_CACHE_H
+
+#include <postgres.h>
+#include <port/atomics.h>
+#include <storage/lwlock.h>
+
+#define RENDEZVOUS_SHARED_SLICE_CACHE "ts_shared_slice_cache"
+
+/*
+ * The layout of the cache is shared between the loader and all versions of
+ * the extension, so any change to the structs below needs a new version.
+ */
+#define SHARED_SLICE_CACHE_VERSION 2
+#define SHARED_SLICE_CACHE_NUM_PARTITIONS 16
+
+/*
+ * The cache is set associative: a key can only be stored in the entries of
+ * one set, and a new entry replaces one of them when the set is full.
+ */
+#define SHARED_SLICE_CACHE_SET_SIZE 4
+
+/*
+ * Dimension slices are never updated and their IDs are never reused within
+ * the catalog of one extension, so a cached slice is valid for as long as the
+ * slice exists. Since slice IDs start over when the extension is recreated,
+ * the key includes the generation of the extension, i.e., the dimension slice
+ * catalog table and the transaction that created it. Entries of dropped
+ * databases and extensions can then never match again and are eventually
+ * replaced.
+ */
+typedef struct SharedSliceCacheKey
+{
+	Oid dbid;
+	Oid catalog_relid;
+	TransactionId catalog_xmin;
+	int32 slice_id;
+} SharedSliceCacheKey;
+
+typedef struct SharedSliceCacheEntry
+{
+	SharedSliceCacheKey key;
+	bool valid;
+	/* Set on every lookup and cleared when looking for an entry to replace */
+	pg_atomic_uint32 referenced;
+	int32 dimension_id;
+	int64 range_start;
+	int64 range_end;
+} SharedSliceCacheEntry;
+
+typedef struct SharedSliceCache
+{
+	int32 version;
+	int32 num_sets;
+	SharedSliceCacheEntry *entries; /* num_sets * SHARED_SLICE_CACHE_SET_SIZE entries */
+	LWLockPadded *locks;			/* One lock per partition of the sets */
+} SharedSliceCache;
+
+#define SHARED_SLICE_CACHE_PARTITION_LOCK(cache, set)                                              \
+	(&(cache)->locks[(set) % SHARED_SLICE_CACHE_NUM_PARTITIONS].lock)
+
+void ts_shared_slice_cache_shmem_startup(void);
+void ts_shared_slice_cache_shmem_alloc(void);
+
+#endif /* TIMESCALEDB_LOADER_SHARED_SLICE_CACHE_H */
@@ -17,6 +17,7 @@
 #include <utils/acl.h>
 #include <utils/rangetypes.h>
 #include <utils/memutils.h>
+#include <utils/uuid.h>
 #include <catalog/namespace.h>
 #include <catalog/pg_type.h>
 #include <access/hash.h>
@@ -169,6 +170,94 @@ find_text_coercion_func(Oid type)
 
 #define TYPECACHE_HASH_FLAGS (TYPECACHE_HASH_PROC | TYPECACHE_HASH_PROC_FINFO)
 
+/*
+ * Inlined versions of the default partitioning function for common column
+ * types. They compute the same values as get_partition_hash() does through
+ * the type's hash function, without the function call overhead on every
+ * inserted tuple.
+ */
+#define PARTITION_HASH(hash) ((int32)(DatumGetUInt32(hash) & 0x7fffffff))
+
+static int32
+partition_hash_int4(Datum value)
+{
+	/* Same as hashint4() */
+	return PARTITION_HASH(hash_uint32((uint32) DatumGetInt32(value)));
+}
+
+static int32
+partition_hash_int8(Datum value)
+{
+	/* Same as hashint8(), which makes int8 values hash like int4 values */
+	int64 val = DatumGetInt64(value);
+	uint32 lohalf = (uint32) val;
+	uint32 hihalf = (uint32)(val >> 32);
+
+	lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+
+	return PARTITION_HASH(hash_uint32(lohalf));
+}
+
+static int32
+partition_hash_text(Datum value)
+{
+	/* Same as hashtext() with a deterministic collation */
+	text *data = DatumGetTextPP(value);
+	int32 res =
+		PARTITION_HASH(hash_any((unsigned char *) VARDATA_ANY(data), VARSIZE_ANY_EXHDR(data)));
+
+	if ((Pointer) data != DatumGetPointer(value))
+		pfree(data);
+
+	return res;
+}
+
+static int32
+partition_hash_uuid(Datum value)
+{
+	/* Same as uuid_hash() */
+	pg_uuid_t *uuid = DatumGetUUIDP(value);
+
+	return PARTITION_HASH(hash_any(uuid->data, UUID_LEN));
+}
+
+/*
+ * Get the fast path for a closed dimension's partitioning function, if the
+ * function is the default one and there is a fast path for the column type.
+ */
+static partitioning_hash_func
+partitioning_func_get_hash_fastpath(const char *schema, const char *partfunc, Oid relid,
+									AttrNumber attnum)
+{
+	Oid columntype;
+	int32 typmod;
+	Oid collation;
+
+	if (!ts_partitioning_func_is_closed_default(schema, partfunc))
+		return NULL;
+
+	get_atttypetypmodcoll(relid, attnum, &columntype, &typmod, &collation);
+
+	switch (columntype)
+	{
+		case INT4OID:
+			return partition_hash_int4;
+		case INT8OID:
+			return partition_hash_int8;
+		case TEXTOID:
+#if PG12_GE
+			/* Text hashing depends on the collation if it is nondeterministic */
+			if (OidIsValid(collation) && !get_collation_isdeterministic(collation))
+				return NULL;
+#endif
+			return partition_hash_text;
+		case UUIDOID:
+			return partition_hash_uuid;
+		default:
+			return NULL;
+	}
+}
+
 PartitioningInfo *
 ts_partitioning_info_create(const char *schema, const char *partfunc, const char *partcol,
 							DimensionType dimtype, Oid relid)
@@ -209,6 +298,10 @@ ts_partitioning_info_create(const char *schema, const char *partfunc, const char
 
 	partitioning_func_set_func_fmgr(&pinfo->partfunc, columntype, dimtype);
 
+	if (dimtype == DIMENSION_TYPE_CLOSED)
+		pinfo->partfunc.hash_fastpath =
+			partitioning_func_get_hash_fastpath(schema, partfunc, relid, pinfo->column_attnum);
+
 	/*
 	 * Prepare a function expression for this function. The partition hash
 	 * function needs this to be able to resolve the type of the value to be
@@ -242,6 +335,9 @@ ts_partitioning_func_apply(PartitioningInfo *pinfo, Oid collation, Datum value)
 	LOCAL_FCINFO(fcinfo, 1);
 	Datum result;
 
+	if (NULL != pinfo->partfunc.hash_fastpath)
+		return Int32GetDatum(pinfo->partfunc.hash_fastpath(value));
+
 	InitFunctionCallInfoData(*fcinfo, &pinfo->partfunc.func_fmgr, 1, collation, NULL, NULL);
 
 	FC_SET_ARG(fcinfo, 0, value);
@@ -277,6 +373,62 @@ ts_partitioning_func_apply_slot(PartitioningInfo *pinfo, TupleTableSlot *slot, b
 	return ts_partitioning_func_apply(pinfo, collation, value);
 }
 
+/*
+ * Apply a dimension's partitioning function to the partitioning column of a
+ * set of slots. Like ts_partitioning_func_apply_slot(), the slots must belong
+ * to the root table. The function call info is set up only once for all
+ * slots, unless there is a fast path for the column type.
+ */
+void
+ts_partitioning_func_apply_slots(PartitioningInfo *pinfo, TupleTableSlot **slots, int num_slots,
+								 Datum *values, bool *isnull)
+{
+	LOCAL_FCINFO(fcinfo, 1);
+	Oid collation;
+	int i;
+
+	if (num_slots == 0)
+		return;
+
+	collation =
+		TupleDescAttr(slots[0]->tts_tupleDescriptor, pinfo->column_attnum - 1)->attcollation;
+
+	if (NULL == pinfo->partfunc.hash_fastpath)
+		InitFunctionCallInfoData(*fcinfo,
+								 &pinfo->partfunc.func_fmgr,
+								 1,
+								 collation,
+								 NULL,
+								 NULL);
+
+	for (i = 0; i < num_slots; i++)
+	{
+		Datum value = slot_getattr(slots[i], pinfo->column_attnum, &isnull[i]);
+
+		if (isnull[i])
+		{
+			values[i] = 0;
+			continue;
+		}
+
+		if (NULL != pinfo->partfunc.hash_fastpath)
+		{
+			values[i] = Int32GetDatum(pinfo->partfunc.hash_fastpath(value));
+			continue;
+		}
+
+		FC_SET_ARG(fcinfo, 0, value);
+		fcinfo->isnull = false;
+		values[i] = FunctionCallInvoke(fcinfo);
+
+		if (fcinfo->isnull)
+			elog(ERROR,
+				 "partitioning function \"%s.%s\" returned NULL",
+				 pinfo->partfunc.schema,
+				 pinfo->partfunc.name);
+	}
+}
+
 /*
  * Resolve the type of the argument passed to a function.
  *
@@ -23,6 +23,12 @@
 #define DEFAULT_PARTITIONING_FUNC_SCHEMA INTERNAL_SCHEMA_NAME
 #define DEFAULT_PARTITIONING_FUNC_NAME "get_partition_hash"
 
+/*
+ * Specialized version of the default partitioning function for a particular
+ * column type, which computes the same value without the function manager.
+ */
+typedef int32 (*partitioning_hash_func)(Datum value);
+
 typedef struct PartitioningFunc
 {
 	char schema[NAMEDATALEN];
@@ -34,6 +40,9 @@ typedef struct PartitioningFunc
 	 * partitioning column's text representation.
 	 */
 	FmgrInfo func_fmgr;
+
+	/* Fast path for the partitioning function, or NULL if there is none */
+	partitioning_hash_func hash_fastpath;
 } PartitioningFunc;
 
 typedef struct PartitioningInfo
@@ -58,5 +67,7 @@ extern TSDLLEXPORT Datum ts_partitioning_func_apply(PartitioningInfo *pinfo, Oid
  */
 extern TSDLLEXPORT Datum ts_partitioning_func_apply_slot(PartitioningInfo *pinfo,
 														 TupleTableSlot *slot, bool *isnull);
+extern void ts_partitioning_func_apply_slots(PartitioningInfo *pinfo, TupleTableSlot **slots,
+											 int num_slots, Datum *values, bool *isnull);
 
 #endif /* TIMESCALEDB_PARTITIONING_H */
@@ -0,0 +1,481 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <miscadmin.h>
+#include <nodes/nodeFuncs.h>
+#include <optimizer/clauses.h>
+#include <optimizer/pathnode.h>
+#include <optimizer/paths.h>
+#include <optimizer/prep.h>
+#include <optimizer/tlist.h>
+#include <utils/selfuncs.h>
+
+#include "compat.h"
+#if PG12_GE
+#include <optimizer/appendinfo.h>
+#endif
+
+#include "compat-msvc-enter.h"
+#include <optimizer/cost.h>
+#include "compat-msvc-exit.h"
+
+#include "plan_chunkwise_agg.h"
+#include "chunk_append/chunk_append.h"
+#include "dimension.h"
+#include "estimate.h"
+#include "func_cache.h"
+#include "import/planner.h"
+#include "utils.h"
+
+/*
+ * Check if a grouping expression is a partitioning column of the hypertable
+ * or a bucketing function, like time_bucket, on the time column. With
+ * open_only set, only the time column and buckets on it qualify.
+ */
+static bool
+is_partitioning_group_expr(Node *expr, Index relid, Hyperspace *space, bool open_only)
+{
+	bool bucketed = false;
+	Var *var;
+	int i;
+
+	if (IsA(expr, FuncExpr))
+	{
+		FuncExpr *func = castNode(FuncExpr, expr);
+
+		if (ts_func_cache_get_bucketing_func(func->funcid) == NULL || list_length(func->args) < 2)
+			return false;
+
+		expr = lsecond(func->args);
+		bucketed = true;
+	}
+
+	if (!IsA(expr, Var))
+		return false;
+
+	var = castNode(Var, expr);
+
+	if (var->varno != relid || var->varlevelsup != 0)
+		return false;
+
+	for (i = 0; i < space->num_dimensions; i++)
+	{
+		Dimension *dim = &space->dimensions[i];
+
+		if (dim->column_attno == var->varattno && (!(bucketed || open_only) || IS_OPEN_DIMENSION(dim)))
+			return true;
+	}
+
+	return false;
+}
+
+static bool
+group_by_partitioning_column(PlannerInfo *root, Index relid, Hyperspace *space, bool open_only)
+{
+	List *group_exprs =
+		get_sortgrouplist_exprs(root->parse->groupClause, root->parse->targetList);
+	ListCell *lc;
+
+	foreach (lc, group_exprs)
+	{
+		if (is_partitioning_group_expr(lfirst(lc), relid, space, open_only))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * GapFill paths are created on top of the aggregate paths before we get here,
+ * so aggregate paths added for gapfill queries would not be gapfilled.
+ */
+static bool
+contain_gapfill_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, FuncExpr))
+	{
+		FuncInfo *finfo = ts_func_cache_get(castNode(FuncExpr, node)->funcid);
+
+		if (finfo != NULL && strcmp(finfo->funcname, "time_bucket_gapfill") == 0)
+			return true;
+	}
+
+	return expression_tree_walker(node, contain_gapfill_walker, context);
+}
+
+/*
+ * Get the chunk paths below an unordered Append or ChunkAppend path.
+ */
+static List *
+get_chunk_subpaths(Path *path)
+{
+	List *subpaths;
+	ListCell *lc;
+
+	if (path->pathkeys != NIL || path->param_info != NULL)
+		return NIL;
+
+	if (IsA(path, AppendPath))
+		subpaths = castNode(AppendPath, path)->subpaths;
+	else if (ts_is_chunk_append_path(path))
+		subpaths = castNode(CustomPath, path)->custom_paths;
+	else
+		return NIL;
+
+	foreach (lc, subpaths)
+	{
+		Path *subpath = lfirst(lc);
+
+		if (subpath->parent->reloptkind != RELOPT_OTHER_MEMBER_REL || subpath->param_info != NULL)
+			return NIL;
+	}
+
+	return subpaths;
+}
+
+static PathTarget *
+translate_pathtarget(PlannerInfo *root, PathTarget *target, AppendRelInfo *appinfo)
+{
+	PathTarget *chunk_target = copy_pathtarget(target);
+
+	chunk_target->exprs =
+		(List *) adjust_appendrel_attrs_compat(root, (Node *) target->exprs, appinfo);
+
+	return chunk_target;
+}
+
+/*
+ * Create the partial aggregate path of a chunk. The chunk scan computes the
+ * grouping expressions, so the scan/join target of the hypertable is
+ * translated to the chunk and applied first.
+ */
+static Path *
+create_chunk_agg_path(PlannerInfo *root, Path *subpath, PathTarget *scanjoin_target,
+					  PathTarget *partial_target, const AggClauseCosts *agg_partial_costs,
+					  double d_num_groups, bool can_hash, bool can_sort)
+{
+	Query *parse = root->parse;
+	RelOptInfo *chunk_rel = subpath->parent;
+	AppendRelInfo *appinfo = ts_get_appendrelinfo(root, chunk_rel->relid, false);
+	PathTarget *target = translate_pathtarget(root, partial_target, appinfo);
+	bool is_sorted = pathkeys_contained_in(root->group_pathkeys, subpath->pathkeys);
+	Path *path;
+
+	path = (Path *) create_projection_path(root,
+										   chunk_rel,
+										   subpath,
+										   translate_pathtarget(root, scanjoin_target, appinfo));
+
+	if (can_hash && enable_hashagg && !(can_sort && is_sorted) &&
+		ts_estimate_hashagg_tablesize(path, agg_partial_costs, d_num_groups) <
+			work_mem * UINT64CONST(1024))
+		return (Path *) create_agg_path(root,
+										chunk_rel,
+										path,
+										target,
+										AGG_HASHED,
+										AGGSPLIT_INITIAL_SERIAL,
+										parse->groupClause,
+										NIL,
+										agg_partial_costs,
+										d_num_groups);
+
+	if (!can_sort)
+		return NULL;
+
+	if (!is_sorted)
+		path = (Path *) create_sort_path(root, chunk_rel, path, root->group_pathkeys, -1.0);
+
+	return (Path *) create_agg_path(root,
+									chunk_rel,
+									path,
+									target,
+									AGG_SORTED,
+									AGGSPLIT_INITIAL_SERIAL,
+									parse->groupClause,
+									NIL,
+									agg_partial_costs,
+									d_num_groups);
+}
+
+/* Compute the costs the same way as ts_chunk_append_path_create() */
+static void
+append_set_costs(Path *path, List *subpaths)
+{
+	ListCell *lc;
+
+	path->rows = 0;
+	path->startup_cost = 0;
+	path->total_cost = 0;
+
+	foreach (lc, subpaths)
+	{
+		Path *subpath = lfirst(lc);
+
+		path->rows += subpath->rows;
+		path->total_cost += subpath->total_cost;
+	}
+
+	if (subpaths != NIL)
+		path->startup_cost = ((Path *) linitial(subpaths))->startup_cost;
+}
+
+/*
+ * Create a copy of an Append or ChunkAppend path over the chunks of the
+ * hypertable with a partial aggregate below it for every chunk. Returns NULL
+ * if the path cannot be aggregated chunkwise.
+ */
+static Path *
+create_chunkwise_append_path(PlannerInfo *root, Path *path, PathTarget *partial_target,
+							 const AggClauseCosts *agg_partial_costs, double d_num_groups,
+							 bool group_by_time, bool can_hash, bool can_sort)
+{
+	PathTarget *scanjoin_target = path->pathtarget;
+	List *subpaths;
+	List *agg_paths = NIL;
+	ListCell *lc;
+
+	if (IsA(path, ProjectionPath))
+		path = castNode(ProjectionPath, path)->subpath;
+
+	subpaths = get_chunk_subpaths(path);
+
+	/* there is nothing to gain for a single chunk */
+	if (list_length(subpaths) < 2)
+		return NULL;
+
+	foreach (lc, subpaths)
+	{
+		Path *subpath = lfirst(lc);
+		Path *agg_path;
+		double d_chunk_groups;
+
+		/*
+		 * Groups on the time column do not span time slices and are assumed
+		 * to be distributed across chunks like the rows are. Groups on space
+		 * columns only can occur in every chunk, so any chunk might hold all
+		 * of them.
+		 */
+		if (group_by_time)
+			d_chunk_groups = d_num_groups * subpath->rows / Max(path->rows, 1.0);
+		else
+			d_chunk_groups = d_num_groups;
+
+		d_chunk_groups = clamp_row_est(Min(d_chunk_groups, subpath->rows));
+
+		agg_path = create_chunk_agg_path(root,
+										 subpath,
+										 scanjoin_target,
+										 partial_target,
+										 agg_partial_costs,
+										 d_chunk_groups,
+										 can_hash,
+										 can_sort);
+
+		if (agg_path == NULL)
+			return NULL;
+
+		agg_paths = lappend(agg_paths, agg_path);
+	}
+
+	if (IsA(path, AppendPath))
+	{
+		AppendPath *append = makeNode(AppendPath);
+
+		*append = *castNode(AppendPath, path);
+		append->subpaths = agg_paths;
+		append->path.pathtarget = partial_target;
+#if PG11_GE
+		cost_append(append);
+#else
+		append_set_costs(&append->path, agg_paths);
+#endif
+		return &append->path;
+	}
+	else
+	{
+		ChunkAppendPath *append =
+			(ChunkAppendPath *) newNode(sizeof(ChunkAppendPath), T_CustomPath);
+
+		*append = *(ChunkAppendPath *) path;
+		append->cpath.custom_paths = agg_paths;
+		append->cpath.path.pathtarget = partial_target;
+		append_set_costs(&append->cpath.path, agg_paths);
+		return &append->cpath.path;
+	}
+}
+
+static void
+add_finalize_agg_paths(PlannerInfo *root, RelOptInfo *output_rel, Path *path,
+					   const AggClauseCosts *agg_final_costs, double d_num_groups, bool can_hash,
+					   bool can_sort)
+{
+	Query *parse = root->parse;
+	PathTarget *target = root->upper_targets[UPPERREL_GROUP_AGG];
+
+	if (can_hash && ts_estimate_hashagg_tablesize(path, agg_final_costs, d_num_groups) <
+						work_mem * UINT64CONST(1024))
+		add_path(output_rel,
+				 (Path *) create_agg_path(root,
+										  output_rel,
+										  path,
+										  target,
+										  AGG_HASHED,
+										  AGGSPLIT_FINAL_DESERIAL,
+										  parse->groupClause,
+										  (List *) parse->havingQual,
+										  agg_final_costs,
+										  d_num_groups));
+
+	if (can_sort)
+	{
+		if (!pathkeys_contained_in(root->group_pathkeys, path->pathkeys))
+			path = (Path *) create_sort_path(root, output_rel, path, root->group_pathkeys, -1.0);
+
+		add_path(output_rel,
+				 (Path *) create_agg_path(root,
+										  output_rel,
+										  path,
+										  target,
+										  AGG_SORTED,
+										  AGGSPLIT_FINAL_DESERIAL,
+										  parse->groupClause,
+										  (List *) parse->havingQual,
+										  agg_final_costs,
+										  d_num_groups));
+	}
+}
+
+/*
+ * Add paths that aggregate every chunk separately below the Append or
+ * ChunkAppend node and combine the partial results above it. This is similar
+ * to PostgreSQL's partitionwise aggregation, but also works for ChunkAppend,
+ * so chunks excluded at startup or runtime are not aggregated.
+ */
+void
+ts_plan_add_chunkwise_agg(PlannerInfo *root, RelOptInfo *input_rel, RelOptInfo *output_rel,
+						  Hypertable *ht)
+{
+	Query *parse = root->parse;
+	Path *cheapest_path = input_rel->cheapest_total_path;
+	PathTarget *target = root->upper_targets[UPPERREL_GROUP_AGG];
+	PathTarget *partial_target;
+	AggClauseCosts agg_costs;
+	AggClauseCosts agg_partial_costs;
+	AggClauseCosts agg_final_costs;
+	double d_num_groups;
+	bool group_by_time;
+	bool can_hash;
+	bool can_sort;
+	Path *path;
+
+	if (parse->groupingSets || !parse->hasAggs || parse->groupClause == NIL)
+		return;
+
+	/* Chunks of compressed hypertables are scanned by DecompressChunk */
+	if (TS_HYPERTABLE_HAS_COMPRESSION(ht))
+		return;
+
+#if PG11_GE
+	/* PostgreSQL creates partitionwise aggregation paths itself */
+	if (IS_PARTITIONED_REL(input_rel))
+		return;
+#endif
+
+	if (!group_by_partitioning_column(root, input_rel->relid, ht->space, false) ||
+		contain_gapfill_walker((Node *) parse->targetList, NULL))
+		return;
+
+	MemSet(&agg_costs, 0, sizeof(AggClauseCosts));
+	get_agg_clause_costs(root, (Node *) root->processed_tlist, AGGSPLIT_SIMPLE, &agg_costs);
+	get_agg_clause_costs(root, parse->havingQual, AGGSPLIT_SIMPLE, &agg_costs);
+
+	/* All aggregates need to support partial aggregation */
+	if (agg_costs.hasNonPartial || agg_costs.hasNonSerial || agg_costs.numOrderedAggs > 0)
+		return;
+
+	group_by_time = group_by_partitioning_column(root, input_rel->relid, ht->space, true);
+	can_hash = grouping_is_hashable(parse->groupClause);
+	can_sort = grouping_is_sortable(parse->groupClause);
+
+	partial_target = ts_make_partial_grouping_target(root, target);
+
+	MemSet(&agg_partial_costs, 0, sizeof(AggClauseCosts));
+	MemSet(&agg_final_costs, 0, sizeof(AggClauseCosts));
+	get_agg_clause_costs(root,
+						 (Node *) partial_target->exprs,
+						 AGGSPLIT_INITIAL_SERIAL,
+						 &agg_partial_costs);
+	get_agg_clause_costs(root, (Node *) target->exprs, AGGSPLIT_FINAL_DESERIAL, &agg_final_costs);
+	get_agg_clause_costs(root, parse->havingQual, AGGSPLIT_FINAL_DESERIAL, &agg_final_costs);
+
+	d_num_groups = ts_estimate_group(root, cheapest_path->rows);
+
+	if (!IS_VALID_ESTIMATE(d_num_groups))
+		d_num_groups =
+			estimate_num_groups(root,
+								get_sortgrouplist_exprs(parse->groupClause, parse->targetList),
+								cheapest_path->rows,
+								NULL);
+
+	/*
+	 * If a single hash table fits into work_mem, aggregating per chunk only
+	 * saves the per-tuple overhead of the append node, so we keep the plain
+	 * aggregation plans.
+	 */
+	if (can_hash && ts_estimate_hashagg_tablesize(cheapest_path, &agg_costs, d_num_groups) <
+						work_mem * UINT64CONST(1024))
+		return;
+
+	path = create_chunkwise_append_path(root,
+										cheapest_path,
+										partial_target,
+										&agg_partial_costs,
+										d_num_groups,
+										group_by_time,
+										can_hash,
+										can_sort);
+
+	if (path != NULL)
+		add_finalize_agg_paths(root,
+							   output_rel,
+							   path,
+							   &agg_final_costs,
+							   d_num_groups,
+							   can_hash,
+							   can_sort);
+
+	/* With a parallel append the workers aggregate different chunks */
+	if (output_rel->consider_parallel && input_rel->partial_pathlist != NIL)
+	{
+		path = create_chunkwise_append_path(root,
+											linitial(input_rel->partial_pathlist),
+											partial_target,
+											&agg_partial_costs,
+											d_num_groups,
+											group_by_time,
+											can_hash,
+											can_sort);
+
+		if (path != NULL && path->parallel_workers > 0)
+		{
+			double total_groups = path->rows * path->parallel_workers;
+
+			path = (Path *)
+				create_gather_path(root, output_rel, path, partial_target, NULL, &total_groups);
+			add_finalize_agg_paths(root,
+								   output_rel,
+								   path,
+								   &agg_final_costs,
+								   d_num_groups,
+								   can_hash,
+								   can_sort);
+		}
+	}
+}
@@ -0,0 +1,35 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_PLAN_CHUNKWISE_AGG_H
+#define TIMESCALEDB_PLAN_CHUNKWISE_AGG_H
+
+#include <postgres.h>
+#include <optimizer/planner.h>
+
+#include "hypertable.h"
+
+/* Chunkwise aggregation splits a grouped aggregate over a hypertable into a
+ * partial aggregate per chunk below the Append or ChunkAppend node and a
+ * finalize aggregate above it:
+ *
+ *  Finalize GroupAggregate
+ *    ->  Sort
+ *          ->  Custom Scan (ChunkAppend)
+ *                ->  Partial HashAggregate
+ *                      ->  Seq Scan on _hyper_1_1_chunk
+ *                ->  Partial HashAggregate
+ *                      ->  Seq Scan on _hyper_1_2_chunk
+ *
+ * This is done when the GROUP BY clause contains a partitioning column or a
+ * time_bucket on the time column, so that groups rarely span chunks. The
+ * per-chunk hash tables and sorts are then much smaller than those of an
+ * aggregate over all chunks, and chunks excluded at runtime by ChunkAppend are
+ * not aggregated at all.
+ */
+extern void ts_plan_add_chunkwise_agg(PlannerInfo *root, RelOptInfo *input_rel,
+									  RelOptInfo *output_rel, Hypertable *ht);
+
+#endif /* TIMESCALEDB_PLAN_CHUNKWISE_AGG_H */
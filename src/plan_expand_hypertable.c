@@ -47,8 +47,11 @@
 #include "guc.h"
 #include "extension.h"
 #include "chunk.h"
+#include "chunk_column_stats.h"
 #include "extension_constants.h"
 #include "partitioning.h"
+#include "dimension_slice_index.h"
+#include "planner_stats.h"
 
 typedef struct CollectQualCtx
 {
@@ -709,6 +712,21 @@ find_children_oids(HypertableRestrictInfo *hri, Hypertable *ht, LOCKMODE lockmod
 	return ts_hypertable_restrict_info_get_chunk_oids(hri, ht, lockmode);
 }
 
+/*
+ * Count the chunks of a hypertable for the planner statistics, using the
+ * cached slice index when possible.
+ */
+static int
+count_chunks(Hypertable *ht)
+{
+	HypertableSliceIndex *index = ts_hypertable_slice_index_get(ht);
+
+	if (NULL != index)
+		return ts_hypertable_slice_index_num_chunks(index);
+
+	return list_length(find_inheritance_children(ht->main_table_relid, NoLock));
+}
+
 static bool
 should_order_append(PlannerInfo *root, RelOptInfo *rel, Hypertable *ht, List *join_conditions,
 					int *order_attno, bool *reverse)
@@ -797,7 +815,14 @@ get_chunk_oids(CollectQualCtx *ctx, PlannerInfo *root, RelOptInfo *rel, Hypertab
 
 	if (ctx->chunk_exclusion_func == NULL)
 	{
-		HypertableRestrictInfo *hri = ts_hypertable_restrict_info_create(rel, ht);
+		HypertableRestrictInfo *hri;
+		instr_time start;
+		bool ordered;
+		List *chunk_oids;
+		List **nested_oids = NULL;
+
+		ts_planner_stats_phase_start(&start);
+		hri = ts_hypertable_restrict_info_create(rel, ht);
 
 		/*
 		 * This is where the magic happens: use our HypertableRestrictInfo
@@ -805,6 +830,7 @@ get_chunk_oids(CollectQualCtx *ctx, PlannerInfo *root, RelOptInfo *rel, Hypertab
 		 * exclusion
 		 */
 		ts_hypertable_restrict_info_add(hri, root, ctx->restrictions);
+		ts_planner_stats_phase_end(ht, PLANNER_PHASE_RESTRICT_INFO, &start);
 
 		/*
 		 * If fdw_private has not been setup by caller there is no point checking
@@ -812,11 +838,16 @@ get_chunk_oids(CollectQualCtx *ctx, PlannerInfo *root, RelOptInfo *rel, Hypertab
 		 * to signal that this is safe to transform in ordered append plan in
 		 * set_rel_pathlist.
 		 */
-		if (rel->fdw_private != NULL &&
-			should_order_append(root, rel, ht, ctx->join_conditions, &order_attno, &reverse))
+		ts_planner_stats_phase_start(&start);
+		ordered = rel->fdw_private != NULL &&
+				  should_order_append(root, rel, ht, ctx->join_conditions, &order_attno, &reverse);
+		ts_planner_stats_phase_end(ht, PLANNER_PHASE_ORDERED_APPEND, &start);
+
+		ts_planner_stats_phase_start(&start);
+
+		if (ordered)
 		{
 			TimescaleDBPrivate *priv = ts_get_private_reloptinfo(rel);
-			List **nested_oids = NULL;
 
 			priv->appends_ordered = true;
 			priv->order_attno = order_attno;
@@ -828,13 +859,27 @@ get_chunk_oids(CollectQualCtx *ctx, PlannerInfo *root, RelOptInfo *rel, Hypertab
 			if (ht->space->num_dimensions > 1)
 				nested_oids = &priv->nested_oids;
 
-			return ts_hypertable_restrict_info_get_chunk_oids_ordered(hri,
-																	  ht,
-																	  AccessShareLock,
-																	  nested_oids,
-																	  reverse);
+			chunk_oids = ts_hypertable_restrict_info_get_chunk_oids_ordered(hri,
+																			ht,
+																			AccessShareLock,
+																			nested_oids,
+																			reverse);
 		}
-		return find_children_oids(hri, ht, AccessShareLock);
+		else
+			chunk_oids = find_children_oids(hri, ht, AccessShareLock);
+
+		/* Exclude chunks based on the ranges of non-dimension columns */
+		if (ht->stats_columns != NIL)
+			chunk_oids = ts_chunk_column_stats_exclude_chunks(root,
+															  rel,
+															  ht,
+															  ctx->restrictions,
+															  chunk_oids,
+															  nested_oids);
+
+		ts_planner_stats_phase_end(ht, PLANNER_PHASE_CHUNK_EXCLUSION, &start);
+
+		return chunk_oids;
 	}
 	else
 		return get_explicit_chunk_oids(ctx, ht);
@@ -1024,10 +1069,13 @@ ts_plan_expand_hypertable_chunks(Hypertable *ht, PlannerInfo *root, RelOptInfo *
 	};
 	Size old_rel_array_len;
 	Index first_chunk_index = 0;
+	instr_time start;
 #if PG12_GE
 	Index i;
 #endif
 
+	ts_planner_stats_phase_start(&start);
+
 	/* double check our permissions are valid */
 	Assert(rti != parse->resultRelation);
 
@@ -1182,6 +1230,12 @@ ts_plan_expand_hypertable_chunks(Hypertable *ht, PlannerInfo *root, RelOptInfo *
 			rel->part_rels[i] = child_rel;
 	}
 #endif
+
+	ts_planner_stats_phase_end(ht, PLANNER_PHASE_EXPANSION, &start);
+
+	/* Counting the chunks is not part of the expansion, so it is not timed */
+	if (ts_planner_stats_enabled())
+		ts_planner_stats_add_chunks(ht, count_chunks(ht), list_length(inh_oids));
 }
 
 void
@@ -64,9 +64,11 @@
 #include "dimension_vector.h"
 #include "func_cache.h"
 #include "chunk.h"
+#include "planner_stats.h"
 #include "planner.h"
 #include "plan_expand_hypertable.h"
 #include "plan_add_hashagg.h"
+#include "plan_chunkwise_agg.h"
 #include "plan_agg_bookend.h"
 #include "plan_partialize.h"
 #include "import/allpaths.h"
@@ -280,8 +282,10 @@ timescaledb_planner(Query *parse, int cursor_opts, ParamListInfo bound_params)
 {
 	PlannedStmt *stmt;
 	ListCell *lc;
+	instr_time start;
 
 	planner_hcache_push();
+	ts_planner_stats_begin_planning(parse, &start);
 
 	PG_TRY();
 	{
@@ -320,10 +324,12 @@ timescaledb_planner(Query *parse, int cursor_opts, ParamListInfo bound_params)
 		/* Pop the cache, but do not release since caches are auto-released on
 		 * error */
 		planner_hcache_pop(false);
+		ts_planner_stats_abort_planning();
 		PG_RE_THROW();
 	}
 	PG_END_TRY();
 
+	ts_planner_stats_end_planning(&start);
 	planner_hcache_pop(true);
 
 	return stmt;
@@ -661,8 +667,16 @@ apply_optimizations(PlannerInfo *root, TsRelType reltype, RelOptInfo *rel, Range
 	 * to happen before any optimizations that replace pathlist.
 	 */
 	if (ts_cm_functions->set_rel_pathlist_query != NULL)
+	{
+		instr_time start;
+
+		ts_planner_stats_phase_start(&start);
 		ts_cm_functions->set_rel_pathlist_query(root, rel, rel->relid, rte, ht);
 
+		if (ht != NULL && TS_HYPERTABLE_HAS_COMPRESSION(ht))
+			ts_planner_stats_phase_end(ht, PLANNER_PHASE_DECOMPRESSION, &start);
+	}
+
 	if (
 		/*
 		 * Right now this optimization applies only to hypertables (ht used
@@ -776,6 +790,11 @@ timescaledb_set_rel_pathlist(PlannerInfo *root, RelOptInfo *rel, Index rti, Rang
 			apply_optimizations(root, reltype, rel, rte, ht);
 			break;
 	}
+
+	if (ht != NULL && reltype != TS_REL_OTHER)
+		ts_planner_stats_add_paths(ht,
+								   list_length(rel->pathlist) +
+									   list_length(rel->partial_pathlist));
 }
 
 /* This hook is meant to editorialize about the information the planner gets
@@ -1001,8 +1020,16 @@ timescale_create_upper_paths_hook(PlannerInfo *root, UpperRelationKind stage, Re
 	if (stage == UPPERREL_GROUP_AGG && output_rel != NULL)
 	{
 		if (!partials_found)
+		{
+			Hypertable *ht;
+
 			ts_plan_add_hashagg(root, input_rel, output_rel);
 
+			if (ts_guc_enable_chunkwise_aggregation &&
+				classify_relation(root, input_rel, &ht) == TS_REL_HYPERTABLE)
+				ts_plan_add_chunkwise_agg(root, input_rel, output_rel, ht);
+		}
+
 		if (parse->hasAggs)
 			ts_preprocess_first_last_aggregates(root, root->processed_tlist);
 	}
@@ -0,0 +1,534 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#include <postgres.h>
+#include <access/htup_details.h>
+#include <commands/explain.h>
+#include <funcapi.h>
+#include <tcop/tcopprot.h>
+#include <utils/hsearch.h>
+#include <utils/lsyscache.h>
+#include <utils/memutils.h>
+
+#include "compat.h"
+#include "extension.h"
+#include "planner_stats.h"
+
+/*
+ * Planner statistics for hypertables.
+ *
+ * When timescaledb.track_planning is enabled, the time spent in the
+ * hypertable-specific phases of planning and the number of chunks and paths
+ * handled are collected for each hypertable. The statistics are kept
+ * cumulatively per backend and can be queried with
+ * _timescaledb_internal.hypertable_planner_stats(). The statistics of a
+ * single query are also shown by EXPLAIN.
+ */
+typedef struct PlannerStatsEntry
+{
+	Oid hypertable_relid;
+	/* The planning round that last referenced the hypertable */
+	uint64 last_planning_round;
+	PlannerStats stats;
+} PlannerStatsEntry;
+
+void _planner_stats_init(void);
+void _planner_stats_fini(void);
+
+#define PLANNER_STATS_NUM_COLUMNS (6 + _PLANNER_PHASE_MAX)
+
+static HTAB *planner_stats = NULL;
+
+/*
+ * The statistics of the current top-level planning round, i.e., the query
+ * being planned. For these statistics, plans counts the number of
+ * hypertables that were planned.
+ */
+static PlannerStats query_stats;
+static uint64 planning_round = 0;
+static int planning_level = 0;
+static Query *planning_query = NULL;
+
+/*
+ * The query being explained and its statistics, which are saved when its
+ * planning ends. Matching the planned query finds the right planning round
+ * also when another EXPLAIN hook plans the query or plans other queries.
+ */
+static Query *explain_query = NULL;
+static PlannerStats explain_stats;
+
+static ExplainOneQuery_hook_type prev_explain_one_query_hook;
+
+static PlannerStatsEntry *
+planner_stats_get_entry(const Hypertable *ht)
+{
+	PlannerStatsEntry *entry;
+	bool found;
+
+	if (NULL == planner_stats)
+	{
+		HASHCTL hctl = {
+			.keysize = sizeof(Oid),
+			.entrysize = sizeof(PlannerStatsEntry),
+			.hcxt = TopMemoryContext,
+		};
+
+		planner_stats = hash_create("hypertable planner stats",
+									32,
+									&hctl,
+									HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	entry = hash_search(planner_stats, &ht->main_table_relid, HASH_ENTER, &found);
+
+	if (!found)
+	{
+		entry->last_planning_round = 0;
+		memset(&entry->stats, 0, sizeof(entry->stats));
+	}
+
+	if (entry->last_planning_round != planning_round)
+	{
+		entry->last_planning_round = planning_round;
+		entry->stats.plans++;
+		query_stats.plans++;
+	}
+
+	return entry;
+}
+
+void
+ts_planner_stats_phase_end(const Hypertable *ht, PlannerStatsPhase phase, const instr_time *start)
+{
+	PlannerStatsEntry *entry;
+	instr_time duration;
+
+	if (!ts_planner_stats_enabled() || INSTR_TIME_IS_ZERO(*start))
+		return;
+
+	INSTR_TIME_SET_CURRENT(duration);
+	INSTR_TIME_SUBTRACT(duration, *start);
+
+	entry = planner_stats_get_entry(ht);
+	INSTR_TIME_ADD(entry->stats.phase_time[phase], duration);
+	INSTR_TIME_ADD(query_stats.phase_time[phase], duration);
+}
+
+void
+ts_planner_stats_add_chunks(const Hypertable *ht, int num_considered, int num_expanded)
+{
+	PlannerStatsEntry *entry;
+	int num_excluded = Max(num_considered - num_expanded, 0);
+
+	if (!ts_planner_stats_enabled())
+		return;
+
+	entry = planner_stats_get_entry(ht);
+	entry->stats.chunks_considered += num_considered;
+	entry->stats.chunks_excluded += num_excluded;
+	entry->stats.chunks_expanded += num_expanded;
+	query_stats.chunks_considered += num_considered;
+	query_stats.chunks_excluded += num_excluded;
+	query_stats.chunks_expanded += num_expanded;
+}
+
+void
+ts_planner_stats_add_paths(const Hypertable *ht, int num_paths)
+{
+	if (!ts_planner_stats_enabled())
+		return;
+
+	planner_stats_get_entry(ht)->stats.paths_created += num_paths;
+	query_stats.paths_created += num_paths;
+}
+
+/*
+ * Called on entry to the planner. The planner can be invoked recursively, so
+ * only the outermost invocation starts a new planning round.
+ */
+void
+ts_planner_stats_begin_planning(Query *parse, instr_time *start)
+{
+	if (planning_level++ > 0)
+	{
+		INSTR_TIME_SET_ZERO(*start);
+		return;
+	}
+
+	planning_round++;
+	planning_query = parse;
+	memset(&query_stats, 0, sizeof(query_stats));
+	ts_planner_stats_phase_start(start);
+}
+
+/*
+ * Called on exit from the planner. The total planning time is added to all
+ * hypertables planned in this round, and the statistics are saved if the
+ * query is being explained.
+ */
+void
+ts_planner_stats_end_planning(const instr_time *start)
+{
+	HASH_SEQ_STATUS status;
+	PlannerStatsEntry *entry;
+	instr_time duration;
+
+	Assert(planning_level > 0);
+
+	if (--planning_level > 0)
+		return;
+
+	if (ts_planner_stats_enabled() && !INSTR_TIME_IS_ZERO(*start) && query_stats.plans > 0 &&
+		NULL != planner_stats)
+	{
+		INSTR_TIME_SET_CURRENT(duration);
+		INSTR_TIME_SUBTRACT(duration, *start);
+		INSTR_TIME_ADD(query_stats.phase_time[PLANNER_PHASE_PLANNING], duration);
+
+		hash_seq_init(&status, planner_stats);
+
+		while ((entry = hash_seq_search(&status)) != NULL)
+		{
+			if (entry->last_planning_round == planning_round)
+				INSTR_TIME_ADD(entry->stats.phase_time[PLANNER_PHASE_PLANNING], duration);
+		}
+	}
+
+	if (NULL != explain_query && planning_query == explain_query)
+		explain_stats = query_stats;
+}
+
+void
+ts_planner_stats_abort_planning(void)
+{
+	Assert(planning_level > 0);
+	planning_level--;
+}
+
+static const char *const phase_labels[_PLANNER_PHASE_MAX] = {
+	[PLANNER_PHASE_PLANNING] = "Hypertable Planning Time",
+	[PLANNER_PHASE_EXPANSION] = "Hypertable Expansion Time",
+	[PLANNER_PHASE_RESTRICT_INFO] = "Restrict Info Time",
+	[PLANNER_PHASE_CHUNK_EXCLUSION] = "Chunk Exclusion Time",
+	[PLANNER_PHASE_ORDERED_APPEND] = "Ordered Append Time",
+	[PLANNER_PHASE_DECOMPRESSION] = "Decompression Paths Time",
+};
+
+#if PG96
+#define EXPLAIN_SHOW_SUMMARY(es) ((es)->costs)
+#else
+#define EXPLAIN_SHOW_SUMMARY(es) ((es)->summary)
+#endif
+
+/*
+ * The statistics follow the query's own group in the EXPLAIN output, since
+ * ExplainOnePlan() closes that group. They get a group of their own, which is
+ * an element of the top-level list in the structured formats. PostgreSQL's
+ * ExplainOpenGroup() and ExplainCloseGroup() are not exported, so the group
+ * is written here for each format.
+ */
+#define PLANNER_STATS_GROUP "TimescaleDB Planning"
+#define PLANNER_STATS_XML_TAG "TimescaleDB-Planning"
+
+static void
+explain_open_planner_stats_group(ExplainState *es)
+{
+	switch (es->format)
+	{
+		case EXPLAIN_FORMAT_TEXT:
+			appendStringInfoString(es->str, PLANNER_STATS_GROUP ":\n");
+			es->indent++;
+			break;
+		case EXPLAIN_FORMAT_XML:
+			appendStringInfoSpaces(es->str, 2 * es->indent);
+			appendStringInfoString(es->str, "<" PLANNER_STATS_XML_TAG ">\n");
+			es->indent++;
+			break;
+		case EXPLAIN_FORMAT_JSON:
+			/* An object with a labeled object in it, e.g., {"Label": {...}} */
+			if (linitial_int(es->grouping_stack) != 0)
+				appendStringInfoChar(es->str, ',');
+			else
+				linitial_int(es->grouping_stack) = 1;
+			appendStringInfoChar(es->str, '\n');
+			appendStringInfoSpaces(es->str, 2 * es->indent);
+			appendStringInfoString(es->str, "{\n");
+			appendStringInfoSpaces(es->str, 2 * (es->indent + 1));
+			appendStringInfoString(es->str, "\"" PLANNER_STATS_GROUP "\": {");
+			es->grouping_stack = lcons_int(0, es->grouping_stack);
+			es->indent += 2;
+			break;
+		case EXPLAIN_FORMAT_YAML:
+			/* A list item with a labeled mapping, e.g., "- Label: ..." */
+			if (linitial_int(es->grouping_stack) != 0)
+			{
+				appendStringInfoChar(es->str, '\n');
+				appendStringInfoSpaces(es->str, 2 * es->indent);
+			}
+			else
+				linitial_int(es->grouping_stack) = 1;
+			appendStringInfoString(es->str, "- " PLANNER_STATS_GROUP ": ");
+			es->grouping_stack = lcons_int(1, es->grouping_stack);
+			es->indent += 2;
+			break;
+	}
+}
+
+static void
+explain_close_planner_stats_group(ExplainState *es)
+{
+	switch (es->format)
+	{
+		case EXPLAIN_FORMAT_TEXT:
+			es->indent--;
+			break;
+		case EXPLAIN_FORMAT_XML:
+			es->indent--;
+			appendStringInfoSpaces(es->str, 2 * es->indent);
+			appendStringInfoString(es->str, "</" PLANNER_STATS_XML_TAG ">\n");
+			break;
+		case EXPLAIN_FORMAT_JSON:
+			es->indent -= 2;
+			es->grouping_stack = list_delete_first(es->grouping_stack);
+			appendStringInfoChar(es->str, '\n');
+			appendStringInfoSpaces(es->str, 2 * (es->indent + 1));
+			appendStringInfoString(es->str, "}\n");
+			appendStringInfoSpaces(es->str, 2 * es->indent);
+			appendStringInfoChar(es->str, '}');
+			break;
+		case EXPLAIN_FORMAT_YAML:
+			es->indent -= 2;
+			es->grouping_stack = list_delete_first(es->grouping_stack);
+			break;
+	}
+}
+
+static void
+explain_planner_stats(const PlannerStats *stats, ExplainState *es)
+{
+	int i;
+
+	explain_open_planner_stats_group(es);
+
+	ExplainPropertyIntegerCompat("Chunks Considered", NULL, stats->chunks_considered, es);
+	ExplainPropertyIntegerCompat("Chunks Excluded", NULL, stats->chunks_excluded, es);
+	ExplainPropertyIntegerCompat("Chunks Expanded", NULL, stats->chunks_expanded, es);
+	ExplainPropertyIntegerCompat("Paths Created", NULL, stats->paths_created, es);
+
+	/* Like the planning time, timings are only shown in the summary */
+	if (EXPLAIN_SHOW_SUMMARY(es))
+	{
+		for (i = 0; i < _PLANNER_PHASE_MAX; i++)
+		{
+			if (!INSTR_TIME_IS_ZERO(stats->phase_time[i]))
+				ExplainPropertyFloatCompat(phase_labels[i],
+										   "ms",
+										   INSTR_TIME_GET_MILLISEC(stats->phase_time[i]),
+										   3,
+										   es);
+		}
+	}
+
+	explain_close_planner_stats_group(es);
+}
+
+/*
+ * Explain a query and add its planner statistics to the output.
+ *
+ * If another extension installed an EXPLAIN hook before us, that hook plans
+ * and explains the query. Otherwise the query is planned and explained like
+ * PostgreSQL's ExplainOneQuery() does without a hook. The statistics are
+ * shown in both cases, as long as the query passed to the hook is the one
+ * that is planned, which is how PostgreSQL and other hooks plan it.
+ */
+#if PG96
+static void
+timescaledb_explain_one_query(Query *query, IntoClause *into, ExplainState *es,
+							  const char *queryString, ParamListInfo params)
+#else
+static void
+timescaledb_explain_one_query(Query *query, int cursorOptions, IntoClause *into, ExplainState *es,
+							  const char *queryString, ParamListInfo params,
+							  QueryEnvironment *queryEnv)
+#endif
+{
+	Query *saved_query = explain_query;
+	PlannerStats saved_stats = explain_stats;
+	PlannerStats stats;
+
+	explain_query = query;
+	memset(&explain_stats, 0, sizeof(explain_stats));
+
+	if (prev_explain_one_query_hook != NULL)
+	{
+#if PG96
+		prev_explain_one_query_hook(query, into, es, queryString, params);
+#else
+		prev_explain_one_query_hook(query, cursorOptions, into, es, queryString, params, queryEnv);
+#endif
+	}
+	else
+	{
+		PlannedStmt *plan;
+		instr_time planstart, planduration;
+
+		INSTR_TIME_SET_CURRENT(planstart);
+
+#if PG96
+		plan = pg_plan_query(query, into ? 0 : CURSOR_OPT_PARALLEL_OK, params);
+#else
+		plan = pg_plan_query(query, cursorOptions, params);
+#endif
+
+		INSTR_TIME_SET_CURRENT(planduration);
+		INSTR_TIME_SUBTRACT(planduration, planstart);
+
+#if PG96
+		ExplainOnePlan(plan, into, es, queryString, params, &planduration);
+#else
+		ExplainOnePlan(plan, into, es, queryString, params, queryEnv, &planduration);
+#endif
+	}
+
+	/* Queries explained while executing this one restore the saved state */
+	stats = explain_stats;
+	explain_query = saved_query;
+	explain_stats = saved_stats;
+
+	if (ts_planner_stats_enabled() && ts_extension_is_loaded() && stats.plans > 0)
+		explain_planner_stats(&stats, es);
+}
+
+static int
+planner_stats_entry_cmp(const void *left, const void *right)
+{
+	const PlannerStatsEntry *l = left;
+	const PlannerStatsEntry *r = right;
+
+	if (l->hypertable_relid < r->hypertable_relid)
+		return -1;
+
+	if (l->hypertable_relid > r->hypertable_relid)
+		return 1;
+
+	return 0;
+}
+
+typedef struct PlannerStatsIterator
+{
+	int num_entries;
+	PlannerStatsEntry *entries;
+	TupleDesc tupdesc;
+} PlannerStatsIterator;
+
+TS_FUNCTION_INFO_V1(ts_planner_stats_get);
+TS_FUNCTION_INFO_V1(ts_planner_stats_reset);
+
+/*
+ * Get the cumulative planner statistics of this backend, one row per
+ * hypertable that still exists.
+ */
+Datum
+ts_planner_stats_get(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	PlannerStatsIterator *it;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		MemoryContext oldcontext;
+		TupleDesc tupdesc;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("function returning record called in context "
+							"that cannot accept type record")));
+
+		it = palloc0(sizeof(PlannerStatsIterator));
+		it->tupdesc = BlessTupleDesc(tupdesc);
+
+		if (NULL != planner_stats)
+		{
+			HASH_SEQ_STATUS status;
+			PlannerStatsEntry *entry;
+
+			it->entries =
+				palloc(sizeof(PlannerStatsEntry) * Max(hash_get_num_entries(planner_stats), 1));
+			hash_seq_init(&status, planner_stats);
+
+			while ((entry = hash_seq_search(&status)) != NULL)
+			{
+				/* Skip hypertables that were dropped */
+				if (get_rel_name(entry->hypertable_relid) != NULL)
+					it->entries[it->num_entries++] = *entry;
+			}
+
+			qsort(it->entries,
+				  it->num_entries,
+				  sizeof(PlannerStatsEntry),
+				  planner_stats_entry_cmp);
+		}
+
+		funcctx->user_fctx = it;
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	it = funcctx->user_fctx;
+
+	if (funcctx->call_cntr < (uint64) it->num_entries)
+	{
+		PlannerStatsEntry *entry = &it->entries[funcctx->call_cntr];
+		Datum values[PLANNER_STATS_NUM_COLUMNS];
+		bool nulls[PLANNER_STATS_NUM_COLUMNS] = { false };
+		HeapTuple tuple;
+		int i;
+
+		values[0] = ObjectIdGetDatum(entry->hypertable_relid);
+		values[1] = Int64GetDatum(entry->stats.plans);
+		values[2] = Int64GetDatum(entry->stats.chunks_considered);
+		values[3] = Int64GetDatum(entry->stats.chunks_excluded);
+		values[4] = Int64GetDatum(entry->stats.chunks_expanded);
+		values[5] = Int64GetDatum(entry->stats.paths_created);
+
+		for (i = 0; i < _PLANNER_PHASE_MAX; i++)
+			values[6 + i] = Float8GetDatum(INSTR_TIME_GET_MILLISEC(entry->stats.phase_time[i]));
+
+		tuple = heap_form_tuple(it->tupdesc, values, nulls);
+
+		SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+	}
+
+	SRF_RETURN_DONE(funcctx);
+}
+
+Datum
+ts_planner_stats_reset(PG_FUNCTION_ARGS)
+{
+	if (NULL != planner_stats)
+	{
+		hash_destroy(planner_stats);
+		planner_stats = NULL;
+	}
+
+	PG_RETURN_VOID();
+}
+
+void
+_planner_stats_init(void)
+{
+	prev_explain_one_query_hook = ExplainOneQuery_hook;
+	ExplainOneQuery_hook = timescaledb_explain_one_query;
+}
+
+void
+_planner_stats_fini(void)
+{
+	ExplainOneQuery_hook = prev_explain_one_query_hook;
+}
@@ -0,0 +1,72 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_PLANNER_STATS_H
+#define TIMESCALEDB_PLANNER_STATS_H
+
+#include <postgres.h>
+#include <nodes/parsenodes.h>
+#include <portability/instr_time.h>
+
+#include "guc.h"
+#include "hypertable.h"
+
+/*
+ * Hypertable-specific phases of query planning that are timed when
+ * timescaledb.track_planning is enabled.
+ */
+typedef enum PlannerStatsPhase
+{
+	PLANNER_PHASE_PLANNING,		   /* planning of queries that reference the hypertable */
+	PLANNER_PHASE_EXPANSION,	   /* expansion of the hypertable into chunks */
+	PLANNER_PHASE_RESTRICT_INFO,   /* building the hypertable restrict info */
+	PLANNER_PHASE_CHUNK_EXCLUSION, /* finding the chunks matching the restrictions */
+	PLANNER_PHASE_ORDERED_APPEND,  /* checking if ordered append applies */
+	PLANNER_PHASE_DECOMPRESSION,   /* creating paths for compressed chunks */
+	_PLANNER_PHASE_MAX,
+} PlannerStatsPhase;
+
+typedef struct PlannerStats
+{
+	int64 plans;			 /* queries planned that reference the hypertable */
+	int64 chunks_considered; /* chunks of the hypertable when it was expanded */
+	int64 chunks_excluded;	 /* chunks excluded during planning */
+	int64 chunks_expanded;	 /* chunks added to the plan */
+	int64 paths_created;	 /* paths created for the hypertable and its chunks */
+	instr_time phase_time[_PLANNER_PHASE_MAX];
+} PlannerStats;
+
+#define ts_planner_stats_enabled() (ts_guc_track_planning)
+
+/*
+ * Time a planning phase:
+ *
+ *	 instr_time start;
+ *
+ *	 ts_planner_stats_phase_start(&start);
+ *	 ...
+ *	 ts_planner_stats_phase_end(ht, PLANNER_PHASE_EXPANSION, &start);
+ *
+ * Both calls are no-ops if tracking is disabled.
+ */
+static inline void
+ts_planner_stats_phase_start(instr_time *start)
+{
+	if (ts_planner_stats_enabled())
+		INSTR_TIME_SET_CURRENT(*start);
+	else
+		INSTR_TIME_SET_ZERO(*start);
+}
+
+extern void ts_planner_stats_phase_end(const Hypertable *ht, PlannerStatsPhase phase,
+									   const instr_time *start);
+extern void ts_planner_stats_add_chunks(const Hypertable *ht, int num_considered,
+										int num_expanded);
+extern void ts_planner_stats_add_paths(const Hypertable *ht, int num_paths);
+extern void ts_planner_stats_begin_planning(Query *parse, instr_time *start);
+extern void ts_planner_stats_end_planning(const instr_time *start);
+extern void ts_planner_stats_abort_planning(void);
+
+#endif /* TIMESCALEDB_PLANNER_STATS_H */
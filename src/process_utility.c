@@ -46,6 +46,7 @@
 #include "process_utility.h"
 #include "catalog.h"
 #include "chunk.h"
+#include "chunk_column_stats.h"
 #include "chunk_index.h"
 #include "compat.h"
 #include "copy.h"
@@ -379,6 +380,11 @@ process_copy(ProcessUtilityArgs *args)
 		if (ht == NULL)
 		{
 			ts_cache_release(hcache);
+
+			/* Inserts directly into a chunk are not tracked by column stats */
+			if (stmt->is_from)
+				ts_chunk_column_stats_invalidate_chunk(relid);
+
 			return false;
 		}
 	}
@@ -484,6 +490,183 @@ foreach_chunk_multitransaction(Oid relid, MemoryContext mctx, mt_process_chunk_t
 	return num_chunks;
 }
 
+/*
+ * Compressed chunks have an empty uncompressed relation, so the regular
+ * ANALYZE would only overwrite their statistics with those of an empty
+ * table. They are vacuumed like any other chunk, but analyzed separately
+ * using a sample of their compressed data.
+ */
+static bool
+vacuum_is_compressed_chunk(Chunk *chunk)
+{
+	return chunk->fd.compressed_chunk_id != INVALID_CHUNK_ID &&
+		   ts_cm_functions->analyze_compressed_chunk != NULL;
+}
+
+static bool
+vacuum_stmt_is_vacuum(VacuumStmt *stmt)
+{
+#if PG12_LT
+	return (stmt->options & VACOPT_VACUUM) != 0;
+#else
+	return stmt->is_vacuumcmd;
+#endif
+}
+
+static bool
+vacuum_stmt_is_analyze(VacuumStmt *stmt)
+{
+#if PG12_LT
+	return (stmt->options & VACOPT_ANALYZE) != 0;
+#else
+	ListCell *lc;
+
+	if (!stmt->is_vacuumcmd)
+		return true;
+
+	foreach (lc, stmt->options)
+	{
+		DefElem *opt = lfirst_node(DefElem, lc);
+
+		if (strcmp(opt->defname, "analyze") == 0)
+			return defGetBoolean(opt);
+	}
+	return false;
+#endif
+}
+
+/* Copy of a VACUUM statement that vacuums without analyzing */
+static VacuumStmt *
+vacuum_stmt_without_analyze(VacuumStmt *stmt)
+{
+	VacuumStmt *vacuum_stmt = copyObject(stmt);
+#if PG12_LT
+	vacuum_stmt->options &= ~VACOPT_ANALYZE;
+#if PG11_LT
+	vacuum_stmt->va_cols = NIL;
+#endif
+#else
+	ListCell *lc;
+
+	vacuum_stmt->options = NIL;
+	foreach (lc, stmt->options)
+	{
+		DefElem *opt = lfirst_node(DefElem, lc);
+
+		if (strcmp(opt->defname, "analyze") != 0)
+			vacuum_stmt->options = lappend(vacuum_stmt->options, opt);
+	}
+#endif
+	return vacuum_stmt;
+}
+
+/*
+ * Relation statistics of a compressed chunk, saved before a VACUUM without
+ * ANALYZE. Vacuuming the empty uncompressed relation resets reltuples to zero,
+ * so the values set by the last ANALYZE are restored afterwards.
+ */
+typedef struct CompressedChunkRelStats
+{
+	Oid relid;
+	BlockNumber relpages;
+	float4 reltuples;
+	BlockNumber relallvisible;
+} CompressedChunkRelStats;
+
+static CompressedChunkRelStats *
+compressed_chunk_relstats_get(Oid relid)
+{
+	CompressedChunkRelStats *relstats = palloc0(sizeof(CompressedChunkRelStats));
+	HeapTuple tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(relid));
+
+	relstats->relid = relid;
+	if (HeapTupleIsValid(tuple))
+	{
+		Form_pg_class form = (Form_pg_class) GETSTRUCT(tuple);
+
+		relstats->relpages = form->relpages;
+		relstats->reltuples = form->reltuples;
+		relstats->relallvisible = form->relallvisible;
+		ReleaseSysCache(tuple);
+	}
+	return relstats;
+}
+
+static void
+compressed_chunk_relstats_restore(List *compressed_chunk_relstats)
+{
+	ListCell *lc;
+
+	foreach (lc, compressed_chunk_relstats)
+	{
+		CompressedChunkRelStats *relstats = lfirst(lc);
+		Relation rel = try_relation_open(relstats->relid, ShareUpdateExclusiveLock);
+
+		/* the chunk might have been dropped in the meantime */
+		if (rel == NULL)
+			continue;
+
+		vac_update_relstats(rel,
+							relstats->relpages,
+							relstats->reltuples,
+							relstats->relallvisible,
+							RelationGetForm(rel)->relhasindex,
+							InvalidTransactionId,
+							InvalidMultiXactId,
+							true);
+		relation_close(rel, NoLock);
+	}
+}
+
+/*
+ * Analyze the compressed chunks. Like ANALYZE does for regular tables, each
+ * chunk is analyzed in its own transaction unless the statement runs inside a
+ * transaction block, so that locks and memory are not held for all chunks at
+ * once.
+ */
+static void
+vacuum_analyze_compressed_chunks(VacuumStmt *stmt, List *compressed_chunk_relids,
+								 bool is_toplevel)
+{
+	bool use_own_xacts = vacuum_stmt_is_vacuum(stmt) || !IsInTransactionBlock(is_toplevel);
+	ListCell *lc;
+
+	if (compressed_chunk_relids == NIL)
+		return;
+
+	/* ExecVacuum() leaves a transaction open for us when it uses its own */
+	if (use_own_xacts)
+	{
+		if (ActiveSnapshotSet())
+			PopActiveSnapshot();
+		CommitTransactionCommand();
+	}
+
+	foreach (lc, compressed_chunk_relids)
+	{
+		Chunk *chunk;
+
+		if (use_own_xacts)
+			StartTransactionCommand();
+		PushActiveSnapshot(GetTransactionSnapshot());
+
+		chunk = ts_chunk_get_by_relid(lfirst_oid(lc), false);
+
+		/* the chunk might have been dropped or decompressed in the meantime */
+		if (chunk != NULL && chunk->fd.compressed_chunk_id != INVALID_CHUNK_ID)
+			ts_cm_functions->analyze_compressed_chunk(chunk);
+
+		PopActiveSnapshot();
+		if (use_own_xacts)
+			CommitTransactionCommand();
+		else
+			CommandCounterIncrement();
+	}
+
+	if (use_own_xacts)
+		StartTransactionCommand();
+}
+
 /*
  * PG11 modified  how vacuum works (see:
  * https://github.com/postgres/postgres/commit/11d8d72c27a64ea4e30adce11cf6c4f3dd3e60db)
@@ -497,7 +680,13 @@ foreach_chunk_multitransaction(Oid relid, MemoryContext mctx, mt_process_chunk_t
 typedef struct VacuumCtx
 {
 	VacuumStmt *stmt;
+	VacuumStmt *vacuum_only_stmt;
 	bool is_toplevel;
+	bool is_analyze;
+	/* context for the compressed chunk lists, which survives vacuum's commits */
+	MemoryContext mctx;
+	List *compressed_chunk_relids;
+	List *compressed_chunk_relstats;
 } VacuumCtx;
 
 /* Vacuums a single chunk */
@@ -506,10 +695,27 @@ vacuum_chunk(Hypertable *ht, Oid chunk_relid, void *arg)
 {
 	VacuumCtx *ctx = (VacuumCtx *) arg;
 	Chunk *chunk = ts_chunk_get_by_relid(chunk_relid, true);
+	VacuumStmt *stmt = ctx->stmt;
+
+	if (vacuum_is_compressed_chunk(chunk))
+	{
+		MemoryContext old = MemoryContextSwitchTo(ctx->mctx);
 
-	ctx->stmt->relation->relname = NameStr(chunk->fd.table_name);
-	ctx->stmt->relation->schemaname = NameStr(chunk->fd.schema_name);
-	ExecVacuum(ctx->stmt, ctx->is_toplevel);
+		if (ctx->is_analyze)
+			ctx->compressed_chunk_relids = lappend_oid(ctx->compressed_chunk_relids, chunk_relid);
+		else
+			ctx->compressed_chunk_relstats =
+				lappend(ctx->compressed_chunk_relstats, compressed_chunk_relstats_get(chunk_relid));
+		MemoryContextSwitchTo(old);
+
+		if (!vacuum_stmt_is_vacuum(stmt))
+			return;
+		stmt = ctx->vacuum_only_stmt;
+	}
+
+	stmt->relation->relname = NameStr(chunk->fd.table_name);
+	stmt->relation->schemaname = NameStr(chunk->fd.schema_name);
+	ExecVacuum(stmt, ctx->is_toplevel);
 }
 
 /* Vacuums each chunk of a hypertable */
@@ -521,6 +727,10 @@ process_vacuum(ProcessUtilityArgs *args)
 	VacuumCtx ctx = {
 		.stmt = stmt,
 		.is_toplevel = is_toplevel,
+		.is_analyze = vacuum_stmt_is_analyze(stmt),
+		.mctx = CurrentMemoryContext,
+		.compressed_chunk_relids = NIL,
+		.compressed_chunk_relstats = NIL,
 	};
 	Oid hypertable_oid;
 	Cache *hcache;
@@ -541,6 +751,8 @@ process_vacuum(ProcessUtilityArgs *args)
 	if (ht)
 		process_add_hypertable(args, ht);
 
+	ctx.vacuum_only_stmt = vacuum_stmt_without_analyze(stmt);
+
 	/* allow vacuum to be cross-commit */
 	hcache->release_on_commit = false;
 	foreach_chunk(ht, vacuum_chunk, &ctx);
@@ -563,13 +775,20 @@ process_vacuum(ProcessUtilityArgs *args)
 	stmt->relation->schemaname = NameStr(ht->fd.schema_name);
 	ExecVacuum(stmt, is_toplevel);
 
+	compressed_chunk_relstats_restore(ctx.compressed_chunk_relstats);
+	vacuum_analyze_compressed_chunks(stmt, ctx.compressed_chunk_relids, is_toplevel);
+
 	return true;
 }
 #else
 typedef struct VacuumCtx
 {
 	VacuumRelation *ht_vacuum_rel;
+	bool is_analyze;
 	List *chunk_rels;
+	List *compressed_chunk_rels;
+	List *compressed_chunk_relids;
+	List *compressed_chunk_relstats;
 } VacuumCtx;
 
 /* Adds a chunk to the list of tables to be vacuumed */
@@ -579,10 +798,26 @@ add_chunk_to_vacuum(Hypertable *ht, Oid chunk_relid, void *arg)
 	VacuumCtx *ctx = (VacuumCtx *) arg;
 	Chunk *chunk = ts_chunk_get_by_relid(chunk_relid, true);
 	VacuumRelation *chunk_vacuum_rel;
-	RangeVar *chunk_range_var = copyObject(ctx->ht_vacuum_rel->relation);
+	RangeVar *chunk_range_var;
 
+	chunk_range_var = copyObject(ctx->ht_vacuum_rel->relation);
 	chunk_range_var->relname = NameStr(chunk->fd.table_name);
 	chunk_range_var->schemaname = NameStr(chunk->fd.schema_name);
+
+	/* compressed chunks are vacuumed without analyzing them, see above */
+	if (vacuum_is_compressed_chunk(chunk))
+	{
+		if (ctx->is_analyze)
+			ctx->compressed_chunk_relids = lappend_oid(ctx->compressed_chunk_relids, chunk_relid);
+		else
+			ctx->compressed_chunk_relstats =
+				lappend(ctx->compressed_chunk_relstats, compressed_chunk_relstats_get(chunk_relid));
+
+		chunk_vacuum_rel = makeVacuumRelation(chunk_range_var, chunk_relid, NIL);
+		ctx->compressed_chunk_rels = lappend(ctx->compressed_chunk_rels, chunk_vacuum_rel);
+		return;
+	}
+
 	chunk_vacuum_rel =
 		makeVacuumRelation(chunk_range_var, chunk_relid, ctx->ht_vacuum_rel->va_cols);
 
@@ -597,7 +832,11 @@ process_vacuum(ProcessUtilityArgs *args)
 	bool is_toplevel = (args->context == PROCESS_UTILITY_TOPLEVEL);
 	VacuumCtx ctx = {
 		.ht_vacuum_rel = NULL,
+		.is_analyze = vacuum_stmt_is_analyze(stmt),
 		.chunk_rels = NIL,
+		.compressed_chunk_rels = NIL,
+		.compressed_chunk_relids = NIL,
+		.compressed_chunk_relstats = NIL,
 	};
 	ListCell *lc;
 	Cache *hcache;
@@ -643,6 +882,23 @@ process_vacuum(ProcessUtilityArgs *args)
 #endif
 		stmt,
 		is_toplevel);
+
+	if (vacuum_stmt_is_vacuum(stmt) && ctx.compressed_chunk_rels != NIL)
+	{
+		VacuumStmt *vacuum_stmt = vacuum_stmt_without_analyze(stmt);
+
+		vacuum_stmt->rels = ctx.compressed_chunk_rels;
+		ExecVacuum(
+#if PG12_GE
+			args->parse_state,
+#endif
+			vacuum_stmt,
+			is_toplevel);
+		compressed_chunk_relstats_restore(ctx.compressed_chunk_relstats);
+	}
+
+	vacuum_analyze_compressed_chunks(stmt, ctx.compressed_chunk_relids, is_toplevel);
+
 	return true;
 }
 #endif
@@ -1238,6 +1494,8 @@ process_rename_column(ProcessUtilityArgs *args, Cache *hcache, Oid relid, Rename
 
 	process_add_hypertable(args, ht);
 
+	ts_chunk_column_stats_rename_column(ht, stmt->subname, stmt->newname);
+
 	dim = ts_hyperspace_get_dimension_by_name(ht->space, DIMENSION_TYPE_ANY, stmt->subname);
 
 	if (NULL == dim)
@@ -1517,6 +1775,8 @@ process_altertable_drop_column(Hypertable *ht, AlterTableCmd *cmd)
 					 errdetail("cannot drop column that is a hypertable partitioning (space or "
 							   "time) dimension")));
 	}
+
+	ts_chunk_column_stats_delete_column(ht, cmd->name);
 }
 
 /* process all regular-table alter commands to make sure they aren't adding
@@ -2293,6 +2553,8 @@ process_alter_column_type_end(Hypertable *ht, AlterTableCmd *cmd)
 	Oid new_type = TypenameGetTypid(typename_get_unqual_name(coldef->typeName));
 	Dimension *dim = ts_hyperspace_get_dimension_by_name(ht->space, DIMENSION_TYPE_ANY, cmd->name);
 
+	ts_chunk_column_stats_alter_column_type(ht, cmd->name);
+
 	if (NULL == dim)
 		return;
 
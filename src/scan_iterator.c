@@ -29,3 +29,23 @@ ts_scan_iterator_scan_key_init(ScanIterator *iterator, AttrNumber attributeNumbe
 				procedure,
 				argument);
 }
+
+TSDLLEXPORT void
+ts_scan_iterator_scan_key_init_array(ScanIterator *iterator, AttrNumber attributeNumber,
+									 StrategyNumber strategy, RegProcedure procedure,
+									 Oid elemtype, Datum *values, int num_values)
+{
+	Assert(iterator->ctx.scankey == NULL || iterator->ctx.scankey == iterator->scankey);
+	iterator->ctx.scankey = iterator->scankey;
+
+	if (iterator->ctx.nkeys >= EMBEDDED_SCAN_KEY_SIZE)
+		elog(ERROR, "cannot scan more than %d keys", EMBEDDED_SCAN_KEY_SIZE);
+
+	ts_scanner_scan_key_init_array(&iterator->scankey[iterator->ctx.nkeys++],
+								   attributeNumber,
+								   strategy,
+								   procedure,
+								   elemtype,
+								   values,
+								   num_values);
+}
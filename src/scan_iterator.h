@@ -54,6 +54,11 @@ void TSDLLEXPORT ts_scan_iterator_close(ScanIterator *iterator);
 void TSDLLEXPORT ts_scan_iterator_scan_key_init(ScanIterator *iterator, AttrNumber attributeNumber,
 												StrategyNumber strategy, RegProcedure procedure,
 												Datum argument);
+void TSDLLEXPORT ts_scan_iterator_scan_key_init_array(ScanIterator *iterator,
+													  AttrNumber attributeNumber,
+													  StrategyNumber strategy,
+													  RegProcedure procedure, Oid elemtype,
+													  Datum *values, int num_values);
 
 /* You must use `ts_scan_iterator_close` if terminating this loop early */
 #define ts_scanner_foreach(scan_iterator)                                                          \
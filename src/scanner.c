@@ -8,6 +8,8 @@
 #include <access/xact.h>
 #include <storage/lmgr.h>
 #include <storage/bufmgr.h>
+#include <utils/array.h>
+#include <utils/lsyscache.h>
 #include <utils/rel.h>
 
 #include "scanner.h"
@@ -42,6 +44,11 @@ static ScanDesc
 heap_scanner_beginscan(InternalScannerCtx *ctx)
 {
 	ScannerCtx *sctx = ctx->sctx;
+	int i;
+
+	for (i = 0; i < sctx->nkeys; i++)
+		if (sctx->scankey[i].sk_flags & SK_SEARCHARRAY)
+			elog(ERROR, "array scan keys are only supported for index scans");
 
 	ctx->scan.heap_scan = table_beginscan(ctx->tablerel, SnapshotSelf, sctx->nkeys, sctx->scankey);
 	return ctx->scan;
@@ -284,6 +291,36 @@ ts_scanner_scan(ScannerCtx *ctx)
 	return ictx.tinfo.count;
 }
 
+/*
+ * Initialize a scan key that matches any of the values in an array.
+ *
+ * This allows looking up many keys in a single ordered pass over a B-tree
+ * index, instead of doing one index scan per key. Tuples are returned in index
+ * order, irrespective of the order of the values in the array. Only supported
+ * for index scans.
+ */
+TSDLLEXPORT void
+ts_scanner_scan_key_init_array(ScanKey entry, AttrNumber attributeNumber, StrategyNumber strategy,
+							   RegProcedure procedure, Oid elemtype, Datum *values, int num_values)
+{
+	int16 elemlen;
+	bool elembyval;
+	char elemalign;
+	ArrayType *array;
+
+	get_typlenbyvalalign(elemtype, &elemlen, &elembyval, &elemalign);
+	array = construct_array(values, num_values, elemtype, elemlen, elembyval, elemalign);
+
+	ScanKeyEntryInitialize(entry,
+						   SK_SEARCHARRAY,
+						   attributeNumber,
+						   strategy,
+						   InvalidOid,
+						   InvalidOid,
+						   procedure,
+						   PointerGetDatum(array));
+}
+
 TSDLLEXPORT bool
 ts_scanner_scan_one(ScannerCtx *ctx, bool fail_if_not_found, char *item_type)
 {
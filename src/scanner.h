@@ -111,6 +111,10 @@ typedef struct ScannerCtx
 extern TSDLLEXPORT int ts_scanner_scan(ScannerCtx *ctx);
 extern TSDLLEXPORT bool ts_scanner_scan_one(ScannerCtx *ctx, bool fail_if_not_found,
 											char *item_type);
+extern TSDLLEXPORT void ts_scanner_scan_key_init_array(ScanKey entry, AttrNumber attributeNumber,
+													   StrategyNumber strategy,
+													   RegProcedure procedure, Oid elemtype,
+													   Datum *values, int num_values);
 
 /*
  * Internal types and functions below.
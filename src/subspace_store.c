@@ -28,12 +28,25 @@ typedef struct SubspaceStoreInternalNode
 	bool last_internal_node;
 } SubspaceStoreInternalNode;
 
+/*
+ * The leaf slices point to a SubspaceStoreLeaf, which wraps the stored object
+ * and records when the object was last accessed.
+ */
+typedef struct SubspaceStoreLeaf
+{
+	void *object;
+	void (*object_free)(void *);
+	uint64 last_access;
+} SubspaceStoreLeaf;
+
 typedef struct SubspaceStore
 {
 	MemoryContext mcxt;
 	int16 num_dimensions;
-	/* limit growth of store by  limiting number of slices in first dimension,	0 for no limit */
+	/* limit growth of store by limiting the number of stored objects, 0 for no limit */
 	int16 max_items;
+	/* incremented on every access, used to find the least recently used object */
+	uint64 access_clock;
 	SubspaceStoreInternalNode *origin; /* origin of the tree */
 } SubspaceStore;
 
@@ -55,18 +68,103 @@ subspace_store_internal_node_free(void *node)
 	pfree(node);
 }
 
-static size_t
-subspace_store_internal_node_descendants(SubspaceStoreInternalNode *node, int index)
+static void
+subspace_store_leaf_free(void *ptr)
 {
-	DimensionSlice *slice = ts_dimension_vec_get(node->vector, index);
+	SubspaceStoreLeaf *leaf = ptr;
 
-	if (slice == NULL)
-		return 0;
+	if (leaf->object_free != NULL)
+		leaf->object_free(leaf->object);
+	pfree(leaf);
+}
 
-	if (node->last_internal_node)
-		return 1;
+/*
+ * Find the least recently used leaf in the subtree of the given node.
+ */
+static SubspaceStoreLeaf *
+subspace_store_find_lru_leaf(SubspaceStoreInternalNode *node, SubspaceStoreLeaf *lru)
+{
+	int i;
 
-	return ((SubspaceStoreInternalNode *) slice->storage)->descendants;
+	for (i = 0; i < node->vector->num_slices; i++)
+	{
+		void *storage = node->vector->slices[i]->storage;
+
+		if (node->last_internal_node)
+		{
+			SubspaceStoreLeaf *leaf = storage;
+
+			if (lru == NULL || leaf->last_access < lru->last_access)
+				lru = leaf;
+		}
+		else
+			lru = subspace_store_find_lru_leaf(storage, lru);
+	}
+
+	return lru;
+}
+
+/*
+ * Remove a leaf from the subtree of the given node, freeing the leaf's object
+ * and any internal nodes that become empty. Returns true if the leaf was
+ * found.
+ */
+static bool
+subspace_store_remove_leaf(SubspaceStoreInternalNode *node, SubspaceStoreLeaf *leaf)
+{
+	int i;
+
+	for (i = 0; i < node->vector->num_slices; i++)
+	{
+		void *storage = node->vector->slices[i]->storage;
+
+		if (node->last_internal_node)
+		{
+			if (storage != leaf)
+				continue;
+		}
+		else
+		{
+			SubspaceStoreInternalNode *child = storage;
+
+			if (!subspace_store_remove_leaf(child, leaf))
+				continue;
+
+			if (child->descendants > 0)
+			{
+				node->descendants -= 1;
+				return true;
+			}
+		}
+
+		/* Removing the slice frees the leaf or the empty child node */
+		ts_dimension_vec_remove_slice(&node->vector, i);
+		node->descendants -= 1;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ * Evict the least recently used object from the store.
+ *
+ * The whole tree is searched, which is cheap since the number of stored
+ * objects is bounded by max_items. Unlike evicting by time slice, this keeps
+ * frequently used objects (e.g., the chunk receiving live data while older
+ * data is backfilled) in the store regardless of their position in time.
+ */
+static void
+subspace_store_evict_lru(SubspaceStore *store)
+{
+	SubspaceStoreLeaf *lru = subspace_store_find_lru_leaf(store->origin, NULL);
+	bool PG_USED_FOR_ASSERTS_ONLY removed;
+
+	if (lru == NULL)
+		return;
+
+	removed = subspace_store_remove_leaf(store->origin, lru);
+	Assert(removed);
 }
 
 SubspaceStore *
@@ -85,6 +183,7 @@ ts_subspace_store_init(Hyperspace *space, MemoryContext mcxt, int16 max_items)
 	sst->num_dimensions = space->num_dimensions;
 	/* max_items = 0 is treated as unlimited */
 	sst->max_items = max_items;
+	sst->access_clock = 0;
 	sst->mcxt = mcxt;
 	MemoryContextSwitchTo(old);
 	return sst;
@@ -94,13 +193,20 @@ void
 ts_subspace_store_add(SubspaceStore *store, const Hypercube *hc, void *object,
 					  void (*object_free)(void *))
 {
-	SubspaceStoreInternalNode *node = store->origin;
+	SubspaceStoreInternalNode *node;
+	SubspaceStoreLeaf *leaf;
 	DimensionSlice *last = NULL;
 	MemoryContext old = MemoryContextSwitchTo(store->mcxt);
 	int i;
 
 	Assert(hc->num_slices == store->num_dimensions);
 
+	/* Make room for the new object if the store is full */
+	if (store->max_items > 0 && store->origin->descendants >= (size_t) store->max_items)
+		subspace_store_evict_lru(store);
+
+	node = store->origin;
+
 	for (i = 0; i < hc->num_slices; i++)
 	{
 		const DimensionSlice *target = hc->slices[i];
@@ -121,8 +227,6 @@ ts_subspace_store_add(SubspaceStore *store, const Hypercube *hc, void *object,
 			node = last->storage;
 		}
 
-		Assert(store->max_items == 0 || node->descendants <= (size_t) store->max_items);
-
 		/*
 		 * We only call this function on a cache miss, so number of leaves
 		 * will definitely increase see `Assert(last != NULL && last->storage
@@ -133,37 +237,6 @@ ts_subspace_store_add(SubspaceStore *store, const Hypercube *hc, void *object,
 		Assert(0 == node->vector->num_slices ||
 			   node->vector->slices[0]->fd.dimension_id == target->fd.dimension_id);
 
-		/* Do we have enough space to store the object? */
-		if (store->max_items > 0 && node->descendants > store->max_items)
-		{
-			/*
-			 * Always delete the slice corresponding to the earliest time
-			 * range. In the normal case that inserts are performed in
-			 * time-order this is the one least likely to be reused. (Note
-			 * that we made sure that the first dimension is a time dimension
-			 * when creating the subspace_store). If out-of-order inserts are
-			 * become significant we may wish to change this to something more
-			 * sophisticated like LRU.
-			 */
-			size_t items_removed = subspace_store_internal_node_descendants(node, i);
-
-			/*
-			 * descendants at the root is inclusive of the descendants at the
-			 * children, so if we have an overflow it must be in the time dim
-			 */
-			Assert(i == 0);
-
-			Assert(store->max_items + 1 == node->descendants);
-
-			ts_dimension_vec_remove_slice(&node->vector, i);
-
-			/*
-			 * Note we would have to do this to ancestors if this was not the
-			 * root.
-			 */
-			node->descendants -= items_removed;
-		}
-
 		match = ts_dimension_vec_find_slice(node->vector, target->fd.range_start);
 
 		/* Do we have a slot in this vector for the new object? */
@@ -189,8 +262,14 @@ ts_subspace_store_add(SubspaceStore *store, const Hypercube *hc, void *object,
 	}
 
 	Assert(last != NULL && last->storage == NULL);
-	last->storage = object; /* at the end we store the object */
-	last->storage_free = object_free;
+
+	/* at the end we store the object */
+	leaf = palloc(sizeof(SubspaceStoreLeaf));
+	leaf->object = object;
+	leaf->object_free = object_free;
+	leaf->last_access = ++store->access_clock;
+	last->storage = leaf;
+	last->storage_free = subspace_store_leaf_free;
 	MemoryContextSwitchTo(old);
 }
 
@@ -200,6 +279,7 @@ ts_subspace_store_get(SubspaceStore *store, Point *target)
 	int i;
 	DimensionVec *vec = store->origin->vector;
 	DimensionSlice *match = NULL;
+	SubspaceStoreLeaf *leaf;
 
 	Assert(target->cardinality == store->num_dimensions);
 
@@ -213,7 +293,11 @@ ts_subspace_store_get(SubspaceStore *store, Point *target)
 		vec = ((SubspaceStoreInternalNode *) match->storage)->vector;
 	}
 	Assert(match != NULL);
-	return match->storage;
+
+	leaf = match->storage;
+	leaf->last_access = ++store->access_clock;
+
+	return leaf->object;
 }
 
 void
@@ -228,3 +312,10 @@ ts_subspace_store_mcxt(SubspaceStore *store)
 {
 	return store->mcxt;
 }
+
+/* Get the number of objects currently in the store */
+size_t
+ts_subspace_store_num_objects(SubspaceStore *store)
+{
+	return store->origin->descendants;
+}
@@ -32,5 +32,6 @@ extern void ts_subspace_store_add(SubspaceStore *cache, const Hypercube *hc, voi
 extern void *ts_subspace_store_get(SubspaceStore *cache, Point *target);
 extern void ts_subspace_store_free(SubspaceStore *cache);
 extern MemoryContext ts_subspace_store_mcxt(SubspaceStore *cache);
+extern size_t ts_subspace_store_num_objects(SubspaceStore *cache);
 
 #endif /* TIMESCALEDB_SUBSPACE_STORE_H */
@@ -0,0 +1,44 @@
+setup
+{
+ CREATE TABLE zone_map(time int NOT NULL, seq int);
+ SELECT create_hypertable('zone_map', 'time', chunk_time_interval => 10);
+ SELECT enable_chunk_column_stats('zone_map', 'seq');
+ INSERT INTO zone_map VALUES (0, 100), (10, 200);
+}
+
+teardown { DROP TABLE zone_map; }
+
+session "s1"
+setup	{ BEGIN; }
+step "s1i"	{ INSERT INTO zone_map VALUES (1, 50), (11, 250); }
+step "s1c"	{ COMMIT; }
+step "s1r"	{ ROLLBACK; }
+
+session "s2"
+setup	{ BEGIN; }
+step "s2i"	{ INSERT INTO zone_map VALUES (12, 150), (2, 500); }
+step "s2c"	{ COMMIT; }
+
+session "s3"
+step "s3s"	{
+  SELECT s.range_start, s.range_end, s.valid
+  FROM _timescaledb_catalog.chunk_column_stats s
+  JOIN _timescaledb_catalog.chunk c ON (c.id = s.chunk_id)
+  ORDER BY c.id;
+}
+step "s3q"	{
+  SELECT time, seq FROM zone_map WHERE seq >= 400
+  UNION ALL
+  SELECT time, seq FROM zone_map WHERE seq < 160
+  ORDER BY time;
+}
+
+# Inserts that widen the ranges of the same chunks wait for each other,
+# also when they insert into the chunks in opposite order
+permutation "s1i" "s2i" "s1c" "s2c" "s3s" "s3q"
+
+# The widened ranges are not visible before the insert commits
+permutation "s1i" "s3s" "s3q" "s1c" "s3s" "s3q"
+
+# The widening is rolled back with the insert
+permutation "s1i" "s2i" "s1r" "s2c" "s3s" "s3q"
@@ -11,6 +11,9 @@ AS :MODULE_PATHNAME LANGUAGE C VOLATILE;
 
 CREATE OR REPLACE FUNCTION ts_test_adts() RETURNS VOID
 AS :MODULE_PATHNAME LANGUAGE C VOLATILE;
+
+CREATE OR REPLACE FUNCTION ts_test_shared_slice_cache() RETURNS VOID
+AS :MODULE_PATHNAME LANGUAGE C VOLATILE;
 \c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
 
 SELECT ts_test_time_to_internal_conversion();
@@ -18,3 +21,5 @@ SELECT ts_test_time_to_internal_conversion();
 SELECT ts_test_interval_to_internal_conversion();
 
 SELECT ts_test_adts();
+
+SELECT ts_test_shared_slice_cache();
@@ -0,0 +1,85 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+CREATE TABLE zone_map(time int NOT NULL, seq int, value float);
+SELECT create_hypertable('zone_map', 'time', chunk_time_interval => 10);
+INSERT INTO zone_map SELECT t, t + 100, 1.0 FROM generate_series(0, 29) t;
+
+-- show the chunks that are scanned by a query
+CREATE OR REPLACE FUNCTION scanned_chunks(query TEXT)
+RETURNS SETOF TEXT LANGUAGE PLPGSQL AS
+$BODY$
+DECLARE
+    line TEXT;
+BEGIN
+    FOR line IN EXECUTE format('EXPLAIN (costs off) %s', query) LOOP
+        IF line ~ '_hyper_\d+_\d+_chunk' THEN
+            RETURN NEXT substring(line FROM '_hyper_\d+_\d+_chunk');
+        END IF;
+    END LOOP;
+END
+$BODY$;
+
+CREATE VIEW column_stats AS
+SELECT chunk_id, column_name, range_start, range_end, valid
+FROM _timescaledb_catalog.chunk_column_stats
+ORDER BY chunk_id, column_name;
+
+-- enabling stats calculates the ranges of existing chunks
+SELECT enable_chunk_column_stats('zone_map', 'seq');
+SELECT * FROM column_stats;
+
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq < 110');
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq >= 115 AND seq < 125');
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq = 200');
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq > 119::bigint');
+
+-- inserts widen the ranges of existing chunks and of new chunks
+INSERT INTO zone_map VALUES (5, 500, 1.0);
+INSERT INTO zone_map VALUES (35, 135, 1.0);
+SELECT * FROM column_stats;
+
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq = 500');
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq >= 130');
+
+-- updates of a stats column invalidate the ranges of the chunks they
+-- modify until they are refreshed
+UPDATE zone_map SET seq = 1000 WHERE time = 25;
+SELECT * FROM column_stats;
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq = 1000');
+
+SELECT refresh_chunk_column_stats(c) FROM show_chunks('zone_map') c;
+SELECT * FROM column_stats;
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq = 1000');
+
+-- each execution of a cached plan invalidates the ranges again
+PREPARE update_zone_map AS UPDATE zone_map SET seq = 119 WHERE time = 15;
+EXECUTE update_zone_map;
+SELECT * FROM column_stats;
+SELECT refresh_chunk_column_stats(c) FROM show_chunks('zone_map') c;
+EXECUTE update_zone_map;
+SELECT * FROM column_stats;
+SELECT refresh_chunk_column_stats(c) FROM show_chunks('zone_map') c;
+DEALLOCATE update_zone_map;
+
+-- renaming the column keeps the stats
+ALTER TABLE zone_map RENAME COLUMN seq TO seq_no;
+SELECT DISTINCT column_name FROM column_stats;
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq_no = 1000');
+
+\set ON_ERROR_STOP 0
+SELECT enable_chunk_column_stats('zone_map', 'seq_no');
+SELECT enable_chunk_column_stats('zone_map', 'time');
+SELECT enable_chunk_column_stats('zone_map', 'value');
+SELECT enable_chunk_column_stats('zone_map', 'missing');
+SELECT disable_chunk_column_stats('zone_map', 'value');
+\set ON_ERROR_STOP 1
+
+SELECT enable_chunk_column_stats('zone_map', 'seq_no', if_not_exists => true);
+
+-- disabling stats removes the ranges of all chunks
+SELECT disable_chunk_column_stats('zone_map', 'seq_no');
+SELECT * FROM column_stats;
+SELECT disable_chunk_column_stats('zone_map', 'seq_no', if_exists => true);
+SELECT * FROM scanned_chunks('SELECT * FROM zone_map WHERE seq_no = 1000');
@@ -0,0 +1,54 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+\set PREFIX 'EXPLAIN (costs off)'
+
+CREATE TABLE chunkwise_agg(time int NOT NULL, device int, value int);
+SELECT table_name FROM create_hypertable('chunkwise_agg', 'time', 'device', 2, chunk_time_interval => 10000, create_default_indexes => false);
+INSERT INTO chunkwise_agg SELECT t, t % 5, t % 100 FROM generate_series(0, 29999) t;
+ANALYZE chunkwise_agg;
+
+SET max_parallel_workers_per_gather TO 0;
+-- the hash table for all groups does not fit into work_mem, but the hash
+-- tables of the single chunks do
+SET work_mem TO '64kB';
+
+:PREFIX SELECT time_bucket(20, time) AS bucket, sum(value) AS total FROM chunkwise_agg GROUP BY bucket;
+SELECT count(*), sum(bucket), sum(total)
+FROM (SELECT time_bucket(20, time) AS bucket, sum(value) AS total FROM chunkwise_agg GROUP BY bucket) q;
+
+-- HAVING is evaluated by the finalize aggregate
+SELECT count(*), sum(bucket), sum(total)
+FROM (SELECT time_bucket(20, time) AS bucket, sum(value) AS total FROM chunkwise_agg GROUP BY bucket HAVING sum(value) > 1000) q;
+
+-- grouping by the space partitioning column only, every chunk can hold all
+-- groups, which fit into work_mem here
+:PREFIX SELECT device, count(*), sum(value) FROM chunkwise_agg GROUP BY device;
+SELECT device, count(*), sum(value) FROM chunkwise_agg GROUP BY device ORDER BY device;
+SELECT count(*), sum(total)
+FROM (SELECT time_bucket(20, time) AS bucket, device, sum(value) AS total FROM chunkwise_agg GROUP BY bucket, device) q;
+
+-- chunks excluded on startup are not aggregated, also when every chunk is
+-- sorted for its partial aggregate
+SET enable_hashagg TO false;
+:PREFIX SELECT time_bucket(20, time) AS bucket, sum(value) AS total FROM chunkwise_agg WHERE time < length(version()) * 0 + 10000 GROUP BY bucket;
+SELECT count(*), sum(bucket), sum(total)
+FROM (SELECT time_bucket(20, time) AS bucket, sum(value) AS total FROM chunkwise_agg WHERE time < length(version()) * 0 + 10000 GROUP BY bucket) q;
+RESET enable_hashagg;
+SELECT count(*), sum(bucket), sum(total)
+FROM (SELECT time_bucket(20, time) AS bucket, sum(value) AS total FROM chunkwise_agg WHERE time < length(version()) * 0 + 10000 GROUP BY bucket) q;
+
+-- groups over other columns span chunks
+:PREFIX SELECT value, count(*) FROM chunkwise_agg GROUP BY value;
+
+SET timescaledb.enable_chunkwise_aggregation TO false;
+:PREFIX SELECT time_bucket(20, time) AS bucket, sum(value) AS total FROM chunkwise_agg GROUP BY bucket;
+RESET timescaledb.enable_chunkwise_aggregation;
+
+-- no chunkwise aggregation if the hash table of all groups fits into work_mem
+RESET work_mem;
+:PREFIX SELECT time_bucket(20, time) AS bucket, sum(value) AS total FROM chunkwise_agg GROUP BY bucket;
+
+RESET max_parallel_workers_per_gather;
+DROP TABLE chunkwise_agg;
@@ -96,6 +96,45 @@ N,'2020-01-01'
 \.
 \set ON_ERROR_STOP 1
 
+-- Test that rows buffered for multi-inserts get index entries and fire
+-- AFTER ROW triggers, also when switching back and forth between chunks.
+CREATE TABLE copy_buffer(time bigint NOT NULL, value int);
+SELECT create_hypertable('copy_buffer', 'time', chunk_time_interval => 10);
+CREATE TABLE copy_buffer_log(time bigint, value int);
+CREATE FUNCTION copy_buffer_log() RETURNS trigger AS
+$func$
+BEGIN
+    INSERT INTO copy_buffer_log VALUES (NEW.time, NEW.value);
+    RETURN NEW;
+END
+$func$ LANGUAGE plpgsql;
+CREATE TRIGGER copy_buffer_log AFTER INSERT ON copy_buffer
+FOR EACH ROW EXECUTE PROCEDURE copy_buffer_log();
+COPY copy_buffer FROM STDIN DELIMITER ',';
+1,1
+2,2
+11,3
+3,4
+12,5
+21,6
+\.
+SET enable_seqscan TO off;
+SELECT * FROM copy_buffer WHERE time > 0 ORDER BY time;
+RESET enable_seqscan;
+SELECT * FROM copy_buffer_log ORDER BY time;
+
+-- COPY reports how tuples were routed to chunks at DEBUG1. Only one
+-- chunk insert state is kept open, so every switch closes the previous
+-- one. The chunks exist already, so none are created.
+SET client_min_messages TO debug1;
+COPY copy_buffer FROM STDIN DELIMITER ',';
+4,7
+13,8
+5,9
+22,10
+\.
+RESET client_min_messages;
+
 ----------------------------------------------------------------
 -- Testing COPY TO.
 ----------------------------------------------------------------
@@ -44,3 +44,15 @@ FETCH NEXT FROM c1;
 UPDATE cursor_test SET temp = 0.7 WHERE CURRENT OF c1;
 COMMIT;
 
+RESET timescaledb.enable_constraint_exclusion;
+
+-- test cursor with runtime exclusion that is still open after its
+-- savepoint was released
+BEGIN;
+SAVEPOINT s1;
+DECLARE c2 CURSOR FOR SELECT time, device_id FROM cursor_test WHERE time > (SELECT '2000-06-01'::timestamptz) ORDER BY time;
+FETCH NEXT FROM c2;
+RELEASE SAVEPOINT s1;
+FETCH NEXT FROM c2;
+CLOSE c2;
+COMMIT;
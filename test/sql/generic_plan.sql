@@ -0,0 +1,28 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Test that generic plans of prepared statements exclude chunks on
+-- executor startup based on the parameter values of each execution.
+-- The hypertable is still expanded at planning time, so the generic
+-- plan contains all chunks and only their execution is skipped.
+-- plan_cache_mode was introduced in PG12.
+CREATE TABLE generic_plan(time bigint NOT NULL, value int);
+SELECT table_name FROM create_hypertable('generic_plan', 'time', chunk_time_interval => 10, create_default_indexes => false);
+INSERT INTO generic_plan SELECT t, t FROM generate_series(0, 39) t;
+
+SET plan_cache_mode = force_generic_plan;
+PREPARE generic_plan_from(bigint) AS SELECT * FROM generic_plan WHERE time >= $1;
+PREPARE generic_plan_range(bigint, bigint) AS SELECT * FROM generic_plan WHERE time >= $1 AND time < $2;
+
+-- The generic plan has all chunks
+EXPLAIN (costs off) EXECUTE generic_plan_from(0);
+EXPLAIN (analyze, costs off, timing off, summary off) EXECUTE generic_plan_from(25);
+EXPLAIN (analyze, costs off, timing off, summary off) EXECUTE generic_plan_range(12, 18);
+EXECUTE generic_plan_from(37);
+EXECUTE generic_plan_range(8, 11);
+
+DEALLOCATE generic_plan_from;
+DEALLOCATE generic_plan_range;
+RESET plan_cache_mode;
+DROP TABLE generic_plan;
@@ -76,3 +76,25 @@ SELECT _timescaledb_internal.get_partition_for_key(187::numeric);
 SELECT _timescaledb_internal.get_partition_for_key(187::double precision);
 SELECT _timescaledb_internal.get_partition_for_key(int4range(10, 20));
 SELECT _timescaledb_internal.get_partition_hash('08002b:010203'::macaddr);
+
+-- Test routing of tuples to chunks for the space partitioning column
+-- types that are hashed without calling the partitioning function. The
+-- chunk constraints fail any tuple that is routed to the wrong chunk.
+CREATE TABLE hash_int4(time int NOT NULL, device int4);
+CREATE TABLE hash_int8(time int NOT NULL, device int8);
+CREATE TABLE hash_text(time int NOT NULL, device text);
+CREATE TABLE hash_uuid(time int NOT NULL, device uuid);
+SELECT table_name FROM create_hypertable('hash_int4', 'time', 'device', 4, chunk_time_interval => 100);
+SELECT table_name FROM create_hypertable('hash_int8', 'time', 'device', 4, chunk_time_interval => 100);
+SELECT table_name FROM create_hypertable('hash_text', 'time', 'device', 4, chunk_time_interval => 100);
+SELECT table_name FROM create_hypertable('hash_uuid', 'time', 'device', 4, chunk_time_interval => 100);
+INSERT INTO hash_int4 SELECT t, t - 500 FROM generate_series(1, 1000) t;
+INSERT INTO hash_int8 SELECT t, (t - 500) * 10000000000 FROM generate_series(1, 1000) t;
+INSERT INTO hash_text SELECT t, repeat(md5(t::text), t % 100) FROM generate_series(1, 1000) t;
+INSERT INTO hash_uuid SELECT t, md5(t::text)::uuid FROM generate_series(1, 1000) t;
+INSERT INTO hash_int4 VALUES (1, NULL);
+INSERT INTO hash_text VALUES (1, NULL);
+SELECT count(*) FROM hash_int4;
+SELECT count(*) FROM hash_int8;
+SELECT count(*) FROM hash_text;
+SELECT count(*) FROM hash_uuid;
@@ -0,0 +1,55 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+\c :TEST_DBNAME :ROLE_SUPERUSER
+CREATE OR REPLACE FUNCTION ts_test_hypertable_cache_contains(regclass) RETURNS BOOL
+AS :MODULE_PATHNAME LANGUAGE C VOLATILE;
+\c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
+
+-- Test that changes to the metadata of a hypertable only evict that
+-- hypertable from the hypertable cache
+CREATE TABLE cache_a(time int NOT NULL, value int);
+CREATE TABLE cache_b(time int NOT NULL, value int);
+SELECT table_name FROM create_hypertable('cache_a', 'time', chunk_time_interval => 10);
+SELECT table_name FROM create_hypertable('cache_b', 'time', chunk_time_interval => 10);
+
+SELECT count(*) FROM cache_a;
+SELECT count(*) FROM cache_b;
+SELECT ts_test_hypertable_cache_contains('cache_a') AS a, ts_test_hypertable_cache_contains('cache_b') AS b;
+
+-- Changing a dimension
+SELECT set_chunk_time_interval('cache_a', 20);
+SELECT ts_test_hypertable_cache_contains('cache_a') AS a, ts_test_hypertable_cache_contains('cache_b') AS b;
+
+-- Adding a chunk
+SELECT count(*) FROM cache_a;
+INSERT INTO cache_b VALUES (1, 1);
+SELECT ts_test_hypertable_cache_contains('cache_a') AS a, ts_test_hypertable_cache_contains('cache_b') AS b;
+
+-- Dropping a chunk
+SELECT count(*) FROM cache_b;
+SELECT count(*) FROM drop_chunks(10, 'cache_b');
+SELECT ts_test_hypertable_cache_contains('cache_a') AS a, ts_test_hypertable_cache_contains('cache_b') AS b;
+
+-- The evicted hypertable is read again with the new metadata
+SELECT interval_length FROM _timescaledb_catalog.dimension d
+JOIN _timescaledb_catalog.hypertable h ON (h.id = d.hypertable_id)
+WHERE h.table_name = 'cache_a';
+INSERT INTO cache_a VALUES (1, 1), (25, 1);
+SELECT count(*) FROM show_chunks('cache_a');
+
+-- The relid of a hypertable is remembered once its metadata changed,
+-- but DROP TABLE and DROP SCHEMA delete the catalog rows only after the
+-- table itself is gone. Dropping such hypertables must still work.
+DROP TABLE cache_a;
+DROP TABLE cache_b;
+
+\c :TEST_DBNAME :ROLE_SUPERUSER
+CREATE SCHEMA cache_schema;
+CREATE TABLE cache_schema.cache_c(time int NOT NULL, value int);
+SELECT table_name FROM create_hypertable('cache_schema.cache_c', 'time', chunk_time_interval => 10);
+INSERT INTO cache_schema.cache_c VALUES (1, 1);
+SELECT count(*) FROM drop_chunks(10, 'cache_c', 'cache_schema');
+DROP SCHEMA cache_schema CASCADE;
+SELECT count(*) FROM _timescaledb_catalog.hypertable WHERE table_name LIKE 'cache%';
@@ -192,3 +192,41 @@ SELECT * FROM data_records;
 
 \set QUIET on
 ROLLBACK;
+
+-- Test that a multi-row insert with tuples interleaving chunks puts
+-- the tuples in the right chunks and keeps their order within each
+-- chunk
+CREATE TABLE "interleaved" ("time" bigint NOT NULL, "value" integer);
+SELECT create_hypertable('interleaved', 'time', chunk_time_interval => 10);
+INSERT INTO "interleaved" VALUES (1, 1), (11, 2);
+INSERT INTO "interleaved" VALUES (2, 3), (12, 4), (3, 5), (13, 6), (21, 7), (4, 8);
+SELECT tableoid::regclass, * FROM "interleaved" ORDER BY tableoid::regclass::text, ctid;
+
+-- Once the chunks of an insert have insert states, tuples interleaving
+-- chunks are grouped by chunk in batches of 1000. Only the first batch
+-- switches chunks on every tuple.
+CREATE TABLE batched(time bigint NOT NULL, value integer);
+SELECT create_hypertable('batched', 'time', chunk_time_interval => 1000000);
+EXPLAIN (analyze, costs off, timing off)
+INSERT INTO batched
+SELECT (t % 2) * 1000000 + t, t FROM generate_series(1, 4000) t \g | grep -v "Planning" | grep -v "Execution"
+-- Tuples are dispatched in input order if the subplan has volatile
+-- functions anywhere
+EXPLAIN (analyze, costs off, timing off)
+INSERT INTO batched
+SELECT (t % 2) * 1000000 + t, t FROM generate_series(1, 4000) t
+WHERE random() >= 0 LIMIT 4000 \g | grep -v "Planning" | grep -v "Execution"
+-- Row triggers on the chunks see the tuples in input order
+CREATE TABLE batched_log(id serial, value integer);
+CREATE FUNCTION batched_log_insert() RETURNS TRIGGER LANGUAGE PLPGSQL AS
+$BODY$
+BEGIN
+    INSERT INTO batched_log(value) VALUES (NEW.value);
+    RETURN NEW;
+END
+$BODY$;
+CREATE TRIGGER batched_log_insert BEFORE INSERT ON batched
+FOR EACH ROW EXECUTE PROCEDURE batched_log_insert();
+INSERT INTO batched
+SELECT (t % 2) * 1000000 + t, t FROM generate_series(1, 4000) t;
+SELECT count(*) AS logged, count(*) FILTER (WHERE id <> value) AS out_of_order FROM batched_log;
@@ -0,0 +1,41 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- without indexes, each chunk only gets a sequential scan path, so the
+-- number of paths created is the same on all PostgreSQL versions
+CREATE TABLE planner_stats(time int NOT NULL, device int, temp float);
+SELECT create_hypertable('planner_stats', 'time', chunk_time_interval => 10, create_default_indexes => false);
+INSERT INTO planner_stats SELECT t, 1, 1.0 FROM generate_series(0, 29) t;
+
+SET timescaledb.track_planning TO on;
+SELECT _timescaledb_internal.reset_hypertable_planner_stats();
+
+SELECT count(*) FROM planner_stats WHERE time < 10;
+SELECT count(*) FROM planner_stats;
+
+SELECT hypertable, plans, chunks_considered, chunks_excluded, chunks_expanded
+FROM _timescaledb_internal.hypertable_planner_stats();
+
+EXPLAIN (costs off) SELECT * FROM planner_stats WHERE time < 15;
+
+-- the statistics are an element of their own in the structured formats
+CREATE FUNCTION explain_json(query text) RETURNS jsonb LANGUAGE plpgsql AS
+$BODY$
+DECLARE
+    plan jsonb;
+BEGIN
+    EXECUTE 'EXPLAIN (costs off, format json) ' || query INTO plan;
+    RETURN plan;
+END
+$BODY$;
+SELECT jsonb_array_length(plan) AS elements, plan->0 ? 'Plan' AS has_plan, plan->1 AS timescaledb
+FROM explain_json('SELECT * FROM planner_stats WHERE time < 15') plan;
+
+-- no statistics are collected or shown when tracking is disabled
+SET timescaledb.track_planning TO off;
+SELECT _timescaledb_internal.reset_hypertable_planner_stats();
+EXPLAIN (costs off) SELECT * FROM planner_stats WHERE time < 15;
+
+SELECT hypertable, plans, chunks_considered, chunks_excluded, chunks_expanded
+FROM _timescaledb_internal.hypertable_planner_stats();
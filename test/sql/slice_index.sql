@@ -0,0 +1,66 @@
+-- This file and its contents are licensed under the Apache License 2.0.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-APACHE for a copy of the license.
+
+-- Test that finding chunks through the dimension slice index gives the
+-- same chunks as scanning the catalog, also after chunks are added and
+-- dropped.
+CREATE TABLE slice_index(t int NOT NULL, device int NOT NULL, value int);
+SELECT table_name FROM create_hypertable('slice_index', 't', 'device', 2, chunk_time_interval => 10);
+
+-- One device in each space partition
+SELECT min(d) FILTER (WHERE _timescaledb_internal.get_partition_hash(d) < 1073741823) AS dev_a,
+       min(d) FILTER (WHERE _timescaledb_internal.get_partition_hash(d) >= 1073741823) AS dev_b
+FROM generate_series(1, 100) d \gset
+
+-- 8 chunks, even values of t are in the partition of dev_a
+INSERT INTO slice_index
+SELECT t, CASE WHEN t % 2 = 0 THEN :dev_a ELSE :dev_b END, t FROM generate_series(0, 39) t;
+
+SET timescaledb.enable_slice_index = off;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t >= 12 AND t < 33;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE device = :dev_a AND t < 25;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t > 35;
+
+SET timescaledb.enable_slice_index = on;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t >= 12 AND t < 33;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE device = :dev_a AND t < 25;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t > 35;
+
+-- A new chunk invalidates the index built by the query above
+INSERT INTO slice_index SELECT t, :dev_a, t FROM generate_series(40, 44) t;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t > 35;
+SET timescaledb.enable_slice_index = off;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t > 35;
+
+-- So do dropped chunks
+SET timescaledb.enable_slice_index = on;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t < 15;
+SELECT count(*) FROM drop_chunks(10, 'slice_index');
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t < 15;
+SET timescaledb.enable_slice_index = off;
+SELECT count(*), count(DISTINCT tableoid), min(t), max(t) FROM slice_index WHERE t < 15;
+RESET timescaledb.enable_slice_index;
+
+DROP TABLE slice_index;
+
+-- Runtime exclusion uses the slice ranges of the chunks, test values at
+-- the start and end of the ranges, including the end of the last range
+-- that is unbounded
+CREATE TABLE slice_index_rt(time bigint NOT NULL, value int);
+SELECT table_name FROM create_hypertable('slice_index_rt', 'time', chunk_time_interval => 10);
+INSERT INTO slice_index_rt VALUES (0, 0), (9, 1), (10, 2), (19, 3), (9223372036854775806, 4), (9223372036854775807, 5);
+SELECT * FROM slice_index_rt WHERE time = (SELECT 9223372036854775807::bigint) ORDER BY time;
+SELECT * FROM slice_index_rt WHERE time >= (SELECT 9223372036854775807::bigint) ORDER BY time;
+SELECT * FROM slice_index_rt WHERE time > (SELECT 9223372036854775806::bigint) ORDER BY time;
+SELECT * FROM slice_index_rt WHERE time < (SELECT 10::bigint) ORDER BY time;
+SELECT * FROM slice_index_rt WHERE time <= (SELECT 10::bigint) ORDER BY time;
+SELECT v.t, r.value
+FROM (VALUES (9::bigint), (10), (19), (20), (9223372036854775807)) v(t)
+LEFT JOIN LATERAL (SELECT value FROM slice_index_rt r WHERE r.time = v.t ORDER BY r.time LIMIT 1) r ON true
+ORDER BY v.t;
+SET timescaledb.enable_slice_index = off;
+SELECT * FROM slice_index_rt WHERE time = (SELECT 9223372036854775807::bigint) ORDER BY time;
+SELECT * FROM slice_index_rt WHERE time > (SELECT 9223372036854775806::bigint) ORDER BY time;
+RESET timescaledb.enable_slice_index;
+DROP TABLE slice_index_rt;
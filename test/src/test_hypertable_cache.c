@@ -0,0 +1,27 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+
+#include <postgres.h>
+#include <fmgr.h>
+
+#include "export.h"
+#include "hypertable_cache.h"
+
+TS_FUNCTION_INFO_V1(ts_test_hypertable_cache_contains);
+
+/*
+ * Check if a hypertable is in the hypertable cache, without adding it.
+ */
+Datum
+ts_test_hypertable_cache_contains(PG_FUNCTION_ARGS)
+{
+	Cache *hcache = ts_hypertable_cache_pin();
+	Hypertable *ht = ts_hypertable_cache_get_entry(hcache, PG_GETARG_OID(0), CACHE_FLAG_CHECK);
+
+	ts_cache_release(hcache);
+
+	PG_RETURN_BOOL(ht != NULL);
+}
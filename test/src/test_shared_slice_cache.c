@@ -0,0 +1,133 @@
+/*
+ * This file and its contents are licensed under the Apache License 2.0.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-APACHE for a copy of the license.
+ */
+
+#include <postgres.h>
+#include <fmgr.h>
+#include <miscadmin.h>
+#include <storage/lwlock.h>
+
+#include "export.h"
+#include "dimension_slice.h"
+#include "loader/shared_slice_cache.h"
+
+#include "test_utils.h"
+
+TS_FUNCTION_INFO_V1(ts_test_shared_slice_cache);
+
+/* A cache with a single set, so that all keys compete for the same entries */
+static SharedSliceCache *
+test_cache_create(void)
+{
+	SharedSliceCache *cache = palloc0(sizeof(SharedSliceCache));
+	int tranche_id = LWLockNewTrancheId();
+	int i;
+
+	cache->version = SHARED_SLICE_CACHE_VERSION;
+	cache->num_sets = 1;
+	cache->entries = palloc0(sizeof(SharedSliceCacheEntry) * SHARED_SLICE_CACHE_SET_SIZE);
+	cache->locks = palloc0(sizeof(LWLockPadded) * SHARED_SLICE_CACHE_NUM_PARTITIONS);
+
+	for (i = 0; i < SHARED_SLICE_CACHE_SET_SIZE; i++)
+		pg_atomic_init_u32(&cache->entries[i].referenced, 0);
+
+	for (i = 0; i < SHARED_SLICE_CACHE_NUM_PARTITIONS; i++)
+		LWLockInitialize(&cache->locks[i].lock, tranche_id);
+
+	return cache;
+}
+
+static void
+test_key_init(SharedSliceCacheKey *key, TransactionId catalog_xmin, int32 slice_id)
+{
+	memset(key, 0, sizeof(SharedSliceCacheKey));
+	key->dbid = MyDatabaseId;
+	key->catalog_relid = 1;
+	key->catalog_xmin = catalog_xmin;
+	key->slice_id = slice_id;
+}
+
+static void
+test_insert(SharedSliceCache *cache, int32 slice_id)
+{
+	SharedSliceCacheKey key;
+	DimensionSlice *slice = ts_dimension_slice_create(1, slice_id * 10, slice_id * 10 + 10);
+
+	slice->fd.id = slice_id;
+	test_key_init(&key, 100, slice_id);
+	ts_shared_slice_cache_insert(cache, &key, slice);
+}
+
+static bool
+test_find(SharedSliceCache *cache, int32 slice_id)
+{
+	SharedSliceCacheKey key;
+	DimensionSlice slice = { 0 };
+	bool found;
+
+	test_key_init(&key, 100, slice_id);
+	found = ts_shared_slice_cache_find(cache, &key, &slice);
+
+	if (found)
+	{
+		TestAssertInt64Eq(slice.fd.id, slice_id);
+		TestAssertInt64Eq(slice.fd.dimension_id, 1);
+		TestAssertInt64Eq(slice.fd.range_start, slice_id * 10);
+		TestAssertInt64Eq(slice.fd.range_end, slice_id * 10 + 10);
+	}
+
+	return found;
+}
+
+Datum
+ts_test_shared_slice_cache(PG_FUNCTION_ARGS)
+{
+	SharedSliceCache *cache = test_cache_create();
+	SharedSliceCacheKey key;
+	DimensionSlice slice = { 0 };
+	int32 i;
+
+	TestAssertTrue(!test_find(cache, 1));
+	test_insert(cache, 1);
+	TestAssertTrue(test_find(cache, 1));
+
+	/* A slice of another generation of the extension does not match */
+	test_key_init(&key, 200, 1);
+	TestAssertTrue(!ts_shared_slice_cache_find(cache, &key, &slice));
+
+	/* Removing a slice only removes that generation's entry */
+	ts_shared_slice_cache_remove(cache, &key);
+	TestAssertTrue(test_find(cache, 1));
+	test_key_init(&key, 100, 1);
+	ts_shared_slice_cache_remove(cache, &key);
+	TestAssertTrue(!test_find(cache, 1));
+
+	/* Fill the set, reinserting a slice does not use another entry */
+	for (i = 1; i <= SHARED_SLICE_CACHE_SET_SIZE; i++)
+		test_insert(cache, i);
+	test_insert(cache, 1);
+
+	/* The full set replaces the only entry that was not looked up */
+	TestAssertTrue(test_find(cache, 1));
+	TestAssertTrue(test_find(cache, 2));
+	TestAssertTrue(test_find(cache, 4));
+	test_insert(cache, 5);
+	TestAssertTrue(!test_find(cache, 3));
+	TestAssertTrue(test_find(cache, 5));
+
+	/*
+	 * All entries were looked up now, so they all lose their reference and
+	 * the entry picked by the slice ID, i.e., the one of slice 5 that
+	 * replaced slice 3, is replaced.
+	 */
+	test_insert(cache, 6);
+	TestAssertTrue(!test_find(cache, 5));
+	TestAssertTrue(test_find(cache, 6));
+	TestAssertTrue(test_find(cache, 1));
+	TestAssertTrue(test_find(cache, 2));
+	TestAssertTrue(test_find(cache, 4));
+
+	PG_RETURN_VOID();
+}
@@ -21,6 +21,7 @@
 #include "bgw_policy/chunk_stats.h"
 #include "bgw_policy/drop_chunks.h"
 #include "bgw_policy/compress_chunks.h"
+#include "bgw_policy/precreate_chunks.h"
 #include "bgw_policy/reorder.h"
 #include "compression/compress_utils.h"
 #include "continuous_aggs/materialize.h"
@@ -349,6 +350,125 @@ execute_compress_chunks_policy(BgwJob *job)
 	return true;
 }
 
+/*
+ * Create the chunks for the time coordinate already set in the point across
+ * all space partitions, recursing over the closed dimensions starting at
+ * dimidx. Returns the number of chunks that had to be created.
+ */
+static int
+precreate_chunks_for_point(Hypertable *ht, Point *p, int dimidx)
+{
+	Hyperspace *hs = ht->space;
+	Dimension *dim;
+	int64 slice_interval;
+	int created = 0;
+	int i;
+
+	if (dimidx == hs->num_dimensions)
+	{
+		if (ts_hypertable_find_chunk_if_exists(ht, p) != NULL)
+			return 0;
+
+		ts_hypertable_get_or_create_chunk(ht, p);
+		return 1;
+	}
+
+	dim = &hs->dimensions[dimidx];
+
+	if (IS_OPEN_DIMENSION(dim))
+		return precreate_chunks_for_point(ht, p, dimidx + 1);
+
+	/* Pick the lowest value of each slice of the closed dimension */
+	slice_interval = DIMENSION_SLICE_CLOSED_MAX / dim->fd.num_slices;
+
+	for (i = 0; i < dim->fd.num_slices; i++)
+	{
+		p->coordinates[dimidx] = i * slice_interval;
+		created += precreate_chunks_for_point(ht, p, dimidx + 1);
+	}
+
+	return created;
+}
+
+/*
+ * Make sure the chunks covering "now" and the next num_chunks chunk
+ * intervals exist, so that inserts crossing into a new interval do not have
+ * to pay for chunk creation.
+ */
+bool
+execute_precreate_chunks_policy(BgwJob *job)
+{
+	bool started = false;
+	BgwPolicyPrecreateChunks *args;
+	Oid table_relid;
+	Hypertable *ht;
+	Cache *hcache;
+	Dimension *open_dim;
+	Point *p;
+	int open_dimidx = -1;
+	int64 now;
+	int created = 0;
+	int i;
+	int job_id = job->fd.id;
+
+	if (!IsTransactionOrTransactionBlock())
+	{
+		started = true;
+		StartTransactionCommand();
+		PushActiveSnapshot(GetTransactionSnapshot());
+	}
+
+	/* Get the arguments from the precreate_chunks policy table */
+	args = ts_bgw_policy_precreate_chunks_find_by_job(job_id);
+
+	if (args == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_TS_INTERNAL_ERROR),
+				 errmsg("could not run precreate_chunks policy #%d because no args in policy "
+						"table",
+						job_id)));
+
+	table_relid = ts_hypertable_id_to_relid(args->fd.hypertable_id);
+	ht = ts_hypertable_cache_get_cache_and_entry(table_relid, CACHE_FLAG_NONE, &hcache);
+	open_dim = hyperspace_get_open_dimension(ht->space, 0);
+
+	for (i = 0; i < ht->space->num_dimensions; i++)
+		if (&ht->space->dimensions[i] == open_dim)
+			open_dimidx = i;
+
+	Assert(open_dimidx >= 0);
+
+	p = palloc0(POINT_SIZE(ht->space->num_dimensions));
+	p->cardinality = p->num_coords = ht->space->num_dimensions;
+	now = ts_get_now_internal(open_dim);
+
+	for (i = 0; i <= args->fd.num_chunks; i++)
+	{
+		p->coordinates[open_dimidx] = now;
+		created += precreate_chunks_for_point(ht, p, 0);
+
+		if (now > DIMENSION_SLICE_MAXVALUE - open_dim->fd.interval_length)
+			break;
+
+		now += open_dim->fd.interval_length;
+	}
+
+	elog(LOG,
+		 "job %d created %d chunks ahead of time for hypertable \"%s.%s\"",
+		 job_id,
+		 created,
+		 NameStr(ht->fd.schema_name),
+		 NameStr(ht->fd.table_name));
+
+	ts_cache_release(hcache);
+	if (started)
+	{
+		PopActiveSnapshot();
+		CommitTransactionCommand();
+	}
+	return true;
+}
+
 static bool
 bgw_policy_job_check_enterprise_license(BgwJob *job)
 {
@@ -360,6 +480,7 @@ bgw_policy_job_check_enterprise_license(BgwJob *job)
 		case JOB_TYPE_DROP_CHUNKS:
 		case JOB_TYPE_CONTINUOUS_AGGREGATE:
 		case JOB_TYPE_COMPRESS_CHUNKS:
+		case JOB_TYPE_PRECREATE_CHUNKS:
 			required = false;
 			break;
 		default:
@@ -392,6 +513,8 @@ tsl_bgw_policy_job_execute(BgwJob *job)
 			return execute_materialize_continuous_aggregate(job);
 		case JOB_TYPE_COMPRESS_CHUNKS:
 			return execute_compress_chunks_policy(job);
+		case JOB_TYPE_PRECREATE_CHUNKS:
+			return execute_precreate_chunks_policy(job);
 		default:
 			elog(ERROR,
 				 "scheduler tried to run an invalid job type: \"%s\"",
@@ -21,6 +21,7 @@ typedef void (*reorder_func)(Oid tableOid, Oid indexOid, bool verbose, Oid wait_
 extern bool execute_reorder_policy(BgwJob *job, reorder_func reorder, bool fast_continue);
 extern bool execute_drop_chunks_policy(int32 job_id);
 extern bool execute_compress_chunks_policy(BgwJob *job);
+extern bool execute_precreate_chunks_policy(BgwJob *job);
 extern bool tsl_bgw_policy_job_execute(BgwJob *job);
 extern Datum bgw_policy_alter_job_schedule(PG_FUNCTION_ARGS);
 
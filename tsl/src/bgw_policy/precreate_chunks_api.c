@@ -0,0 +1,177 @@
+/*
+ * This file and its contents are licensed under the Timescale License.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-TIMESCALE for a copy of the license.
+ */
+
+#include <postgres.h>
+#include <catalog/pg_type.h>
+#include <miscadmin.h>
+#include <utils/builtins.h>
+#include <utils/lsyscache.h>
+#include <utils/timestamp.h>
+
+#include "bgw_policy/precreate_chunks.h"
+#include "bgw/job.h"
+#include "dimension.h"
+#include "errors.h"
+#include "hypertable.h"
+#include "hypertable_cache.h"
+#include "precreate_chunks_api.h"
+#include "utils.h"
+
+/*
+ * Default scheduled interval for precreate jobs is 1/2 of the chunk time
+ * interval so that the next chunk always exists before it is needed. For
+ * non-timestamp based hypertables the default is 1 day.
+ */
+#define DEFAULT_SCHEDULE_INTERVAL                                                                  \
+	DatumGetIntervalP(DirectFunctionCall3(interval_in, CStringGetDatum("1 day"), InvalidOid, -1))
+/* Default max runtime for a precreate job is unlimited */
+#define DEFAULT_MAX_RUNTIME                                                                        \
+	DatumGetIntervalP(DirectFunctionCall3(interval_in, CStringGetDatum("0"), InvalidOid, -1))
+/* Right now, there is an infinite number of retries for precreate jobs */
+#define DEFAULT_MAX_RETRIES -1
+/* Default retry period for precreate jobs is currently 5 minutes */
+#define DEFAULT_RETRY_PERIOD                                                                       \
+	DatumGetIntervalP(DirectFunctionCall3(interval_in, CStringGetDatum("5 min"), InvalidOid, -1))
+
+static void
+check_valid_time_dimension(Hypertable *ht)
+{
+	Dimension *dim = hyperspace_get_open_dimension(ht->space, 0);
+
+	if (dim == NULL || hyperspace_get_open_dimension(ht->space, 1) != NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("could not add precreate chunks policy because \"%s\" does not have "
+						"exactly one time dimension",
+						get_rel_name(ht->main_table_relid))));
+
+	if (IS_INTEGER_TYPE(ts_dimension_get_partition_type(dim)) &&
+		strlen(NameStr(dim->fd.integer_now_func)) == 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("integer_now_func not set on hypertable \"%s\"",
+						get_rel_name(ht->main_table_relid)),
+				 errhint("Use set_integer_now_func() to set a function that returns the "
+						 "current time of the hypertable.")));
+}
+
+Datum
+precreate_chunks_add_policy(PG_FUNCTION_ARGS)
+{
+	NameData application_name;
+	NameData precreate_chunks_name;
+	int32 job_id;
+	BgwPolicyPrecreateChunks *existing;
+	BgwPolicyPrecreateChunks policy;
+	Interval *default_schedule_interval = DEFAULT_SCHEDULE_INTERVAL;
+	Oid ht_oid = PG_GETARG_OID(0);
+	int32 num_chunks = PG_GETARG_INT32(1);
+	bool if_not_exists = PG_GETARG_BOOL(2);
+	Hypertable *ht;
+	Cache *hcache;
+	Dimension *dim;
+	Oid owner_id;
+
+	owner_id = ts_hypertable_permissions_check(ht_oid, GetUserId());
+
+	if (num_chunks <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("num_chunks must be greater than 0")));
+
+	ht = ts_hypertable_cache_get_cache_and_entry(ht_oid, CACHE_FLAG_NONE, &hcache);
+
+	check_valid_time_dimension(ht);
+
+	/* Verify that the hypertable owner can create a background worker */
+	ts_bgw_job_validate_job_owner(owner_id, JOB_TYPE_PRECREATE_CHUNKS);
+
+	/* Make sure that an existing policy doesn't exist on this hypertable */
+	existing = ts_bgw_policy_precreate_chunks_find_by_hypertable(ht->fd.id);
+
+	if (existing != NULL)
+	{
+		ts_cache_release(hcache);
+
+		if (!if_not_exists)
+			ereport(ERROR,
+					(errcode(ERRCODE_DUPLICATE_OBJECT),
+					 errmsg("precreate chunks policy already exists for hypertable \"%s\"",
+							get_rel_name(ht_oid))));
+
+		if (existing->fd.num_chunks != num_chunks)
+		{
+			elog(WARNING,
+				 "could not add precreate chunks policy due to existing policy on hypertable with "
+				 "different arguments");
+			PG_RETURN_INT32(-1);
+		}
+
+		/* If all arguments are the same, do nothing */
+		ereport(NOTICE,
+				(errmsg("precreate chunks policy already exists on hypertable \"%s\", skipping",
+						get_rel_name(ht_oid))));
+		PG_RETURN_INT32(-1);
+	}
+
+	dim = hyperspace_get_open_dimension(ht->space, 0);
+
+	if (IS_TIMESTAMP_TYPE(ts_dimension_get_partition_type(dim)))
+		default_schedule_interval = DatumGetIntervalP(
+			ts_internal_to_interval_value(dim->fd.interval_length / 2, INTERVALOID));
+
+	/* Insert a new job into jobs table */
+	namestrcpy(&application_name, "Precreate Chunks Background Job");
+	namestrcpy(&precreate_chunks_name, "precreate_chunks");
+	job_id = ts_bgw_job_insert_relation(&application_name,
+										&precreate_chunks_name,
+										default_schedule_interval,
+										DEFAULT_MAX_RUNTIME,
+										DEFAULT_MAX_RETRIES,
+										DEFAULT_RETRY_PERIOD);
+
+	policy = (BgwPolicyPrecreateChunks){ .fd = {
+											 .job_id = job_id,
+											 .hypertable_id = ht->fd.id,
+											 .num_chunks = num_chunks,
+										 } };
+
+	/* Now, insert a new row in the precreate_chunks args table */
+	ts_bgw_policy_precreate_chunks_insert(&policy);
+	ts_cache_release(hcache);
+
+	PG_RETURN_INT32(job_id);
+}
+
+Datum
+precreate_chunks_remove_policy(PG_FUNCTION_ARGS)
+{
+	Oid hypertable_oid = PG_GETARG_OID(0);
+	bool if_exists = PG_GETARG_BOOL(1);
+
+	/* Remove the job, then remove the policy */
+	int ht_id = ts_hypertable_relid_to_id(hypertable_oid);
+	BgwPolicyPrecreateChunks *policy = ts_bgw_policy_precreate_chunks_find_by_hypertable(ht_id);
+
+	ts_hypertable_permissions_check(hypertable_oid, GetUserId());
+
+	if (policy == NULL)
+	{
+		if (!if_exists)
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_OBJECT),
+					 errmsg("cannot remove precreate chunks policy, no such policy exists")));
+
+		ereport(NOTICE,
+				(errmsg("precreate chunks policy does not exist on hypertable \"%s\", skipping",
+						get_rel_name(hypertable_oid))));
+		PG_RETURN_NULL();
+	}
+
+	ts_bgw_job_delete_by_id(policy->fd.job_id);
+
+	PG_RETURN_NULL();
+}
@@ -208,6 +208,46 @@ array_compressor_append(ArrayCompressor *compressor, Datum val)
 	Assert(datum_size_and_align == 0);
 }
 
+/*
+ * Append num_vals non-NULL values. Runs of fixed-width values are serialized
+ * in one go; other types fall back to appending one value at a time.
+ */
+void
+array_compressor_append_many(ArrayCompressor *compressor, const Datum *vals, uint32 num_vals)
+{
+	int16 width = datum_serializer_fixed_width(compressor->serializer);
+	Size offset = compressor->data.num_elements;
+	Size data_length;
+	char *start_ptr;
+	uint32 i;
+
+	if (num_vals == 0)
+		return;
+
+	/* the bulk path cannot handle padding in front of the first value */
+	if (width == 0 ||
+		datum_get_bytes_size(compressor->serializer, offset, vals[0]) - offset != (Size) width)
+	{
+		for (i = 0; i < num_vals; i++)
+			array_compressor_append(compressor, vals[i]);
+		return;
+	}
+
+	for (i = 0; i < num_vals; i++)
+	{
+		simple8brle_compressor_append(&compressor->nulls, 0);
+		simple8brle_compressor_append(&compressor->sizes, width);
+	}
+
+	data_length = (Size) width * num_vals;
+	char_vec_reserve(&compressor->data, data_length);
+	start_ptr = compressor->data.data + compressor->data.num_elements;
+	compressor->data.num_elements += data_length;
+
+	datums_to_bytes_and_advance(compressor->serializer, start_ptr, &data_length, vals, num_vals);
+	Assert(data_length == 0);
+}
+
 typedef struct ArrayCompressorSerializationInfo
 {
 	Simple8bRleSerialized *sizes;
@@ -363,6 +403,50 @@ array_decompression_iterator_alloc_forward(const char *serialized_data, Size dat
 	return &iterator->base;
 }
 
+/*
+ * Decompress all num_values values of a serialized array without NULLs into
+ * values. Fixed-width types are deserialized in one go without consulting the
+ * per-value sizes.
+ */
+void
+array_decompress_all_non_null(const char *serialized_data, Size data_size, Oid element_type,
+							  Datum *values, uint32 num_values)
+{
+	ArrayCompressedData data =
+		array_compressed_data_from_bytes(serialized_data, data_size, element_type, false);
+	DatumDeserializer *deserializer = create_datum_deserializer(element_type);
+	int16 width = datum_deserializer_fixed_width(deserializer);
+	const char *ptr = data.data;
+
+	Assert(data.sizes->num_elements == num_values);
+
+	if (width > 0)
+	{
+		Assert(data.data_len == (Size) width * num_values);
+		bytes_to_datums_and_advance(deserializer, &ptr, values, num_values);
+	}
+	else
+	{
+		Simple8bRleDecompressionIterator sizes;
+		uint32 i;
+
+		simple8brle_decompression_iterator_init_forward(&sizes, data.sizes);
+		for (i = 0; i < num_values; i++)
+		{
+			Simple8bRleDecompressResult datum_size =
+				simple8brle_decompression_iterator_try_next_forward(&sizes);
+			const char *start_pointer = ptr;
+
+			Assert(!datum_size.is_done);
+			values[i] = bytes_to_datum_and_advance(deserializer, &start_pointer);
+			ptr += datum_size.val;
+			Assert(ptr == start_pointer);
+		}
+	}
+
+	Assert(ptr == data.data + data.data_len);
+}
+
 DecompressionIterator *
 tsl_array_decompression_iterator_from_datum_forward(Datum compressed_array, Oid element_type)
 {
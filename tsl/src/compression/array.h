@@ -30,6 +30,8 @@ extern Compressor *array_compressor_for_type(Oid element_type);
 extern ArrayCompressor *array_compressor_alloc(Oid type_to_compress);
 extern void array_compressor_append_null(ArrayCompressor *compressor);
 extern void array_compressor_append(ArrayCompressor *compressor, Datum val);
+extern void array_compressor_append_many(ArrayCompressor *compressor, const Datum *vals,
+										 uint32 num_vals);
 extern void *array_compressor_finish(ArrayCompressor *compressor);
 
 extern ArrayDecompressionIterator *array_decompression_iterator_alloc(void);
@@ -52,6 +54,8 @@ extern char *bytes_serialize_array_compressor_and_advance(char *dst, Size dst_si
 extern DecompressionIterator *
 array_decompression_iterator_alloc_forward(const char *serialized_data, Size data_size,
 										   Oid element_type, bool has_nulls);
+extern void array_decompress_all_non_null(const char *serialized_data, Size data_size,
+										  Oid element_type, Datum *values, uint32 num_values);
 
 typedef struct StringInfoData StringInfoData;
 typedef StringInfoData *StringInfo;
@@ -8,17 +8,29 @@
  *  compress and decompress chunks
  */
 #include <postgres.h>
+#include <access/htup_details.h>
 #include <catalog/dependency.h>
+#include <catalog/indexing.h>
+#include <catalog/pg_statistic.h>
+#include <catalog/pg_type.h>
 #include <commands/trigger.h>
+#include <commands/vacuum.h>
 #include <miscadmin.h>
 #include <nodes/makefuncs.h>
 #include <nodes/pg_list.h>
+#include <storage/bufmgr.h>
 #include <storage/lmgr.h>
 #include <trigger.h>
+#include <utils/acl.h>
+#include <utils/array.h>
 #include <utils/elog.h>
 #include <utils/builtins.h>
+#include <utils/lsyscache.h>
+#include <utils/rel.h>
+#include <utils/syscache.h>
 
 #include "chunk.h"
+#include "chunk_column_stats.h"
 #include "errors.h"
 #include "hypertable.h"
 #include "hypertable_cache.h"
@@ -78,7 +90,8 @@ compute_chunk_size(Oid chunk_relid)
 
 static void
 compression_chunk_size_catalog_insert(int32 src_chunk_id, ChunkSize *src_size,
-									  int32 compress_chunk_id, ChunkSize *compress_size)
+									  int32 compress_chunk_id, ChunkSize *compress_size,
+									  int64 rowcnt_pre_compression, int64 rowcnt_post_compression)
 {
 	Catalog *catalog = ts_catalog_get();
 	Relation rel;
@@ -109,6 +122,10 @@ compression_chunk_size_catalog_insert(int32 src_chunk_id, ChunkSize *src_size,
 		Int64GetDatum(compress_size->toast_size);
 	values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_compressed_index_size)] =
 		Int64GetDatum(compress_size->index_size);
+	values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_numrows_pre_compression)] =
+		Int64GetDatum(rowcnt_pre_compression);
+	values[AttrNumberGetAttrOffset(Anum_compression_chunk_size_numrows_post_compression)] =
+		Int64GetDatum(rowcnt_post_compression);
 
 	ts_catalog_database_info_become_owner(ts_catalog_database_info_get(), &sec_ctx);
 	ts_catalog_insert_values(rel, desc, values, nulls);
@@ -202,6 +219,7 @@ compress_chunk_impl(Oid hypertable_relid, Oid chunk_relid)
 	const ColumnCompressionInfo **colinfo_array;
 	int i = 0, htcols_listlen;
 	ChunkSize before_size, after_size;
+	CompressionStats cstat;
 
 	hcache = ts_hypertable_cache_pin();
 	compresschunkcxt_init(&cxt, hcache, hypertable_relid, chunk_relid);
@@ -228,11 +246,21 @@ compress_chunk_impl(Oid hypertable_relid, Oid chunk_relid)
 		FormData_hypertable_compression *fd = (FormData_hypertable_compression *) lfirst(lc);
 		colinfo_array[i++] = fd;
 	}
+	/*
+	 * The chunk is closed for inserts once it is compressed, so recalculate
+	 * its chunk column stats. Take the lock used for compression first to
+	 * avoid upgrading the lock taken by the calculation.
+	 */
+	if (cxt.srcht->stats_columns != NIL)
+	{
+		LockRelationOid(cxt.srcht_chunk->table_id, ExclusiveLock);
+		ts_chunk_column_stats_calculate(cxt.srcht, cxt.srcht_chunk);
+	}
 	before_size = compute_chunk_size(cxt.srcht_chunk->table_id);
-	compress_chunk(cxt.srcht_chunk->table_id,
-				   compress_ht_chunk->table_id,
-				   colinfo_array,
-				   htcols_listlen);
+	cstat = compress_chunk(cxt.srcht_chunk->table_id,
+						   compress_ht_chunk->table_id,
+						   colinfo_array,
+						   htcols_listlen);
 	/* Drop all FK constraints on the uncompressed chunk. This is needed to allow
 	 * cascading deleted data in FK-referenced tables, while blocking deleting data
 	 * directly on the hypertable or chunks.
@@ -243,7 +271,9 @@ compress_chunk_impl(Oid hypertable_relid, Oid chunk_relid)
 	compression_chunk_size_catalog_insert(cxt.srcht_chunk->fd.id,
 										  &before_size,
 										  compress_ht_chunk->fd.id,
-										  &after_size);
+										  &after_size,
+										  cstat.rowcnt_pre_compression,
+										  cstat.rowcnt_post_compression);
 	ts_chunk_set_compressed_chunk(cxt.srcht_chunk, compress_ht_chunk->fd.id, false);
 	ts_cache_release(hcache);
 }
@@ -351,3 +381,264 @@ tsl_decompress_chunk(PG_FUNCTION_ARGS)
 		PG_RETURN_NULL();
 	PG_RETURN_OID(uncompressed_chunk_id);
 }
+
+/*
+ * Set up the statistics computation for a column of a compressed chunk, like
+ * examine_attribute() in analyze.c. Returns NULL if the column is not to be
+ * analyzed.
+ */
+static VacAttrStats *
+analyze_examine_attribute(Relation rel, int attnum, MemoryContext anl_context)
+{
+	Form_pg_attribute attr = TupleDescAttr(RelationGetDescr(rel), attnum - 1);
+	HeapTuple typtuple;
+	VacAttrStats *stats;
+	bool ok;
+	int i;
+
+	if (attr->attisdropped || attr->attstattarget == 0)
+		return NULL;
+
+	stats = (VacAttrStats *) palloc0(sizeof(VacAttrStats));
+	stats->attr = (Form_pg_attribute) palloc(ATTRIBUTE_FIXED_PART_SIZE);
+	memcpy(stats->attr, attr, ATTRIBUTE_FIXED_PART_SIZE);
+	stats->attrtypid = attr->atttypid;
+	stats->attrtypmod = attr->atttypmod;
+#if PG12_GE
+	stats->attrcollid = attr->attcollation;
+#endif
+
+	typtuple = SearchSysCacheCopy1(TYPEOID, ObjectIdGetDatum(stats->attrtypid));
+	if (!HeapTupleIsValid(typtuple))
+		elog(ERROR, "cache lookup failed for type %u", stats->attrtypid);
+	stats->attrtype = (Form_pg_type) GETSTRUCT(typtuple);
+	stats->anl_context = anl_context;
+	stats->tupattnum = attnum;
+
+	for (i = 0; i < STATISTIC_NUM_SLOTS; i++)
+	{
+		stats->statypid[i] = stats->attrtypid;
+		stats->statyplen[i] = stats->attrtype->typlen;
+		stats->statypbyval[i] = stats->attrtype->typbyval;
+		stats->statypalign[i] = stats->attrtype->typalign;
+	}
+
+	if (OidIsValid(stats->attrtype->typanalyze))
+		ok = DatumGetBool(OidFunctionCall1(stats->attrtype->typanalyze, PointerGetDatum(stats)));
+	else
+		ok = std_typanalyze(stats);
+
+	if (!ok || stats->compute_stats == NULL || stats->minrows <= 0)
+	{
+		heap_freetuple(typtuple);
+		pfree(stats->attr);
+		pfree(stats);
+		return NULL;
+	}
+
+	return stats;
+}
+
+static Datum
+analyze_fetch_func(VacAttrStatsP stats, int rownum, bool *isNull)
+{
+	return heap_getattr(stats->rows[rownum], stats->tupattnum, stats->tupDesc, isNull);
+}
+
+/*
+ * Store the computed statistics of a column in pg_statistic, like
+ * update_attstats() in analyze.c.
+ */
+static void
+analyze_update_attstats(Relation statrel, Oid relid, VacAttrStats *stats)
+{
+	TupleDesc stat_desc = RelationGetDescr(statrel);
+	Datum values[Natts_pg_statistic];
+	bool nulls[Natts_pg_statistic];
+	bool replaces[Natts_pg_statistic];
+	HeapTuple oldtup;
+	HeapTuple stup;
+	int i;
+	int k;
+
+	memset(nulls, false, sizeof(nulls));
+	memset(replaces, true, sizeof(replaces));
+
+	values[Anum_pg_statistic_starelid - 1] = ObjectIdGetDatum(relid);
+	values[Anum_pg_statistic_staattnum - 1] = Int16GetDatum(stats->attr->attnum);
+	values[Anum_pg_statistic_stainherit - 1] = BoolGetDatum(false);
+	values[Anum_pg_statistic_stanullfrac - 1] = Float4GetDatum(stats->stanullfrac);
+	values[Anum_pg_statistic_stawidth - 1] = Int32GetDatum(stats->stawidth);
+	values[Anum_pg_statistic_stadistinct - 1] = Float4GetDatum(stats->stadistinct);
+
+	i = Anum_pg_statistic_stakind1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+		values[i++] = Int16GetDatum(stats->stakind[k]);
+	i = Anum_pg_statistic_staop1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+		values[i++] = ObjectIdGetDatum(stats->staop[k]);
+#if PG12_GE
+	i = Anum_pg_statistic_stacoll1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+		values[i++] = ObjectIdGetDatum(stats->stacoll[k]);
+#endif
+	i = Anum_pg_statistic_stanumbers1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+	{
+		int nnum = stats->numnumbers[k];
+
+		if (nnum > 0)
+		{
+			Datum *numdatums = palloc(nnum * sizeof(Datum));
+			int n;
+
+			for (n = 0; n < nnum; n++)
+				numdatums[n] = Float4GetDatum(stats->stanumbers[k][n]);
+			values[i++] = PointerGetDatum(
+				construct_array(numdatums, nnum, FLOAT4OID, sizeof(float4), FLOAT4PASSBYVAL, 'i'));
+		}
+		else
+		{
+			nulls[i] = true;
+			values[i++] = (Datum) 0;
+		}
+	}
+	i = Anum_pg_statistic_stavalues1 - 1;
+	for (k = 0; k < STATISTIC_NUM_SLOTS; k++)
+	{
+		if (stats->numvalues[k] > 0)
+			values[i++] = PointerGetDatum(construct_array(stats->stavalues[k],
+														  stats->numvalues[k],
+														  stats->statypid[k],
+														  stats->statyplen[k],
+														  stats->statypbyval[k],
+														  stats->statypalign[k]));
+		else
+		{
+			nulls[i] = true;
+			values[i++] = (Datum) 0;
+		}
+	}
+
+	oldtup = SearchSysCache3(STATRELATTINH,
+							 ObjectIdGetDatum(relid),
+							 Int16GetDatum(stats->attr->attnum),
+							 BoolGetDatum(false));
+	if (HeapTupleIsValid(oldtup))
+	{
+		stup = heap_modify_tuple(oldtup, stat_desc, values, nulls, replaces);
+		ReleaseSysCache(oldtup);
+		CatalogTupleUpdate(statrel, &stup->t_self, stup);
+	}
+	else
+	{
+		stup = heap_form_tuple(stat_desc, values, nulls);
+		CatalogTupleInsert(statrel, stup);
+	}
+
+	heap_freetuple(stup);
+}
+
+/*
+ * Compute statistics for a compressed chunk.
+ *
+ * The uncompressed relation of a compressed chunk is empty, so a regular
+ * ANALYZE would leave the planner without any column statistics. Instead, we
+ * take a random sample of the rows stored in the compressed batches and
+ * compute the column statistics of the chunk from it, the same way ANALYZE
+ * does for regular tables. reltuples is set to the number of rows stored in
+ * the batches and relpages to the size of the compressed relation, so that
+ * the tuple density the planner derives from them matches the data that is
+ * actually scanned.
+ */
+void
+tsl_analyze_compressed_chunk(Chunk *chunk)
+{
+	Chunk *compressed_chunk;
+	Relation rel;
+	Relation compressed_rel;
+	Relation statrel;
+	MemoryContext anl_context;
+	MemoryContext col_context;
+	MemoryContext old_context;
+	VacAttrStats **vacattrstats;
+	HeapTuple *rows;
+	double totalrows;
+	int attr_cnt = 0;
+	int targrows = 100;
+	int numrows;
+	int i;
+
+	Assert(chunk->fd.compressed_chunk_id != INVALID_CHUNK_ID);
+
+	/* same permission check as ANALYZE does for regular tables */
+	if (!(pg_class_ownercheck(chunk->table_id, GetUserId()) ||
+		  pg_database_ownercheck(MyDatabaseId, GetUserId())))
+	{
+		ereport(WARNING,
+				(errmsg("skipping \"%s\" --- only table or database owner can analyze it",
+						get_rel_name(chunk->table_id))));
+		return;
+	}
+
+	compressed_chunk = ts_chunk_get_by_id(chunk->fd.compressed_chunk_id, true);
+
+	anl_context = AllocSetContextCreate(CurrentMemoryContext, "Analyze", ALLOCSET_DEFAULT_SIZES);
+	old_context = MemoryContextSwitchTo(anl_context);
+
+	rel = table_open(chunk->table_id, ShareUpdateExclusiveLock);
+	compressed_rel = table_open(compressed_chunk->table_id, AccessShareLock);
+
+	vacattrstats = palloc(RelationGetDescr(rel)->natts * sizeof(VacAttrStats *));
+	for (i = 1; i <= RelationGetDescr(rel)->natts; i++)
+	{
+		VacAttrStats *stats = analyze_examine_attribute(rel, i, anl_context);
+
+		if (stats == NULL)
+			continue;
+		vacattrstats[attr_cnt++] = stats;
+		targrows = Max(targrows, stats->minrows);
+	}
+
+	rows = palloc(targrows * sizeof(HeapTuple));
+	numrows = compressed_chunk_acquire_sample_rows(compressed_rel, rel, rows, targrows, &totalrows);
+
+	if (numrows > 0)
+	{
+		col_context =
+			AllocSetContextCreate(anl_context, "Analyze Column", ALLOCSET_DEFAULT_SIZES);
+		statrel = table_open(StatisticRelationId, RowExclusiveLock);
+
+		for (i = 0; i < attr_cnt; i++)
+		{
+			VacAttrStats *stats = vacattrstats[i];
+
+			stats->rows = rows;
+			stats->tupDesc = RelationGetDescr(rel);
+			MemoryContextSwitchTo(col_context);
+			stats->compute_stats(stats, analyze_fetch_func, numrows, totalrows);
+			MemoryContextSwitchTo(anl_context);
+
+			if (stats->stats_valid)
+				analyze_update_attstats(statrel, chunk->table_id, stats);
+			MemoryContextResetAndDeleteChildren(col_context);
+		}
+
+		table_close(statrel, RowExclusiveLock);
+	}
+
+	vac_update_relstats(rel,
+						RelationGetNumberOfBlocks(compressed_rel),
+						totalrows,
+						0,
+						RelationGetForm(rel)->relhasindex,
+						InvalidTransactionId,
+						InvalidMultiXactId,
+						true);
+
+	table_close(compressed_rel, NoLock);
+	table_close(rel, NoLock);
+
+	MemoryContextSwitchTo(old_context);
+	MemoryContextDelete(anl_context);
+}
@@ -6,8 +6,11 @@
 #ifndef TIMESCALEDB_TSL_COMPRESSION_UTILS_H
 #define TIMESCALEDB_TSL_COMPRESSION_UTILS_H
 
+#include "chunk.h"
+
 extern Datum tsl_compress_chunk(PG_FUNCTION_ARGS);
 extern Datum tsl_decompress_chunk(PG_FUNCTION_ARGS);
 extern bool tsl_compress_chunk_wrapper(Oid chunk_relid, bool if_not_compressed);
+extern void tsl_analyze_compressed_chunk(Chunk *chunk);
 
 #endif // TIMESCALEDB_TSL_COMPRESSION_UTILS_H
@@ -15,6 +15,7 @@
 #include <catalog/pg_type.h>
 #include <catalog/index.h>
 #include <catalog/heap.h>
+#include <commands/vacuum.h>
 #include <executor/tuptable.h>
 #include <funcapi.h>
 #include <libpq/pqformat.h>
@@ -25,6 +26,7 @@
 #include <utils/lsyscache.h>
 #include <utils/memutils.h>
 #include <utils/rel.h>
+#include <utils/sampling.h>
 #include <utils/snapmgr.h>
 #include <utils/syscache.h>
 #include <utils/tuplesort.h>
@@ -133,6 +135,10 @@ typedef struct RowCompressor
 	/* a unique monotonically increasing (according to order by) id for each compressed row */
 	int32 sequence_num;
 
+	/* total number of uncompressed rows consumed and compressed rows produced */
+	int64 rowcnt_pre_compression;
+	int64 num_compressed_rows;
+
 	/* cached arrays used to build the HeapTuple */
 	Datum *compressed_values;
 	bool *compressed_is_null;
@@ -212,10 +218,11 @@ truncate_relation(Oid table_oid)
 	reindex_relation(table_oid, REINDEX_REL_PROCESS_TOAST, 0);
 }
 
-void
+CompressionStats
 compress_chunk(Oid in_table, Oid out_table, const ColumnCompressionInfo **column_compression_info,
 			   int num_compression_infos)
 {
+	CompressionStats cstat;
 	int n_keys;
 	const ColumnCompressionInfo **keys;
 
@@ -261,6 +268,9 @@ compress_chunk(Oid in_table, Oid out_table, const ColumnCompressionInfo **column
 
 	tuplesort_end(sorted_rel);
 
+	cstat.rowcnt_pre_compression = row_compressor.rowcnt_pre_compression;
+	cstat.rowcnt_post_compression = row_compressor.num_compressed_rows;
+
 	truncate_relation(in_table);
 
 	/* Recreate all indexes on out rel, we already have an exclusive lock on it,
@@ -269,6 +279,8 @@ compress_chunk(Oid in_table, Oid out_table, const ColumnCompressionInfo **column
 
 	table_close(out_rel, NoLock);
 	table_close(in_rel, NoLock);
+
+	return cstat;
 }
 
 static int16 *
@@ -485,6 +497,8 @@ row_compressor_init(RowCompressor *row_compressor, TupleDesc uncompressed_tuple_
 		.compressed_is_null = palloc(sizeof(bool) * num_columns_in_compressed_table),
 		.rows_compressed_into_current_value = 0,
 		.sequence_num = SEQUENCE_NUM_GAP,
+		.rowcnt_pre_compression = 0,
+		.num_compressed_rows = 0,
 	};
 
 	memset(row_compressor->compressed_is_null, 1, sizeof(bool) * num_columns_in_compressed_table);
@@ -789,6 +803,9 @@ row_compressor_flush(RowCompressor *row_compressor, CommandId mycid, bool change
 				0 /*=options*/,
 				row_compressor->bistate);
 
+	row_compressor->rowcnt_pre_compression += row_compressor->rows_compressed_into_current_value;
+	row_compressor->num_compressed_rows++;
+
 	/* free the compressed values now that we're done with them (the old compressor is freed in
 	 * finish()) */
 	for (col = 0; col < row_compressor->n_input_columns; col++)
@@ -945,12 +962,17 @@ typedef struct RowDecompressor
 	TupleDesc out_desc;
 	Relation out_rel;
 
+	/* only set up when the decompressed rows are inserted into out_rel */
 	CommandId mycid;
 	BulkInsertState bistate;
 
 	/* cache memory used to store the decompressed datums/is_null for form_tuple */
 	Datum *decompressed_datums;
 	bool *decompressed_is_nulls;
+
+	/* state of the compressed row being decompressed */
+	bool batch_done;
+	int batch_rows;
 } RowDecompressor;
 
 static PerCompressedColumn *create_per_compressed_column(TupleDesc in_desc, TupleDesc out_desc,
@@ -959,10 +981,39 @@ static PerCompressedColumn *create_per_compressed_column(TupleDesc in_desc, Tupl
 static void populate_per_compressed_columns_from_data(PerCompressedColumn *per_compressed_cols,
 													  int16 num_cols, Datum *compressed_datums,
 													  bool *compressed_is_nulls);
+static void row_decompressor_populate(RowDecompressor *row_decompressor,
+									  Datum *compressed_datums, bool *compressed_is_nulls);
+static bool row_decompressor_next_row(RowDecompressor *row_decompressor);
 static void row_decompressor_decompress_row(RowDecompressor *row_decompressor);
 static bool per_compressed_col_get_data(PerCompressedColumn *per_compressed_col,
 										Datum *decompressed_datums, bool *decompressed_is_nulls);
 
+static void
+row_decompressor_init(RowDecompressor *decompressor, Relation in_rel, Relation out_rel)
+{
+	TupleDesc in_desc = RelationGetDescr(in_rel);
+	TupleDesc out_desc = RelationGetDescr(out_rel);
+	Oid compressed_data_type_oid = ts_custom_type_cache_get(CUSTOM_TYPE_COMPRESSED_DATA)->type_oid;
+
+	Assert(in_desc->natts >= out_desc->natts);
+	Assert(OidIsValid(compressed_data_type_oid));
+
+	*decompressor = (RowDecompressor){
+		.per_compressed_cols = create_per_compressed_column(in_desc,
+															out_desc,
+															RelationGetRelid(out_rel),
+															compressed_data_type_oid),
+		.num_compressed_columns = in_desc->natts,
+
+		.out_desc = out_desc,
+		.out_rel = out_rel,
+
+		/* cache memory used to store the decompressed datums/is_null for form_tuple */
+		.decompressed_datums = palloc(sizeof(Datum) * out_desc->natts),
+		.decompressed_is_nulls = palloc(sizeof(bool) * out_desc->natts),
+	};
+}
+
 void
 decompress_chunk(Oid in_table, Oid out_table)
 {
@@ -983,31 +1034,9 @@ decompress_chunk(Oid in_table, Oid out_table)
 	Relation in_rel = relation_open(in_table, ExclusiveLock);
 
 	TupleDesc in_desc = RelationGetDescr(in_rel);
-	TupleDesc out_desc = RelationGetDescr(out_rel);
-
-	Oid compressed_data_type_oid = ts_custom_type_cache_get(CUSTOM_TYPE_COMPRESSED_DATA)->type_oid;
-
-	Assert(in_desc->natts >= out_desc->natts);
-	Assert(OidIsValid(compressed_data_type_oid));
 
 	{
-		RowDecompressor decompressor = {
-			.per_compressed_cols = create_per_compressed_column(in_desc,
-																out_desc,
-																out_table,
-																compressed_data_type_oid),
-			.num_compressed_columns = in_desc->natts,
-
-			.out_desc = out_desc,
-			.out_rel = out_rel,
-
-			.mycid = GetCurrentCommandId(true),
-			.bistate = GetBulkInsertState(),
-
-			/* cache memory used to store the decompressed datums/is_null for form_tuple */
-			.decompressed_datums = palloc(sizeof(Datum) * out_desc->natts),
-			.decompressed_is_nulls = palloc(sizeof(bool) * out_desc->natts),
-		};
+		RowDecompressor decompressor;
 		Datum *compressed_datums = palloc(sizeof(*compressed_datums) * in_desc->natts);
 		bool *compressed_is_nulls = palloc(sizeof(*compressed_is_nulls) * in_desc->natts);
 
@@ -1018,6 +1047,10 @@ decompress_chunk(Oid in_table, Oid out_table)
 								  "decompress chunk per-compressed row",
 								  ALLOCSET_DEFAULT_SIZES);
 
+		row_decompressor_init(&decompressor, in_rel, out_rel);
+		decompressor.mycid = GetCurrentCommandId(true);
+		decompressor.bistate = GetBulkInsertState();
+
 		for (compressed_tuple = heap_getnext(heapScan, ForwardScanDirection);
 			 compressed_tuple != NULL;
 			 compressed_tuple = heap_getnext(heapScan, ForwardScanDirection))
@@ -1029,10 +1062,7 @@ decompress_chunk(Oid in_table, Oid out_table)
 			old_ctx = MemoryContextSwitchTo(per_compressed_row_ctx);
 
 			heap_deform_tuple(compressed_tuple, in_desc, compressed_datums, compressed_is_nulls);
-			populate_per_compressed_columns_from_data(decompressor.per_compressed_cols,
-													  in_desc->natts,
-													  compressed_datums,
-													  compressed_is_nulls);
+			row_decompressor_populate(&decompressor, compressed_datums, compressed_is_nulls);
 
 			row_decompressor_decompress_row(&decompressor);
 			MemoryContextSwitchTo(old_ctx);
@@ -1051,6 +1081,161 @@ decompress_chunk(Oid in_table, Oid out_table)
 	table_close(in_rel, NoLock);
 }
 
+/* A sampled row and its position in the scan order of the chunk */
+typedef struct SampleRow
+{
+	HeapTuple tuple;
+	double position;
+} SampleRow;
+
+static int
+compare_sample_rows(const void *a, const void *b)
+{
+	double pa = ((const SampleRow *) a)->position;
+	double pb = ((const SampleRow *) b)->position;
+
+	if (pa < pb)
+		return -1;
+	if (pa > pb)
+		return 1;
+	return 0;
+}
+
+/*
+ * Acquire a random sample of the rows of a compressed chunk for ANALYZE.
+ *
+ * This works like acquire_sample_rows() in analyze.c, with in_rel being the
+ * compressed relation and the sample returned in the format of the
+ * uncompressed relation out_rel. Reservoir sampling picks the rows uniformly
+ * from all rows of the chunk. The number of rows in a batch is known from its
+ * count metadata, so batches that do not contribute a row to the reservoir
+ * are skipped without detoasting or decompressing them.
+ *
+ * Like acquire_sample_rows(), the sample is returned in the order the rows
+ * are stored, i.e., by compressed tuple and by position within the batch, so
+ * that ANALYZE can compute the correlation of the columns from it.
+ *
+ * Returns the number of rows in the sample, and the total number of rows of
+ * the chunk in *totalrows.
+ */
+int
+compressed_chunk_acquire_sample_rows(Relation in_rel, Relation out_rel, HeapTuple *rows,
+									 int targrows, double *totalrows)
+{
+	TupleDesc in_desc = RelationGetDescr(in_rel);
+	AttrNumber count_attno =
+		get_attnum(RelationGetRelid(in_rel), COMPRESSION_COLUMN_METADATA_COUNT_NAME);
+	MemoryContext sample_ctx = CurrentMemoryContext;
+	MemoryContext per_compressed_row_ctx;
+	Snapshot snapshot;
+	RowDecompressor decompressor;
+	ReservoirStateData rstate;
+	SampleRow *sample;
+	Datum *compressed_datums;
+	bool *compressed_is_nulls;
+	TableScanDesc heapScan;
+	HeapTuple compressed_tuple;
+	int numrows = 0;
+	double samplerows = 0;
+	double rowstoskip = -1;
+
+	if (!AttributeNumberIsValid(count_attno))
+		elog(ERROR, "could not find count column in \"%s\"", RelationGetRelationName(in_rel));
+
+	sample = palloc(sizeof(*sample) * targrows);
+	compressed_datums = palloc(sizeof(*compressed_datums) * in_desc->natts);
+	compressed_is_nulls = palloc(sizeof(*compressed_is_nulls) * in_desc->natts);
+	per_compressed_row_ctx = AllocSetContextCreate(CurrentMemoryContext,
+												   "compressed chunk sample per-compressed row",
+												   ALLOCSET_DEFAULT_SIZES);
+	row_decompressor_init(&decompressor, in_rel, out_rel);
+	reservoir_init_selection_state(&rstate, targrows);
+
+	snapshot = RegisterSnapshot(GetTransactionSnapshot());
+	heapScan = table_beginscan(in_rel, snapshot, 0, (ScanKey) NULL);
+	while ((compressed_tuple = heap_getnext(heapScan, ForwardScanDirection)) != NULL)
+	{
+		bool isnull;
+		Datum count = heap_getattr(compressed_tuple, count_attno, in_desc, &isnull);
+		int batch_rows = isnull ? 0 : DatumGetInt32(count);
+		MemoryContext old_ctx;
+
+		vacuum_delay_point();
+
+		if (numrows >= targrows)
+		{
+			if (rowstoskip < 0)
+				rowstoskip = reservoir_get_next_S(&rstate, samplerows, targrows);
+
+			/* no row of this batch replaces a row in the reservoir */
+			if (rowstoskip >= batch_rows)
+			{
+				rowstoskip -= batch_rows;
+				samplerows += batch_rows;
+				continue;
+			}
+		}
+
+		old_ctx = MemoryContextSwitchTo(per_compressed_row_ctx);
+
+		heap_deform_tuple(compressed_tuple, in_desc, compressed_datums, compressed_is_nulls);
+		row_decompressor_populate(&decompressor, compressed_datums, compressed_is_nulls);
+
+		while (row_decompressor_next_row(&decompressor))
+		{
+			int k = -1;
+
+			if (numrows < targrows)
+				k = numrows++;
+			else
+			{
+				if (rowstoskip < 0)
+					rowstoskip = reservoir_get_next_S(&rstate, samplerows, targrows);
+
+				if (rowstoskip <= 0)
+				{
+					k = (int) (targrows * sampler_random_fract(rstate.randstate));
+					heap_freetuple(sample[k].tuple);
+				}
+				rowstoskip -= 1;
+			}
+
+			/* the sample has to outlive the per-batch memory */
+			if (k >= 0)
+			{
+				MemoryContextSwitchTo(sample_ctx);
+				sample[k].tuple = heap_form_tuple(decompressor.out_desc,
+												  decompressor.decompressed_datums,
+												  decompressor.decompressed_is_nulls);
+				sample[k].position = samplerows;
+				MemoryContextSwitchTo(per_compressed_row_ctx);
+			}
+
+			samplerows += 1;
+		}
+
+		MemoryContextSwitchTo(old_ctx);
+		MemoryContextReset(per_compressed_row_ctx);
+	}
+	heap_endscan(heapScan);
+	UnregisterSnapshot(snapshot);
+	MemoryContextDelete(per_compressed_row_ctx);
+
+	/*
+	 * Rows replaced in the reservoir are out of order, so sort the sample by
+	 * position. If the reservoir was never filled, it is already in order.
+	 */
+	if (numrows == targrows)
+		qsort(sample, numrows, sizeof(*sample), compare_sample_rows);
+
+	for (int i = 0; i < numrows; i++)
+		rows[i] = sample[i].tuple;
+	pfree(sample);
+
+	*totalrows = samplerows;
+	return numrows;
+}
+
 static PerCompressedColumn *
 create_per_compressed_column(TupleDesc in_desc, TupleDesc out_desc, Oid out_relid,
 							 Oid compressed_data_type_oid)
@@ -1141,45 +1326,69 @@ populate_per_compressed_columns_from_data(PerCompressedColumn *per_compressed_co
 	}
 }
 
+/* start decompressing a compressed row */
 static void
-row_decompressor_decompress_row(RowDecompressor *row_decompressor)
+row_decompressor_populate(RowDecompressor *row_decompressor, Datum *compressed_datums,
+						  bool *compressed_is_nulls)
 {
+	populate_per_compressed_columns_from_data(row_decompressor->per_compressed_cols,
+											  row_decompressor->num_compressed_columns,
+											  compressed_datums,
+											  compressed_is_nulls);
+	row_decompressor->batch_done = false;
+	row_decompressor->batch_rows = 0;
+}
+
+/*
+ * Decompress the next row of the current compressed row into
+ * decompressed_datums/decompressed_is_nulls. Returns false once all rows of the
+ * compressed row have been returned.
+ */
+static bool
+row_decompressor_next_row(RowDecompressor *row_decompressor)
+{
+	bool is_done = true;
+
+	if (row_decompressor->batch_done)
+		return false;
+
+	/* we're done if all the decompressors return NULL */
+	for (int16 col = 0; col < row_decompressor->num_compressed_columns; col++)
+	{
+		bool col_is_done =
+			per_compressed_col_get_data(&row_decompressor->per_compressed_cols[col],
+										row_decompressor->decompressed_datums,
+										row_decompressor->decompressed_is_nulls);
+		is_done &= col_is_done;
+	}
+	row_decompressor->batch_done = is_done;
+
 	/* each compressed row decompresses to at least one row,
 	 * even if all the data is NULL
 	 */
-	bool wrote_data = false;
-	bool is_done = false;
-	do
-	{
-		/* we're done if all the decompressors return NULL */
-		is_done = true;
-		for (int16 col = 0; col < row_decompressor->num_compressed_columns; col++)
-		{
-			bool col_is_done =
-				per_compressed_col_get_data(&row_decompressor->per_compressed_cols[col],
-											row_decompressor->decompressed_datums,
-											row_decompressor->decompressed_is_nulls);
-			is_done &= col_is_done;
-		}
+	if (is_done && row_decompressor->batch_rows > 0)
+		return false;
 
-		/* if we're not done we have data to write. even if we're done, each
-		 * compressed should decompress to at least one row, so we should write that
-		 */
-		if (!is_done || !wrote_data)
-		{
-			HeapTuple decompressed_tuple = heap_form_tuple(row_decompressor->out_desc,
-														   row_decompressor->decompressed_datums,
-														   row_decompressor->decompressed_is_nulls);
-			heap_insert(row_decompressor->out_rel,
-						decompressed_tuple,
-						row_decompressor->mycid,
-						0 /*=options*/,
-						row_decompressor->bistate);
-
-			heap_freetuple(decompressed_tuple);
-			wrote_data = true;
-		}
-	} while (!is_done);
+	row_decompressor->batch_rows++;
+	return true;
+}
+
+static void
+row_decompressor_decompress_row(RowDecompressor *row_decompressor)
+{
+	while (row_decompressor_next_row(row_decompressor))
+	{
+		HeapTuple decompressed_tuple = heap_form_tuple(row_decompressor->out_desc,
+													   row_decompressor->decompressed_datums,
+													   row_decompressor->decompressed_is_nulls);
+		heap_insert(row_decompressor->out_rel,
+					decompressed_tuple,
+					row_decompressor->mycid,
+					0 /*=options*/,
+					row_decompressor->bistate);
+
+		heap_freetuple(decompressed_tuple);
+	}
 }
 
 /* populate the relevent index in an array from a per_compressed_col.
@@ -136,9 +136,18 @@ pg_attribute_unused() assert_num_compression_algorithms_sane(void)
 }
 
 extern CompressionStorage compression_get_toast_storage(CompressionAlgorithms algo);
-extern void compress_chunk(Oid in_table, Oid out_table,
-						   const ColumnCompressionInfo **column_compression_info, int num_columns);
+typedef struct CompressionStats
+{
+	int64 rowcnt_pre_compression;
+	int64 rowcnt_post_compression;
+} CompressionStats;
+
+extern CompressionStats compress_chunk(Oid in_table, Oid out_table,
+									   const ColumnCompressionInfo **column_compression_info,
+									   int num_columns);
 extern void decompress_chunk(Oid in_table, Oid out_table);
+extern int compressed_chunk_acquire_sample_rows(Relation in_rel, Relation out_rel, HeapTuple *rows,
+												int targrows, double *totalrows);
 
 extern DecompressionIterator *(*tsl_get_decompression_iterator_init(
 	CompressionAlgorithms algorithm, bool reverse))(Datum, Oid element_type);
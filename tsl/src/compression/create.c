@@ -609,6 +609,7 @@ create_compress_chunk_table(Hypertable *compress_ht, Chunk *src_chunk)
 													 compress_chunk->hypertable_relid);
 
 	ts_chunk_constraints_insert_metadata(compress_chunk->constraints);
+	ts_chunk_invalidate_new(compress_chunk);
 
 	/* Create the actual table relation for the chunk
 	 * Note that we have to pick the tablespace here as the compressed ht doesn't have dimensions
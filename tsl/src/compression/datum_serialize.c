@@ -231,6 +231,82 @@ datum_to_bytes_and_advance(DatumSerializer *serializer, char *ptr, Size *max_siz
 	return ptr;
 }
 
+/*
+ * Fixed-width types whose length is a multiple of their alignment are laid
+ * out back to back without any padding between values. Runs of such values
+ * can be serialized in one go, bypassing the per-datum alignment and varlena
+ * handling. Returns the width of a single value, or 0 if the type does not
+ * qualify.
+ */
+static inline int16
+type_fixed_width(int16 type_len, char type_align)
+{
+	if (type_len <= 0 || att_align_nominal(type_len, type_align) != type_len)
+		return 0;
+
+	return type_len;
+}
+
+int16
+datum_serializer_fixed_width(DatumSerializer *serializer)
+{
+	return type_fixed_width(serializer->type_len, serializer->type_align);
+}
+
+/* Serialize num_vals values of a fixed-width type, see datum_serializer_fixed_width. This reduces
+ * the max_size by the data length before exiting */
+char *
+datums_to_bytes_and_advance(DatumSerializer *serializer, char *ptr, Size *max_size,
+							const Datum *vals, uint32 num_vals)
+{
+	int16 width = datum_serializer_fixed_width(serializer);
+	Size data_length;
+	uint32 i;
+
+	Assert(width > 0);
+
+	ptr = align_and_zero(ptr, serializer->type_align, max_size);
+	data_length = (Size) width * num_vals;
+	check_allowed_data_len(data_length, *max_size);
+
+	if (serializer->type_by_val)
+	{
+		/* same as store_att_byval, with the switch hoisted out of the loop */
+		switch (width)
+		{
+			case sizeof(char):
+				for (i = 0; i < num_vals; i++)
+					ptr[i] = DatumGetChar(vals[i]);
+				break;
+			case sizeof(int16):
+				for (i = 0; i < num_vals; i++)
+					((int16 *) ptr)[i] = DatumGetInt16(vals[i]);
+				break;
+			case sizeof(int32):
+				for (i = 0; i < num_vals; i++)
+					((int32 *) ptr)[i] = DatumGetInt32(vals[i]);
+				break;
+#if SIZEOF_DATUM == 8
+			case sizeof(Datum):
+				memcpy(ptr, vals, data_length);
+				break;
+#endif
+			default:
+				elog(ERROR, "unsupported byval length: %d", (int) width);
+		}
+	}
+	else
+	{
+		for (i = 0; i < num_vals; i++)
+			memcpy(ptr + (Size) i * width, DatumGetPointer(vals[i]), width);
+	}
+
+	ptr += data_length;
+	*max_size = *max_size - data_length;
+
+	return ptr;
+}
+
 typedef struct DatumDeserializer
 {
 	bool type_by_val;
@@ -310,6 +386,64 @@ bytes_to_datum_and_advance(DatumDeserializer *deserializer, const char **ptr)
 	return res;
 }
 
+int16
+datum_deserializer_fixed_width(DatumDeserializer *deserializer)
+{
+	return type_fixed_width(deserializer->type_len, deserializer->type_align);
+}
+
+/*
+ * Deserialize num_vals values of a fixed-width type, see
+ * datum_serializer_fixed_width. By-reference values point into the serialized
+ * data, so no copying is needed.
+ */
+void
+bytes_to_datums_and_advance(DatumDeserializer *deserializer, const char **bytes, Datum *vals,
+							uint32 num_vals)
+{
+	int16 width = datum_deserializer_fixed_width(deserializer);
+	const char *ptr;
+	uint32 i;
+
+	Assert(width > 0);
+
+	ptr = (const char *) att_align_nominal(*bytes, deserializer->type_align);
+
+	if (deserializer->type_by_val)
+	{
+		/* same as fetch_att, with the switch hoisted out of the loop */
+		switch (width)
+		{
+			case sizeof(char):
+				for (i = 0; i < num_vals; i++)
+					vals[i] = CharGetDatum(ptr[i]);
+				break;
+			case sizeof(int16):
+				for (i = 0; i < num_vals; i++)
+					vals[i] = Int16GetDatum(((const int16 *) ptr)[i]);
+				break;
+			case sizeof(int32):
+				for (i = 0; i < num_vals; i++)
+					vals[i] = Int32GetDatum(((const int32 *) ptr)[i]);
+				break;
+#if SIZEOF_DATUM == 8
+			case sizeof(Datum):
+				memcpy(vals, ptr, (Size) width * num_vals);
+				break;
+#endif
+			default:
+				elog(ERROR, "unsupported byval length: %d", (int) width);
+		}
+	}
+	else
+	{
+		for (i = 0; i < num_vals; i++)
+			vals[i] = PointerGetDatum(ptr + (Size) i * width);
+	}
+
+	*bytes = ptr + (Size) width * num_vals;
+}
+
 void
 type_append_to_binary_string(Oid type_oid, StringInfo buffer)
 {
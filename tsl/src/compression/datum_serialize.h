@@ -30,6 +30,11 @@ Size datum_get_bytes_size(DatumSerializer *serializer, Size start_offset, Datum
 char *datum_to_bytes_and_advance(DatumSerializer *serializer, char *start, Size *max_size,
 								 Datum val);
 
+/* bulk serialization of fixed-width types, see datum_serializer_fixed_width */
+int16 datum_serializer_fixed_width(DatumSerializer *serializer);
+char *datums_to_bytes_and_advance(DatumSerializer *serializer, char *start, Size *max_size,
+								  const Datum *vals, uint32 num_vals);
+
 /* serialize to a binary string (for send functions) */
 void type_append_to_binary_string(Oid type_oid, StringInfo data);
 void datum_append_to_binary_string(DatumSerializer *serializer, BinaryStringEncoding encoding,
@@ -42,6 +47,11 @@ DatumDeserializer *create_datum_deserializer(Oid type);
 /* deserialization from bytes in memory */
 Datum bytes_to_datum_and_advance(DatumDeserializer *deserializer, const char **bytes);
 
+/* bulk deserialization of fixed-width types, see datum_deserializer_fixed_width */
+int16 datum_deserializer_fixed_width(DatumDeserializer *deserializer);
+void bytes_to_datums_and_advance(DatumDeserializer *deserializer, const char **bytes, Datum *vals,
+								 uint32 num_vals);
+
 /* deserialization from binary strings (for recv functions) */
 Datum binary_string_to_datum(DatumDeserializer *deserializer, BinaryStringEncoding encoding,
 							 StringInfo data);
@@ -241,10 +241,7 @@ compressor_get_serialization_info(DictionaryCompressor *compressor)
 		sizes.value_array[dict_item->index] = dict_item->key;
 		sizes.num_distinct += 1;
 	}
-	for (int i = 0; i < sizes.num_distinct; i++)
-	{
-		array_compressor_append(array_comp, sizes.value_array[i]);
-	}
+	array_compressor_append_many(array_comp, sizes.value_array, sizes.num_distinct);
 	sizes.dictionary_serialization_info = array_compressor_get_serialization_info(array_comp);
 	sizes.dictionary_size =
 		array_compression_serialization_size(sizes.dictionary_serialization_info);
@@ -351,7 +348,6 @@ dictionary_decompression_iterator_init(DictionaryDecompressionIterator *iter, co
 	Size total_size = VARSIZE(bitmap);
 	Size remaining_size;
 	Simple8bRleSerialized *s8_bitmap;
-	DecompressionIterator *dictionary_iterator;
 
 	*iter = (DictionaryDecompressionIterator){
 		.base = {
@@ -384,19 +380,11 @@ dictionary_decompression_iterator_init(DictionaryDecompressionIterator *iter, co
 
 	remaining_size = total_size - (data - (char *) bitmap);
 
-	dictionary_iterator = array_decompression_iterator_alloc_forward(data,
-																	 remaining_size,
-																	 bitmap->element_type,
-																	 /* has_nulls */ false);
-
-	for (int i = 0; i < bitmap->num_distinct; i++)
-	{
-		DecompressResult res = array_decompression_iterator_try_next_forward(dictionary_iterator);
-		Assert(!res.is_null);
-		Assert(!res.is_done);
-		iter->values[i] = res.val;
-	}
-	Assert(array_decompression_iterator_try_next_forward(dictionary_iterator).is_done);
+	array_decompress_all_non_null(data,
+								  remaining_size,
+								  bitmap->element_type,
+								  iter->values,
+								  bitmap->num_distinct);
 }
 DecompressionIterator *
 tsl_dictionary_decompression_iterator_from_datum_forward(Datum dictionary_compressed,
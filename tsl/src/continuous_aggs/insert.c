@@ -54,6 +54,10 @@
  * multiple can have tuples modified during a single transaction. (And if we
  * move to per-chunk cache-invalidation it makes it even easier).
  *
+ * Inserts through the hypertable do not fire the trigger. Instead, the chunk
+ * insert states track the range of inserted values and update the hashtable
+ * once per chunk and statement via continuous_agg_invalidate_range().
+ *
  */
 typedef struct ContinuousAggsCacheInvalEntry
 {
@@ -194,6 +198,50 @@ update_cache_entry(ContinuousAggsCacheInvalEntry *cache_entry, int64 timeval)
 		cache_entry->greatest_modified_value = timeval;
 }
 
+static ContinuousAggsCacheInvalEntry *
+cache_inval_get_entry(int32 hypertable_id)
+{
+	ContinuousAggsCacheInvalEntry *cache_entry;
+	bool found;
+
+	/* On first call, init the mctx and hash table*/
+	if (!continuous_aggs_cache_inval_htab)
+		cache_inval_init();
+
+	cache_entry = (ContinuousAggsCacheInvalEntry *)
+		hash_search(continuous_aggs_cache_inval_htab, &hypertable_id, HASH_ENTER, &found);
+
+	if (!found)
+		cache_inval_entry_init(cache_entry, hypertable_id);
+
+	return cache_entry;
+}
+
+/*
+ * Get the lowest modified value that needs to be tracked for a hypertable in
+ * the current transaction. Lower values do not invalidate anything.
+ */
+int64
+continuous_agg_invalidation_minimum(int32 hypertable_id)
+{
+	return cache_inval_get_entry(hypertable_id)->minimum_invalidation_time;
+}
+
+/*
+ * Record that values in the range [lowest, greatest] of a hypertable were
+ * modified in the current transaction. This is the same as firing the
+ * trigger for the lowest and greatest modified values.
+ */
+void
+continuous_agg_invalidate_range(int32 hypertable_id, int64 lowest, int64 greatest)
+{
+	ContinuousAggsCacheInvalEntry *cache_entry = cache_inval_get_entry(hypertable_id);
+
+	Assert(lowest <= greatest);
+	update_cache_entry(cache_entry, lowest);
+	update_cache_entry(cache_entry, greatest);
+}
+
 /*
  * Trigger to store what the max/min updated values are for a function.
  * This is used by continuous aggregates to ensure that the aggregated values
@@ -212,7 +260,6 @@ continuous_agg_trigfn(PG_FUNCTION_ARGS)
 	char *hypertable_id_str;
 	int32 hypertable_id;
 	ContinuousAggsCacheInvalEntry *cache_entry;
-	bool found;
 	int64 timeval;
 	if (trigdata->tg_trigger->tgnargs < 0)
 		elog(ERROR, "must supply hypertable id");
@@ -225,15 +272,7 @@ continuous_agg_trigfn(PG_FUNCTION_ARGS)
 	if (!TRIGGER_FIRED_AFTER(trigdata->tg_event) || !TRIGGER_FIRED_FOR_ROW(trigdata->tg_event))
 		elog(ERROR, "continuous agg trigger function must be called in per row after trigger");
 
-	/* On first call, init the mctx and hash table*/
-	if (!continuous_aggs_cache_inval_htab)
-		cache_inval_init();
-
-	cache_entry = (ContinuousAggsCacheInvalEntry *)
-		hash_search(continuous_aggs_cache_inval_htab, &hypertable_id, HASH_ENTER, &found);
-
-	if (!found)
-		cache_inval_entry_init(cache_entry, hypertable_id);
+	cache_entry = cache_inval_get_entry(hypertable_id);
 
 	/* handle the case where we need to repopulate the cached chunk data */
 	if (cache_entry->previous_chunk_relid != trigdata->tg_relation->rd_id)
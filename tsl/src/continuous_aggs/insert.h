@@ -9,6 +9,8 @@
 #include <postgres.h>
 
 extern Datum continuous_agg_trigfn(PG_FUNCTION_ARGS);
+extern int64 continuous_agg_invalidation_minimum(int32 hypertable_id);
+extern void continuous_agg_invalidate_range(int32 hypertable_id, int64 lowest, int64 greatest);
 
 extern void _continuous_aggs_cache_inval_init();
 extern void _continuous_aggs_cache_inval_fini();
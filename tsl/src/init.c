@@ -21,6 +21,7 @@
 #include "bgw_policy/reorder_api.h"
 #include "bgw_policy/drop_chunks_api.h"
 #include "bgw_policy/compress_chunks_api.h"
+#include "bgw_policy/precreate_chunks_api.h"
 #include "compression/compression.h"
 #include "compression/dictionary.h"
 #include "compression/gorilla.h"
@@ -32,6 +33,7 @@
 #include "continuous_aggs/materialize.h"
 #include "continuous_aggs/options.h"
 #include "nodes/decompress_chunk/planner.h"
+#include "nodes/skip_scan/skip_scan.h"
 #include "process_utility.h"
 #include "hypertable.h"
 #include "compression/create.h"
@@ -75,9 +77,11 @@ CrossModuleFunctions tsl_cm_functions = {
 	.add_drop_chunks_policy = drop_chunks_add_policy,
 	.add_reorder_policy = reorder_add_policy,
 	.add_compress_chunks_policy = compress_chunks_add_policy,
+	.add_precreate_chunks_policy = precreate_chunks_add_policy,
 	.remove_drop_chunks_policy = drop_chunks_remove_policy,
 	.remove_reorder_policy = reorder_remove_policy,
 	.remove_compress_chunks_policy = compress_chunks_remove_policy,
+	.remove_precreate_chunks_policy = precreate_chunks_remove_policy,
 	.create_upper_paths_hook = tsl_create_upper_paths_hook,
 	.set_rel_pathlist_dml = tsl_set_rel_pathlist_dml,
 	.set_rel_pathlist_query = tsl_set_rel_pathlist_query,
@@ -97,6 +101,8 @@ CrossModuleFunctions tsl_cm_functions = {
 	.process_cagg_viewstmt = tsl_process_continuous_agg_viewstmt,
 	.continuous_agg_drop_chunks_by_chunk_id = ts_continuous_agg_drop_chunks_by_chunk_id,
 	.continuous_agg_trigfn = continuous_agg_trigfn,
+	.continuous_agg_invalidation_minimum = continuous_agg_invalidation_minimum,
+	.continuous_agg_invalidate_range = continuous_agg_invalidate_range,
 	.continuous_agg_update_options = continuous_agg_update_options,
 	.compressed_data_decompress_forward = tsl_compressed_data_decompress_forward,
 	.compressed_data_decompress_reverse = tsl_compressed_data_decompress_reverse,
@@ -115,6 +121,7 @@ CrossModuleFunctions tsl_cm_functions = {
 	.process_compress_table = tsl_process_compress_table,
 	.compress_chunk = tsl_compress_chunk,
 	.decompress_chunk = tsl_decompress_chunk,
+	.analyze_compressed_chunk = tsl_analyze_compressed_chunk,
 };
 
 TS_FUNCTION_INFO_V1(ts_module_init);
@@ -128,6 +135,7 @@ ts_module_init(PG_FUNCTION_ARGS)
 
 	_continuous_aggs_cache_inval_init();
 	_decompress_chunk_init();
+	_skip_scan_init();
 
 	PG_RETURN_BOOL(true);
 }
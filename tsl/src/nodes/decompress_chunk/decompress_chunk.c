@@ -5,6 +5,7 @@
  */
 
 #include <postgres.h>
+#include <access/sysattr.h>
 #include <catalog/pg_operator.h>
 #include <nodes/bitmapset.h>
 #include <nodes/makefuncs.h>
@@ -28,8 +29,10 @@
 #include <optimizer/optimizer.h>
 #endif
 
+#include "compression_chunk_size.h"
 #include "hypertable_compression.h"
 #include "import/planner.h"
+#include "compression/compression.h"
 #include "compression/create.h"
 #include "nodes/decompress_chunk/decompress_chunk.h"
 #include "nodes/decompress_chunk/planner.h"
@@ -39,6 +42,20 @@
 #define DECOMPRESS_CHUNK_CPU_TUPLE_COST 0.01
 #define DECOMPRESS_CHUNK_BATCH_SIZE 1000
 
+/*
+ * Relative cost of decoding a single value, in multiples of cpu_operator_cost,
+ * indexed by compression algorithm. Gorilla has to do more bit-twiddling per
+ * value than the other algorithms, while array and dictionary mostly copy
+ * values out of the compressed representation.
+ */
+static const double decompress_algorithm_cost_factor[_END_COMPRESSION_ALGORITHMS] = {
+	[_INVALID_COMPRESSION_ALGORITHM] = 0.0,
+	[COMPRESSION_ALGORITHM_ARRAY] = 1.0,
+	[COMPRESSION_ALGORITHM_DICTIONARY] = 1.0,
+	[COMPRESSION_ALGORITHM_GORILLA] = 2.0,
+	[COMPRESSION_ALGORITHM_DELTADELTA] = 1.5,
+};
+
 static CustomPathMethods decompress_chunk_path_methods = {
 	.CustomName = "DecompressChunk",
 	.PlanCustomPath = decompress_chunk_plan_create,
@@ -307,22 +324,110 @@ build_compressioninfo(PlannerInfo *root, Hypertable *ht, RelOptInfo *chunk_rel)
 	return info;
 }
 
+/*
+ * Estimate the number of uncompressed rows per compressed row from the row
+ * counts recorded when the chunk was compressed. Chunks compressed before
+ * those were recorded fall back to the maximum batch size.
+ */
+static double
+estimate_rows_per_batch(Chunk *chunk)
+{
+	int64 rowcnt_pre_compression;
+	int64 rowcnt_post_compression;
+
+	if (ts_compression_chunk_size_row_counts(chunk->fd.id,
+											 &rowcnt_pre_compression,
+											 &rowcnt_post_compression) &&
+		rowcnt_post_compression > 0)
+		return clamp_row_est((double) rowcnt_pre_compression / rowcnt_post_compression);
+
+	return DECOMPRESS_CHUNK_BATCH_SIZE;
+}
+
+static void
+add_column_decompress_cost(CompressionInfo *info, AttrNumber chunk_attno)
+{
+	FormData_hypertable_compression *column_info;
+	char *column_name;
+
+	column_name = get_attname_compat(info->chunk_rte->relid, chunk_attno, false);
+	column_info = get_column_compressioninfo(info->hypertable_compression_info, column_name);
+
+	/* segmentby columns are stored uncompressed and need no decoding */
+	if (column_info == NULL || column_info->segmentby_column_index > 0 ||
+		column_info->algo_id <= 0 || column_info->algo_id >= _END_COMPRESSION_ALGORITHMS)
+		return;
+
+	info->decompress_cost_per_row +=
+		decompress_algorithm_cost_factor[column_info->algo_id] * cpu_operator_cost;
+}
+
+/*
+ * Estimate the per-row cost of decoding all the compressed columns the query
+ * references, either in the targetlist or in the quals.
+ */
+static void
+estimate_decompress_cost_per_row(CompressionInfo *info)
+{
+	RelOptInfo *chunk_rel = info->chunk_rel;
+	Bitmapset *attnos = NULL;
+	ListCell *lc;
+	int attno = -1;
+
+	info->decompress_cost_per_row = 0;
+
+	pull_varattnos((Node *) chunk_rel->reltarget->exprs, chunk_rel->relid, &attnos);
+	foreach (lc, chunk_rel->baserestrictinfo)
+		pull_varattnos((Node *) castNode(RestrictInfo, lfirst(lc))->clause,
+					   chunk_rel->relid,
+					   &attnos);
+
+	/* a whole-row reference needs every column decompressed */
+	if (bms_is_member(0 - FirstLowInvalidHeapAttributeNumber, attnos))
+	{
+		foreach (lc, info->hypertable_compression_info)
+		{
+			FormData_hypertable_compression *fd = lfirst(lc);
+			AttrNumber chunk_attno = get_attnum(info->chunk_rte->relid, NameStr(fd->attname));
+
+			add_column_decompress_cost(info, chunk_attno);
+		}
+		return;
+	}
+
+	while ((attno = bms_next_member(attnos, attno)) >= 0)
+	{
+		AttrNumber chunk_attno = attno + FirstLowInvalidHeapAttributeNumber;
+
+		if (chunk_attno <= 0)
+			continue;
+
+		add_column_decompress_cost(info, chunk_attno);
+	}
+}
+
 /*
  * calculate cost for DecompressChunkPath
  *
  * since we have to read whole batch before producing tuple
  * we put cost of 1 tuple of compressed_scan as startup cost
+ *
+ * every produced row pays the per-tuple overhead plus the cost of decoding
+ * each referenced compressed column
  */
 static void
-cost_decompress_chunk(Path *path, Path *compressed_path)
+cost_decompress_chunk(Path *path, Path *compressed_path, CompressionInfo *info)
 {
+	Cost cost_per_row = DECOMPRESS_CHUNK_CPU_TUPLE_COST + info->decompress_cost_per_row;
+
+	path->rows = compressed_path->rows * info->rows_per_batch;
+
 	/* startup_cost is cost before fetching first tuple */
 	if (compressed_path->rows > 0)
 		path->startup_cost = compressed_path->total_cost / compressed_path->rows;
 
 	/* total_cost is cost for fetching all tuples */
-	path->total_cost = compressed_path->total_cost + path->rows * DECOMPRESS_CHUNK_CPU_TUPLE_COST;
-	path->rows = compressed_path->rows * DECOMPRESS_CHUNK_BATCH_SIZE;
+	path->total_cost = compressed_path->total_cost + path->rows * cost_per_row;
 }
 
 void
@@ -364,7 +469,9 @@ ts_decompress_chunk_generate_paths(PlannerInfo *root, RelOptInfo *chunk_rel, Hyp
 	/* translate chunk_rel->baserestrictinfo */
 	pushdown_quals(root, chunk_rel, compressed_rel, info->hypertable_compression_info);
 	set_baserel_size_estimates(root, compressed_rel);
-	new_row_estimate = compressed_rel->rows * DECOMPRESS_CHUNK_BATCH_SIZE;
+	info->rows_per_batch = estimate_rows_per_batch(chunk);
+	estimate_decompress_cost_per_row(info);
+	new_row_estimate = compressed_rel->rows * info->rows_per_batch;
 	/* adjust the parent's estimate by the diff of new and old estimate */
 	hypertable_rel->rows += (new_row_estimate - chunk_rel->rows);
 	chunk_rel->rows = new_row_estimate;
@@ -422,7 +529,7 @@ ts_decompress_chunk_generate_paths(PlannerInfo *root, RelOptInfo *chunk_rel, Hyp
 						  0.0,
 						  work_mem,
 						  -1);
-				cost_decompress_chunk(&dcpath->cpath.path, &sort_path);
+				cost_decompress_chunk(&dcpath->cpath.path, &sort_path, info);
 			}
 			add_path(chunk_rel, &dcpath->cpath.path);
 		}
@@ -965,7 +1072,7 @@ decompress_chunk_path_create(PlannerInfo *root, CompressionInfo *info, int paral
 	path->cpath.custom_paths = list_make1(compressed_path);
 	path->reverse = false;
 	path->compressed_pathkeys = NIL;
-	cost_decompress_chunk(&path->cpath.path, compressed_path);
+	cost_decompress_chunk(&path->cpath.path, compressed_path, info);
 
 	return path;
 }
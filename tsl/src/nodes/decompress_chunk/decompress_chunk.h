@@ -34,6 +34,11 @@ typedef struct CompressionInfo
 	/* compressed chunk attribute numbers for columns that are compressed */
 	Bitmapset *compressed_chunk_compressed_attnos;
 
+	/* average number of uncompressed rows stored in one compressed row */
+	double rows_per_batch;
+	/* cpu cost of decompressing the referenced columns of one row */
+	Cost decompress_cost_per_row;
+
 } CompressionInfo;
 
 typedef struct DecompressChunkPath
@@ -19,6 +19,12 @@
 #include <utils/typcache.h>
 
 #include "compat.h"
+#if PG12_LT
+#include <optimizer/var.h>
+#else
+#include <optimizer/optimizer.h>
+#endif
+
 #include "compression/array.h"
 #include "compression/compression.h"
 #include "nodes/decompress_chunk/decompress_chunk.h"
@@ -50,6 +56,17 @@ typedef struct DecompressChunkColumnState
 		struct
 		{
 			DecompressionIterator *iterator;
+			/*
+			 * Lazy columns are not referenced by the quals of this node. They
+			 * are only detoasted and decoded once a row of the batch passes the
+			 * quals, so batches that are filtered out entirely never fetch the
+			 * (potentially large) TOASTed data for these columns.
+			 */
+			bool lazy;
+			/* compressed datum of the current batch, detoasted on first use */
+			Datum value;
+			/* number of rows produced for the batch not yet read from the iterator */
+			int pending;
 		} compressed;
 	};
 } DecompressChunkColumnState;
@@ -67,6 +84,7 @@ typedef struct DecompressChunkState
 	Oid chunk_relid;
 	List *hypertable_compression_info;
 	int counter;
+	bool has_lazy_columns;
 	MemoryContext per_batch_context;
 } DecompressChunkState;
 
@@ -75,6 +93,7 @@ static void decompress_chunk_begin(CustomScanState *node, EState *estate, int ef
 static void decompress_chunk_end(CustomScanState *node);
 static void decompress_chunk_rescan(CustomScanState *node);
 static TupleTableSlot *decompress_chunk_create_tuple(DecompressChunkState *state);
+static void decompress_chunk_fill_lazy_columns(DecompressChunkState *state, TupleTableSlot *slot);
 
 static CustomExecMethods decompress_chunk_state_methods = {
 	.BeginCustomScan = decompress_chunk_begin,
@@ -114,9 +133,22 @@ initialize_column_state(DecompressChunkState *state)
 {
 	ScanState *ss = (ScanState *) state;
 	TupleDesc desc = ss->ss_ScanTupleSlot->tts_tupleDescriptor;
+	Plan *plan = ss->ps.plan;
+	Bitmapset *qual_attnos = NULL;
+	bool lazy_allowed;
 	ListCell *lc;
 	int i;
 
+	/*
+	 * Columns not referenced in the quals can be decompressed lazily. Without
+	 * quals every row gets returned so there is nothing to gain, and whole-row
+	 * references need all columns.
+	 */
+	pull_varattnos((Node *) plan->qual, ((Scan *) plan)->scanrelid, &qual_attnos);
+	lazy_allowed =
+		plan->qual != NIL &&
+		!bms_is_member(InvalidAttrNumber - FirstLowInvalidHeapAttributeNumber, qual_attnos);
+
 	state->num_columns = list_length(state->varattno_map);
 
 	state->columns = palloc0(state->num_columns * sizeof(DecompressChunkColumnState));
@@ -140,7 +172,15 @@ initialize_column_state(DecompressChunkState *state)
 			if (ht_info->segmentby_column_index > 0)
 				column->type = SEGMENTBY_COLUMN;
 			else
+			{
 				column->type = COMPRESSED_COLUMN;
+				column->compressed.lazy =
+					lazy_allowed &&
+					!bms_is_member(column->attno - FirstLowInvalidHeapAttributeNumber,
+								   qual_attnos);
+				if (column->compressed.lazy)
+					state->has_lazy_columns = true;
+			}
 		}
 		else
 		{
@@ -256,6 +296,25 @@ decompress_chunk_begin(CustomScanState *node, EState *estate, int eflags)
 													 ALLOCSET_DEFAULT_SIZES);
 }
 
+/*
+ * Detoast the compressed datum of a column and set up its decompression
+ * iterator. Must be called in the per-batch memory context.
+ */
+static void
+initialize_compressed_column_iterator(DecompressChunkState *state,
+									  DecompressChunkColumnState *column)
+{
+	CompressedDataHeader *header =
+		(CompressedDataHeader *) PG_DETOAST_DATUM(column->compressed.value);
+
+	Assert(column->type == COMPRESSED_COLUMN);
+	Assert(column->compressed.value != (Datum) 0);
+
+	column->compressed.iterator =
+		tsl_get_decompression_iterator_init(header->compression_algorithm,
+											state->reverse)(PointerGetDatum(header), column->typid);
+}
+
 static void
 initialize_batch(DecompressChunkState *state, TupleTableSlot *slot)
 {
@@ -274,17 +333,17 @@ initialize_batch(DecompressChunkState *state, TupleTableSlot *slot)
 			case COMPRESSED_COLUMN:
 			{
 				value = slot_getattr(slot, AttrOffsetGetAttrNumber(i), &isnull);
-				if (!isnull)
-				{
-					CompressedDataHeader *header = (CompressedDataHeader *) PG_DETOAST_DATUM(value);
+				column->compressed.iterator = NULL;
+				column->compressed.pending = 0;
+				column->compressed.value = isnull ? (Datum) 0 : value;
 
-					column->compressed.iterator =
-						tsl_get_decompression_iterator_init(header->compression_algorithm,
-															state->reverse)(PointerGetDatum(header),
-																			column->typid);
-				}
-				else
-					column->compressed.iterator = NULL;
+				/*
+				 * The compressed datum stays valid until we fetch the next
+				 * tuple from the child node, which only happens once this batch
+				 * is done, so lazy columns can defer detoasting.
+				 */
+				if (!isnull && !column->compressed.lazy)
+					initialize_compressed_column_iterator(state, column);
 
 				break;
 			}
@@ -362,6 +421,9 @@ decompress_chunk_exec(CustomScanState *node)
 			continue;
 		}
 
+		if (state->has_lazy_columns)
+			decompress_chunk_fill_lazy_columns(state, slot);
+
 		if (!node->ss.ps.ps_ProjInfo)
 			return slot;
 
@@ -438,7 +500,13 @@ decompress_chunk_create_tuple(DecompressChunkState *state)
 				{
 					AttrNumber attr = AttrNumberGetAttrOffset(column->attno);
 
-					if (column->compressed.iterator != NULL)
+					if (column->compressed.lazy)
+					{
+						/* filled in by decompress_chunk_fill_lazy_columns if the row qualifies */
+						column->compressed.pending++;
+						slot->tts_isnull[attr] = true;
+					}
+					else if (column->compressed.iterator != NULL)
 					{
 						DecompressResult result;
 						result = column->compressed.iterator->try_next(column->compressed.iterator);
@@ -494,3 +562,59 @@ decompress_chunk_create_tuple(DecompressChunkState *state)
 		return slot;
 	}
 }
+
+/*
+ * Fill in the values of lazy columns for a row that passed the quals.
+ *
+ * Rows of the batch that were filtered out before this one were never read
+ * from the iterators of lazy columns, so skip over them first. The iterator
+ * itself, and with it the detoasting of the compressed datum, is only set up
+ * the first time a row of the batch qualifies.
+ */
+static void
+decompress_chunk_fill_lazy_columns(DecompressChunkState *state, TupleTableSlot *slot)
+{
+	MemoryContext old_context = NULL;
+	int i;
+
+	for (i = 0; i < state->num_columns; i++)
+	{
+		DecompressChunkColumnState *column = &state->columns[i];
+		AttrNumber attr;
+		DecompressResult result;
+
+		if (column->type != COMPRESSED_COLUMN || !column->compressed.lazy)
+			continue;
+
+		Assert(column->compressed.pending > 0);
+		attr = AttrNumberGetAttrOffset(column->attno);
+
+		if (column->compressed.value == (Datum) 0)
+		{
+			/* all values of this column are NULL in this batch */
+			column->compressed.pending = 0;
+			slot->tts_isnull[attr] = true;
+			continue;
+		}
+
+		if (old_context == NULL)
+			old_context = MemoryContextSwitchTo(state->per_batch_context);
+
+		if (column->compressed.iterator == NULL)
+			initialize_compressed_column_iterator(state, column);
+
+		do
+		{
+			result = column->compressed.iterator->try_next(column->compressed.iterator);
+
+			if (result.is_done)
+				elog(ERROR, "compressed column out of sync with batch counter");
+		} while (--column->compressed.pending > 0);
+
+		slot->tts_values[attr] = result.val;
+		slot->tts_isnull[attr] = result.is_null;
+	}
+
+	if (old_context != NULL)
+		MemoryContextSwitchTo(old_context);
+}
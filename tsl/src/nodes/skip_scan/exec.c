@@ -0,0 +1,270 @@
+/*
+ * This file and its contents are licensed under the Timescale License.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-TIMESCALE for a copy of the license.
+ */
+#include <postgres.h>
+#include <access/skey.h>
+#include <executor/executor.h>
+#include <nodes/execnodes.h>
+#include <nodes/extensible.h>
+#include <utils/datum.h>
+#include <utils/memutils.h>
+
+#include "compat.h"
+#include "nodes/skip_scan/skip_scan.h"
+
+/*
+ * The scan over the distinct column proceeds in stages. NULL values are
+ * distinct from all other values, but cannot be skipped with a comparison,
+ * so the NULL value is searched for separately before or after the
+ * non-NULL values, depending on where the index scan returns NULLs.
+ */
+typedef enum SkipScanStage
+{
+	SS_BEGIN,
+	SS_NULLS_FIRST,
+	SS_NOT_NULL,
+	SS_NULLS_LAST,
+	SS_END,
+} SkipScanStage;
+
+typedef struct SkipScanState
+{
+	CustomScanState csstate;
+	Plan *index_plan;
+	PlanState *index_state;
+	/* The scan key of the index scan that skips past the last distinct value */
+	ScanKey skip_key;
+	int skip_key_flags;
+	/* Position and type of the distinct column in the tuples of the index scan */
+	AttrNumber distinct_attno;
+	int16 distinct_typlen;
+	bool distinct_typbyval;
+	bool nulls_first;
+	/* Position of the distinct column in the index */
+	AttrNumber distinct_index_attno;
+	SkipScanStage stage;
+	/* Set if the index scan has to be restarted before fetching the next tuple */
+	bool needs_rescan;
+	/* Memory for the last distinct value */
+	MemoryContext value_context;
+} SkipScanState;
+
+static void
+skip_scan_search_null(SkipScanState *state, bool isnull)
+{
+	state->skip_key->sk_flags =
+		state->skip_key_flags | SK_ISNULL | (isnull ? SK_SEARCHNULL : SK_SEARCHNOTNULL);
+	state->skip_key->sk_argument = (Datum) 0;
+	state->needs_rescan = true;
+}
+
+static void
+skip_scan_search_after(SkipScanState *state, Datum value)
+{
+	MemoryContext old;
+
+	MemoryContextReset(state->value_context);
+	old = MemoryContextSwitchTo(state->value_context);
+	state->skip_key->sk_argument =
+		datumCopy(value, state->distinct_typbyval, state->distinct_typlen);
+	MemoryContextSwitchTo(old);
+
+	state->skip_key->sk_flags = state->skip_key_flags;
+	state->needs_rescan = true;
+}
+
+static void
+skip_scan_begin(CustomScanState *node, EState *estate, int eflags)
+{
+	SkipScanState *state = (SkipScanState *) node;
+	ScanKey scan_keys;
+	int num_scan_keys;
+	int i;
+
+	state->index_state = ExecInitNode(state->index_plan, estate, eflags);
+	node->custom_ps = list_make1(state->index_state);
+
+#if PG12_GE
+	/*
+	 * The tuples returned are the ones of the index scan, so the scan slot
+	 * ops are not fixed, see ca_append_begin().
+	 */
+	node->ss.ps.scanopsfixed = false;
+	node->ss.ps.resultopsfixed = false;
+	ExecAssignScanProjectionInfoWithVarno(&node->ss, INDEX_VAR);
+#endif
+
+	/* Scan keys are not set up for EXPLAIN */
+	if (eflags & EXEC_FLAG_EXPLAIN_ONLY)
+		return;
+
+	switch (nodeTag(state->index_state))
+	{
+		case T_IndexScanState:
+			scan_keys = castNode(IndexScanState, state->index_state)->iss_ScanKeys;
+			num_scan_keys = castNode(IndexScanState, state->index_state)->iss_NumScanKeys;
+			break;
+		case T_IndexOnlyScanState:
+			scan_keys = castNode(IndexOnlyScanState, state->index_state)->ioss_ScanKeys;
+			num_scan_keys = castNode(IndexOnlyScanState, state->index_state)->ioss_NumScanKeys;
+			break;
+		default:
+			elog(ERROR, "invalid child of skip scan: %u", nodeTag(state->index_state));
+			pg_unreachable();
+	}
+
+	/*
+	 * The planner added the skip qual after the other quals on the distinct
+	 * column, so it is the last scan key on that column.
+	 */
+	state->skip_key = NULL;
+	for (i = 0; i < num_scan_keys; i++)
+	{
+		if (scan_keys[i].sk_attno == state->distinct_index_attno)
+			state->skip_key = &scan_keys[i];
+	}
+
+	if (state->skip_key == NULL)
+		elog(ERROR, "skip key not found in index scan of skip scan");
+
+	state->skip_key_flags = state->skip_key->sk_flags & ~SK_ISNULL;
+	state->value_context =
+		AllocSetContextCreate(CurrentMemoryContext, "SkipScan value", ALLOCSET_DEFAULT_SIZES);
+	state->stage = SS_BEGIN;
+}
+
+static TupleTableSlot *
+skip_scan_exec(CustomScanState *node)
+{
+	SkipScanState *state = (SkipScanState *) node;
+	ExprContext *econtext = node->ss.ps.ps_ExprContext;
+	TupleTableSlot *slot;
+
+	for (;;)
+	{
+		switch (state->stage)
+		{
+			case SS_BEGIN:
+				state->stage = state->nulls_first ? SS_NULLS_FIRST : SS_NOT_NULL;
+				skip_scan_search_null(state, state->nulls_first);
+				break;
+			case SS_END:
+				return NULL;
+			default:
+				break;
+		}
+
+		/*
+		 * Restarting the index scan clears its slots, so this is only done
+		 * once the previously returned tuple is no longer needed.
+		 */
+		if (state->needs_rescan)
+		{
+			ExecReScan(state->index_state);
+			state->needs_rescan = false;
+		}
+
+		slot = ExecProcNode(state->index_state);
+
+		if (TupIsNull(slot))
+		{
+			if (state->stage == SS_NULLS_FIRST)
+			{
+				state->stage = SS_NOT_NULL;
+				skip_scan_search_null(state, false);
+			}
+			else if (state->stage == SS_NOT_NULL && !state->nulls_first)
+			{
+				state->stage = SS_NULLS_LAST;
+				skip_scan_search_null(state, true);
+			}
+			else
+				state->stage = SS_END;
+
+			continue;
+		}
+
+		switch (state->stage)
+		{
+			case SS_NULLS_FIRST:
+				state->stage = SS_NOT_NULL;
+				skip_scan_search_null(state, false);
+				break;
+			case SS_NOT_NULL:
+			{
+				bool isnull;
+				Datum value = slot_getattr(slot, state->distinct_attno, &isnull);
+
+				Assert(!isnull);
+				skip_scan_search_after(state, value);
+				break;
+			}
+			case SS_NULLS_LAST:
+				state->stage = SS_END;
+				break;
+			default:
+				Assert(false);
+				break;
+		}
+
+		if (node->ss.ps.ps_ProjInfo == NULL)
+			return slot;
+
+		ResetExprContext(econtext);
+		econtext->ecxt_scantuple = slot;
+
+#if PG96
+		{
+			ExprDoneCond isDone;
+
+			return ExecProject(node->ss.ps.ps_ProjInfo, &isDone);
+		}
+#else
+		return ExecProject(node->ss.ps.ps_ProjInfo);
+#endif
+	}
+}
+
+static void
+skip_scan_end(CustomScanState *node)
+{
+	SkipScanState *state = (SkipScanState *) node;
+
+	ExecEndNode(state->index_state);
+}
+
+static void
+skip_scan_rescan(CustomScanState *node)
+{
+	SkipScanState *state = (SkipScanState *) node;
+
+	/* The index scan is restarted when the first tuple is fetched */
+	state->stage = SS_BEGIN;
+}
+
+static CustomExecMethods skip_scan_state_methods = {
+	.CustomName = "SkipScan",
+	.BeginCustomScan = skip_scan_begin,
+	.ExecCustomScan = skip_scan_exec,
+	.EndCustomScan = skip_scan_end,
+	.ReScanCustomScan = skip_scan_rescan,
+};
+
+Node *
+tsl_skip_scan_state_create(CustomScan *cscan)
+{
+	SkipScanState *state = (SkipScanState *) newNode(sizeof(SkipScanState), T_CustomScanState);
+	List *settings = linitial(cscan->custom_private);
+
+	state->csstate.methods = &skip_scan_state_methods;
+	state->index_plan = linitial(cscan->custom_plans);
+	state->distinct_attno = linitial_int(settings);
+	state->distinct_typlen = lsecond_int(settings);
+	state->distinct_typbyval = lthird_int(settings);
+	state->nulls_first = lfourth_int(settings);
+	state->distinct_index_attno = list_nth_int(settings, 4);
+
+	return (Node *) state;
+}
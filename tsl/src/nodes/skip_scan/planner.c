@@ -0,0 +1,554 @@
+/*
+ * This file and its contents are licensed under the Timescale License.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-TIMESCALE for a copy of the license.
+ */
+#include <postgres.h>
+#include <access/stratnum.h>
+#include <catalog/pg_am.h>
+#include <catalog/pg_type.h>
+#include <nodes/extensible.h>
+#include <nodes/makefuncs.h>
+#include <nodes/nodeFuncs.h>
+#include <optimizer/cost.h>
+#include <optimizer/pathnode.h>
+#include <optimizer/paths.h>
+#include <utils/lsyscache.h>
+#include <utils/selfuncs.h>
+
+#include "compat.h"
+#if PG12_LT
+#include <optimizer/clauses.h>
+#else
+#include <optimizer/optimizer.h>
+#endif
+
+#include "nodes/skip_scan/skip_scan.h"
+#include "chunk_append/chunk_append.h"
+#include "constraint_aware_append.h"
+#include "guc.h"
+
+typedef struct SkipScanPath
+{
+	CustomPath cpath;
+	IndexPath *index_path;
+	/* The index column of the distinct column */
+	int indexcol;
+	/* The column in the scanned relation */
+	Var *distinct_var;
+	/* Operator that finds the values following a distinct value in scan order */
+	Oid skip_opno;
+	/* Whether NULL values come first in scan order */
+	bool nulls_first;
+} SkipScanPath;
+
+static CustomScanMethods skip_scan_plan_methods = {
+	.CustomName = "SkipScan",
+	.CreateCustomScanState = tsl_skip_scan_state_create,
+};
+
+void
+_skip_scan_init(void)
+{
+	/*
+	 * The tsl module is reinitialized when the license changes, so only
+	 * register the node once per session.
+	 */
+	if (GetCustomScanMethods(skip_scan_plan_methods.CustomName, true) == NULL)
+		RegisterCustomScanMethods(&skip_scan_plan_methods);
+}
+
+/*
+ * Get the index column that an index qual restricts. The index column is on
+ * the left side of the quals of an index scan.
+ */
+static AttrNumber
+get_indexqual_column(Expr *qual)
+{
+	Expr *expr;
+
+	switch (nodeTag(qual))
+	{
+		case T_OpExpr:
+			expr = linitial(castNode(OpExpr, qual)->args);
+			break;
+		case T_ScalarArrayOpExpr:
+			expr = linitial(castNode(ScalarArrayOpExpr, qual)->args);
+			break;
+		case T_RowCompareExpr:
+			expr = linitial(castNode(RowCompareExpr, qual)->largs);
+			break;
+		case T_NullTest:
+			expr = castNode(NullTest, qual)->arg;
+			break;
+		default:
+			elog(ERROR, "unsupported index qual type: %d", (int) nodeTag(qual));
+			pg_unreachable();
+	}
+
+	while (IsA(expr, RelabelType))
+		expr = ((RelabelType *) expr)->arg;
+
+	Assert(IsA(expr, Var) && ((Var *) expr)->varno == INDEX_VAR);
+
+	return castNode(Var, expr)->varattno;
+}
+
+/*
+ * Insert a qual on an index column after the quals on the same and earlier
+ * columns. The btree scan keys built from the quals have to be ordered by
+ * index column.
+ */
+static List *
+indexqual_insert(List *indexqual, Expr *qual, AttrNumber column)
+{
+	List *result = NIL;
+	bool inserted = false;
+	ListCell *lc;
+
+	foreach (lc, indexqual)
+	{
+		if (!inserted && get_indexqual_column(lfirst(lc)) > column)
+		{
+			result = lappend(result, qual);
+			inserted = true;
+		}
+
+		result = lappend(result, lfirst(lc));
+	}
+
+	if (!inserted)
+		result = lappend(result, qual);
+
+	return result;
+}
+
+/*
+ * Add the qual "column > NULL" (or "<" for descending scans) to the index
+ * scan. The executor finds the scan key built from this qual by its index
+ * column and replaces the NULL with the last distinct value returned, so that
+ * restarting the scan skips all other tuples with that value.
+ */
+static Plan *
+skip_scan_plan_create(PlannerInfo *root, RelOptInfo *rel, CustomPath *path, List *tlist,
+					  List *clauses, List *custom_plans)
+{
+	SkipScanPath *sspath = (SkipScanPath *) path;
+	CustomScan *cscan = makeNode(CustomScan);
+	Plan *index_plan = linitial(custom_plans);
+	Var *distinct_var = sspath->distinct_var;
+	AttrNumber distinct_attno = InvalidAttrNumber;
+	Var *index_var;
+	OpExpr *skip_qual;
+	List **indexqual;
+	int16 typlen;
+	bool typbyval;
+	ListCell *lc;
+
+	Assert(list_length(custom_plans) == 1);
+
+	switch (nodeTag(index_plan))
+	{
+		case T_IndexScan:
+			indexqual = &castNode(IndexScan, index_plan)->indexqual;
+			break;
+		case T_IndexOnlyScan:
+			indexqual = &castNode(IndexOnlyScan, index_plan)->indexqual;
+			break;
+		default:
+			elog(ERROR, "invalid child of skip scan: %u", nodeTag(index_plan));
+			pg_unreachable();
+	}
+
+	/* Index quals reference index columns through INDEX_VAR */
+	index_var = makeVar(INDEX_VAR,
+						sspath->indexcol + 1,
+						distinct_var->vartype,
+						distinct_var->vartypmod,
+						distinct_var->varcollid,
+						0);
+	skip_qual = (OpExpr *) make_opclause(sspath->skip_opno,
+										 BOOLOID,
+										 false,
+										 (Expr *) index_var,
+										 (Expr *) makeNullConst(distinct_var->vartype,
+																distinct_var->vartypmod,
+																distinct_var->varcollid),
+										 InvalidOid,
+										 sspath->index_path->indexinfo
+											 ->indexcollations[sspath->indexcol]);
+	skip_qual->opfuncid = get_opcode(sspath->skip_opno);
+	*indexqual = indexqual_insert(*indexqual, (Expr *) skip_qual, sspath->indexcol + 1);
+
+	/* Find the distinct column in the tuples produced by the index scan */
+	foreach (lc, index_plan->targetlist)
+	{
+		TargetEntry *tle = lfirst_node(TargetEntry, lc);
+		Expr *expr = tle->expr;
+
+		while (IsA(expr, RelabelType))
+			expr = ((RelabelType *) expr)->arg;
+
+		if (IsA(expr, Var) && ((Var *) expr)->varno == distinct_var->varno &&
+			((Var *) expr)->varattno == distinct_var->varattno)
+		{
+			distinct_attno = tle->resno;
+			break;
+		}
+	}
+
+	if (distinct_attno == InvalidAttrNumber)
+		elog(ERROR, "distinct column not found in target list of skip scan");
+
+	get_typlenbyval(distinct_var->vartype, &typlen, &typbyval);
+
+	cscan->flags = path->flags;
+	cscan->methods = &skip_scan_plan_methods;
+	cscan->scan.scanrelid = ((Scan *) index_plan)->scanrelid;
+	/* output target list */
+	cscan->scan.plan.targetlist = tlist;
+	/* input target list */
+	cscan->custom_scan_tlist = index_plan->targetlist;
+	cscan->custom_plans = custom_plans;
+	cscan->custom_private = list_make1(
+		lappend_int(list_make4_int(distinct_attno, typlen, typbyval, sspath->nulls_first),
+					sspath->indexcol + 1));
+
+	return &cscan->scan.plan;
+}
+
+static CustomPathMethods skip_scan_path_methods = {
+	.CustomName = "SkipScan",
+	.PlanCustomPath = skip_scan_plan_create,
+};
+
+/*
+ * Find the index column that produces the values of the distinct pathkey.
+ */
+static int
+get_distinct_indexcol(IndexOptInfo *index, EquivalenceClass *ec)
+{
+#if PG11_GE
+	int ncolumns = index->nkeycolumns;
+#else
+	int ncolumns = index->ncolumns;
+#endif
+	int i;
+
+	for (i = 0; i < ncolumns; i++)
+	{
+		ListCell *lc;
+
+		/* Expression columns are not supported */
+		if (index->indexkeys[i] == 0)
+			continue;
+
+		foreach (lc, ec->ec_members)
+		{
+			EquivalenceMember *em = lfirst(lc);
+			Expr *expr = em->em_expr;
+
+			while (IsA(expr, RelabelType))
+				expr = ((RelabelType *) expr)->arg;
+
+			if (IsA(expr, Var) && ((Var *) expr)->varno == index->rel->relid &&
+				((Var *) expr)->varattno == index->indexkeys[i] &&
+				((Var *) expr)->varlevelsup == 0)
+				return i;
+		}
+	}
+
+	return -1;
+}
+
+static Var *
+get_target_var(PathTarget *target, Index relid, AttrNumber attno)
+{
+	ListCell *lc;
+
+	foreach (lc, target->exprs)
+	{
+		Var *var = lfirst(lc);
+
+		if (IsA(var, Var) && var->varno == relid && var->varattno == attno &&
+			var->varlevelsup == 0)
+			return var;
+	}
+
+	return NULL;
+}
+
+static Path *
+skip_scan_path_create(PlannerInfo *root, IndexPath *index_path, PathKey *distinct_pathkey)
+{
+	IndexOptInfo *index = index_path->indexinfo;
+	SkipScanPath *path;
+	Var *distinct_var;
+	int indexcol;
+	bool forward;
+	Oid skip_opno;
+	double rows = index_path->path.rows;
+	double ndistinct;
+
+	if (index->relam != BTREE_AM_OID || index_path->indexorderbys != NIL ||
+		index_path->path.parallel_aware || index_path->path.pathkeys == NIL)
+		return NULL;
+
+	/*
+	 * The index has to return the tuples ordered by the distinct column
+	 * first. Leading index columns that come before it only do so when they
+	 * are fixed by equality restrictions.
+	 */
+	if (linitial(index_path->path.pathkeys) != distinct_pathkey)
+		return NULL;
+
+	indexcol = get_distinct_indexcol(index, distinct_pathkey->pk_eclass);
+
+	if (indexcol < 0)
+		return NULL;
+
+	distinct_var =
+		get_target_var(index_path->path.pathtarget, index->rel->relid, index->indexkeys[indexcol]);
+
+	if (distinct_var == NULL)
+		return NULL;
+
+	forward = ScanDirectionIsForward(index_path->indexscandir);
+	skip_opno = get_opfamily_member(index->opfamily[indexcol],
+									index->opcintype[indexcol],
+									index->opcintype[indexcol],
+									forward != index->reverse_sort[indexcol] ?
+										BTGreaterStrategyNumber :
+										BTLessStrategyNumber);
+
+	if (!OidIsValid(skip_opno))
+		return NULL;
+
+	path = (SkipScanPath *) newNode(sizeof(SkipScanPath), T_CustomPath);
+	path->cpath.path.pathtype = T_CustomScan;
+	path->cpath.path.parent = index_path->path.parent;
+	path->cpath.path.pathtarget = index_path->path.pathtarget;
+	path->cpath.path.param_info = index_path->path.param_info;
+	path->cpath.path.pathkeys = index_path->path.pathkeys;
+	path->cpath.path.parallel_aware = false;
+	path->cpath.path.parallel_safe = index_path->path.parallel_safe;
+	path->cpath.path.parallel_workers = 0;
+	path->cpath.flags = 0;
+	path->cpath.custom_paths = list_make1(index_path);
+	path->cpath.methods = &skip_scan_path_methods;
+	path->index_path = index_path;
+	path->indexcol = indexcol;
+	path->distinct_var = distinct_var;
+	path->skip_opno = skip_opno;
+	path->nulls_first = forward == index->nulls_first[indexcol];
+
+	ndistinct = estimate_num_groups(root, list_make1(distinct_var), rows, NULL);
+	ndistinct = clamp_row_est(Min(ndistinct, rows));
+
+	/*
+	 * Every distinct value costs an index descent, which is what the startup
+	 * cost of the index scan accounts for, plus fetching the first matching
+	 * tuple. A row estimate of one usually means the estimate was clamped
+	 * and the scan returns nothing, so the descent is all we pay for.
+	 */
+	path->cpath.path.rows = ndistinct;
+	path->cpath.path.startup_cost = index_path->path.startup_cost;
+
+	if (rows > 1)
+		path->cpath.path.total_cost = ndistinct * index_path->path.startup_cost +
+									  (ndistinct / rows) * index_path->path.total_cost;
+	else
+		path->cpath.path.total_cost = index_path->path.startup_cost;
+
+	return &path->cpath.path;
+}
+
+static Path *skip_scan_subpath_create(PlannerInfo *root, Path *path, PathKey *distinct_pathkey);
+
+/*
+ * Replace the children of an append with skip scans where possible. Children
+ * that cannot use a skip scan are kept, since the Unique node above the
+ * append removes their duplicates as well. Returns NIL if no child was
+ * replaced.
+ */
+static List *
+skip_scan_subpaths_create(PlannerInfo *root, List *subpaths, PathKey *distinct_pathkey)
+{
+	List *new_subpaths = NIL;
+	bool has_skip_scan = false;
+	ListCell *lc;
+
+	foreach (lc, subpaths)
+	{
+		Path *subpath = lfirst(lc);
+		Path *new_subpath = skip_scan_subpath_create(root, subpath, distinct_pathkey);
+
+		if (new_subpath != NULL)
+			has_skip_scan = true;
+		else
+			new_subpath = subpath;
+
+		new_subpaths = lappend(new_subpaths, new_subpath);
+	}
+
+	return has_skip_scan ? new_subpaths : NIL;
+}
+
+static void
+append_path_set_costs(Path *path, List *subpaths)
+{
+	ListCell *lc;
+
+	path->rows = 0;
+	path->total_cost = 0;
+
+	foreach (lc, subpaths)
+	{
+		Path *subpath = lfirst(lc);
+
+		path->rows += subpath->rows;
+		path->total_cost += subpath->total_cost;
+	}
+
+	if (subpaths != NIL)
+		path->startup_cost = ((Path *) linitial(subpaths))->startup_cost;
+}
+
+static Path *
+skip_scan_subpath_create(PlannerInfo *root, Path *path, PathKey *distinct_pathkey)
+{
+	switch (nodeTag(path))
+	{
+		case T_IndexPath:
+			return skip_scan_path_create(root, castNode(IndexPath, path), distinct_pathkey);
+		case T_MergeAppendPath:
+		{
+			MergeAppendPath *merge = castNode(MergeAppendPath, path);
+			List *subpaths = skip_scan_subpaths_create(root, merge->subpaths, distinct_pathkey);
+
+			if (subpaths == NIL)
+				return NULL;
+
+			return (Path *) create_merge_append_path_compat(root,
+															merge->path.parent,
+															subpaths,
+															merge->path.pathkeys,
+															PATH_REQ_OUTER(path));
+		}
+		case T_CustomPath:
+		{
+			CustomPath *cpath = castNode(CustomPath, path);
+			const char *name = cpath->methods->CustomName;
+
+			if (strcmp(name, "ChunkAppend") == 0)
+			{
+				ChunkAppendPath *append;
+				List *subpaths =
+					skip_scan_subpaths_create(root, cpath->custom_paths, distinct_pathkey);
+
+				if (subpaths == NIL)
+					return NULL;
+
+				append = palloc(sizeof(ChunkAppendPath));
+				memcpy(append, path, sizeof(ChunkAppendPath));
+				append->cpath.custom_paths = subpaths;
+				append_path_set_costs(&append->cpath.path, subpaths);
+
+				return &append->cpath.path;
+			}
+			else if (strcmp(name, "ConstraintAwareAppend") == 0)
+			{
+				ConstraintAwareAppendPath *append;
+				Path *subpath =
+					skip_scan_subpath_create(root, linitial(cpath->custom_paths), distinct_pathkey);
+
+				if (subpath == NULL)
+					return NULL;
+
+				append = palloc(sizeof(ConstraintAwareAppendPath));
+				memcpy(append, path, sizeof(ConstraintAwareAppendPath));
+				append->cpath.custom_paths = list_make1(subpath);
+				append->cpath.path.rows = subpath->rows;
+				append->cpath.path.startup_cost = subpath->startup_cost;
+				append->cpath.path.total_cost = subpath->total_cost;
+
+				return &append->cpath.path;
+			}
+
+			return NULL;
+		}
+		default:
+			return NULL;
+	}
+}
+
+/*
+ * Add paths that use SkipScan below the Unique node of a DISTINCT with a
+ * single distinct column.
+ *
+ * For hypertables, every chunk gets its own SkipScan, which produces the
+ * distinct values of the chunk. The MergeAppend (or ChunkAppend) above them
+ * keeps the values sorted, so the Unique node only has to remove values
+ * found in more than one chunk.
+ */
+void
+tsl_skip_scan_paths_add(PlannerInfo *root, RelOptInfo *input_rel, RelOptInfo *output_rel)
+{
+	UpperUniquePath *unique = NULL;
+	PathKey *distinct_pathkey;
+	List *needed_pathkeys;
+	ListCell *lc;
+
+	if (!ts_guc_enable_skip_scan || list_length(root->distinct_pathkeys) != 1)
+		return;
+
+	/* Reuse the estimates of the Unique path that PostgreSQL created */
+	foreach (lc, output_rel->pathlist)
+	{
+		if (IsA(lfirst(lc), UpperUniquePath))
+		{
+			unique = lfirst(lc);
+			break;
+		}
+	}
+
+	if (unique == NULL)
+		return;
+
+	distinct_pathkey = linitial(root->distinct_pathkeys);
+
+	/* DISTINCT ON needs the input in ORDER BY order, as in create_distinct_paths() */
+	if (list_length(root->distinct_pathkeys) < list_length(root->sort_pathkeys))
+		needed_pathkeys = root->sort_pathkeys;
+	else
+		needed_pathkeys = root->distinct_pathkeys;
+
+	foreach (lc, input_rel->pathlist)
+	{
+		Path *path = lfirst(lc);
+		Path *subpath = path;
+		Path *skip_path;
+
+		if (!pathkeys_contained_in(needed_pathkeys, path->pathkeys))
+			continue;
+
+		if (IsA(subpath, ProjectionPath))
+			subpath = castNode(ProjectionPath, subpath)->subpath;
+
+		skip_path = skip_scan_subpath_create(root, subpath, distinct_pathkey);
+
+		if (skip_path == NULL)
+			continue;
+
+		if (subpath != path)
+			skip_path = (Path *)
+				create_projection_path(root, path->parent, skip_path, path->pathtarget);
+
+		add_path(output_rel,
+				 (Path *) create_upper_unique_path(root,
+												   output_rel,
+												   skip_path,
+												   unique->numkeys,
+												   unique->path.rows));
+	}
+}
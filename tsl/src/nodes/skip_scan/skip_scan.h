@@ -0,0 +1,25 @@
+/*
+ * This file and its contents are licensed under the Timescale License.
+ * Please see the included NOTICE for copyright information and
+ * LICENSE-TIMESCALE for a copy of the license.
+ */
+#ifndef TIMESCALEDB_TSL_SKIP_SCAN_H
+#define TIMESCALEDB_TSL_SKIP_SCAN_H
+
+#include <postgres.h>
+#include <nodes/extensible.h>
+#include <optimizer/planner.h>
+
+/*
+ * SkipScan implements DISTINCT on the leading sort column of a btree index
+ * scan (also known as loose index scan). Instead of reading every index
+ * entry, the index scan is restarted past the last distinct value found, so
+ * only one index descent is needed per distinct value.
+ */
+
+extern void tsl_skip_scan_paths_add(PlannerInfo *root, RelOptInfo *input_rel,
+									RelOptInfo *output_rel);
+extern Node *tsl_skip_scan_state_create(CustomScan *cscan);
+extern void _skip_scan_init(void);
+
+#endif /* TIMESCALEDB_TSL_SKIP_SCAN_H */
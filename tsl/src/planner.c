@@ -11,6 +11,7 @@
 #include "nodes/gapfill/planner.h"
 #include "nodes/compress_dml/compress_dml.h"
 #include "nodes/decompress_chunk/decompress_chunk.h"
+#include "nodes/skip_scan/skip_scan.h"
 #include "chunk.h"
 #include "hypertable.h"
 #include "hypertable_compression.h"
@@ -24,6 +25,8 @@ tsl_create_upper_paths_hook(PlannerInfo *root, UpperRelationKind stage, RelOptIn
 {
 	if (UPPERREL_GROUP_AGG == stage)
 		plan_add_gapfill(root, output_rel);
+	if (UPPERREL_DISTINCT == stage)
+		tsl_skip_scan_paths_add(root, input_rel, output_rel);
 	if (UPPERREL_WINDOW == stage)
 	{
 		if (IsA(linitial(input_rel->pathlist), CustomPath))
@@ -0,0 +1,66 @@
+-- This file and its contents are licensed under the Timescale License.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-TIMESCALE for a copy of the license.
+
+\c :TEST_DBNAME :ROLE_SUPERUSER
+CREATE OR REPLACE FUNCTION test_precreate_chunks_policy(job_id INTEGER)
+RETURNS BOOL
+AS :TSL_MODULE_PATHNAME, 'ts_test_auto_precreate_chunks'
+LANGUAGE C VOLATILE STRICT;
+\c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
+
+CREATE TABLE precreate(time BIGINT NOT NULL, device INTEGER, value FLOAT);
+SELECT create_hypertable('precreate', 'time', 'device', 2, chunk_time_interval => 10);
+
+-- integer time requires an integer_now function to know the current time
+\set ON_ERROR_STOP 0
+SELECT add_precreate_chunks_policy('precreate', 2);
+\set ON_ERROR_STOP 1
+
+CREATE OR REPLACE FUNCTION dummy_now() RETURNS BIGINT LANGUAGE SQL IMMUTABLE AS 'SELECT 25::BIGINT';
+SELECT set_integer_now_func('precreate', 'dummy_now');
+
+\set ON_ERROR_STOP 0
+SELECT add_precreate_chunks_policy('precreate', 0);
+\set ON_ERROR_STOP 1
+
+SELECT add_precreate_chunks_policy('precreate', 2) AS precreate_job_id \gset
+SELECT * FROM _timescaledb_config.bgw_policy_precreate_chunks;
+SELECT job_type, schedule_interval FROM _timescaledb_config.bgw_job WHERE id = :precreate_job_id;
+
+\set ON_ERROR_STOP 0
+SELECT add_precreate_chunks_policy('precreate', 2);
+\set ON_ERROR_STOP 1
+SELECT add_precreate_chunks_policy('precreate', 2, if_not_exists => true);
+SELECT add_precreate_chunks_policy('precreate', 3, if_not_exists => true);
+
+-- the current chunk and the next two chunks are created in all space partitions
+SELECT test_precreate_chunks_policy(:precreate_job_id);
+SELECT c.table_name, d.column_name, ds.range_start, ds.range_end
+FROM _timescaledb_catalog.chunk c
+INNER JOIN _timescaledb_catalog.chunk_constraint cc ON (cc.chunk_id = c.id)
+INNER JOIN _timescaledb_catalog.dimension_slice ds ON (ds.id = cc.dimension_slice_id)
+INNER JOIN _timescaledb_catalog.dimension d ON (d.id = ds.dimension_id)
+ORDER BY c.id, d.id;
+
+-- running again without time advancing does not create anything
+SELECT test_precreate_chunks_policy(:precreate_job_id);
+SELECT count(*) FROM _timescaledb_catalog.chunk;
+
+-- advancing time only creates the chunks that are missing
+CREATE OR REPLACE FUNCTION dummy_now() RETURNS BIGINT LANGUAGE SQL IMMUTABLE AS 'SELECT 45::BIGINT';
+SELECT test_precreate_chunks_policy(:precreate_job_id);
+SELECT count(*) FROM _timescaledb_catalog.chunk;
+
+-- inserts go into the pre-created chunks
+INSERT INTO precreate VALUES (61, 1, 1.0), (62, 2, 2.0);
+SELECT count(*) FROM _timescaledb_catalog.chunk;
+
+SELECT remove_precreate_chunks_policy('precreate');
+SELECT * FROM _timescaledb_config.bgw_policy_precreate_chunks;
+SELECT remove_precreate_chunks_policy('precreate', if_exists => true);
+
+-- dropping the hypertable removes the policy and its job
+SELECT add_precreate_chunks_policy('precreate', 1) AS precreate_job_id \gset
+DROP TABLE precreate;
+SELECT count(*) FROM _timescaledb_config.bgw_job WHERE id = :precreate_job_id;
@@ -432,3 +432,79 @@ SELECT drop_chunks(table_name => 'ht5', newer_than => '2000-01-01'::TIMESTAMPTZ)
 SELECT chunk_name
 FROM timescaledb_information.compressed_chunk_stats
 WHERE hypertable_name = 'ht5'::regclass;
+
+-- ANALYZE computes statistics for compressed chunks from a sample of their compressed data
+CREATE TABLE ht_agg(time INT NOT NULL, val INT, temp FLOAT8, label TEXT);
+SELECT table_name FROM create_hypertable('ht_agg', 'time', chunk_time_interval => 100);
+INSERT INTO ht_agg SELECT t, NULLIF(t % 10, 0), t * 0.5, 'label' FROM generate_series(1, 20) t;
+ALTER TABLE ht_agg SET (timescaledb.compress);
+SELECT count(compress_chunk(i)) FROM show_chunks('ht_agg') i;
+SELECT format('%I.%I', ch.schema_name, ch.table_name) AS "AGG_CHUNK"
+FROM _timescaledb_catalog.chunk ch
+INNER JOIN _timescaledb_catalog.hypertable ht ON ht.id = ch.hypertable_id
+WHERE ht.table_name = 'ht_agg' \gset
+ANALYZE ht_agg;
+SELECT reltuples FROM pg_class WHERE oid = :'AGG_CHUNK'::regclass;
+SELECT attname, null_frac, n_distinct FROM pg_stats
+WHERE format('%I.%I', schemaname, tablename) = :'AGG_CHUNK'
+ORDER BY attname;
+
+-- VACUUM processes compressed chunks but keeps the row count computed by ANALYZE
+VACUUM ht_agg;
+SELECT reltuples FROM pg_class WHERE oid = :'AGG_CHUNK'::regclass;
+-- the row count covers all compressed rows, not only the sampled ones
+CREATE TABLE ht_sample(time INT NOT NULL, label TEXT);
+SELECT table_name FROM create_hypertable('ht_sample', 'time', chunk_time_interval => 100000);
+INSERT INTO ht_sample SELECT t, 'label' FROM generate_series(1, 20000) t;
+ALTER TABLE ht_sample SET (timescaledb.compress);
+SELECT count(compress_chunk(i)) FROM show_chunks('ht_sample') i;
+SELECT format('%I.%I', ch.schema_name, ch.table_name) AS "SAMPLE_CHUNK"
+FROM _timescaledb_catalog.chunk ch
+INNER JOIN _timescaledb_catalog.hypertable ht ON ht.id = ch.hypertable_id
+WHERE ht.table_name = 'ht_sample' \gset
+SET default_statistics_target = 1;
+ANALYZE ht_sample;
+RESET default_statistics_target;
+SELECT reltuples, relpages > 0 AS has_pages FROM pg_class WHERE oid = :'SAMPLE_CHUNK'::regclass;
+SELECT attname, null_frac, n_distinct FROM pg_stats
+WHERE format('%I.%I', schemaname, tablename) = :'SAMPLE_CHUNK' AND attname = 'label';
+-- the sample is in storage order, which is time descending by default
+SELECT attname, correlation FROM pg_stats
+WHERE format('%I.%I', schemaname, tablename) = :'SAMPLE_CHUNK' AND attname = 'time';
+
+-- columns not referenced by quals are detoasted only for batches with matching rows
+CREATE TABLE lazy_detoast(time INT NOT NULL, device INT, val INT, payload TEXT, note TEXT);
+SELECT table_name FROM create_hypertable('lazy_detoast', 'time', chunk_time_interval => 10000);
+INSERT INTO lazy_detoast
+SELECT t, t % 2, t, CASE WHEN t % 7 <> 0 THEN repeat(md5(t::text), 100) END, repeat(md5((-t)::text), 100)
+FROM generate_series(1, 1000) t;
+CREATE TABLE lazy_detoast_ref AS SELECT * FROM lazy_detoast;
+ALTER TABLE lazy_detoast SET (timescaledb.compress, timescaledb.compress_segmentby = 'device');
+SELECT count(compress_chunk(i)) FROM show_chunks('lazy_detoast') i;
+-- only some rows of a batch qualify, the lazy columns skip the others
+SELECT time, payload = repeat(md5(time::text), 100) AS payload_matches
+FROM lazy_detoast WHERE val % 250 = 0 ORDER BY time;
+SELECT count(*) AS total, count(payload) AS payloads FROM lazy_detoast WHERE val % 5 = 0;
+-- no row of the device 1 batch qualifies
+SELECT count(payload) FROM lazy_detoast WHERE device = 1 AND val % 2 = 0;
+-- results are the same as without compression
+SELECT count(*) FROM (
+  (SELECT time, device, payload FROM lazy_detoast WHERE val > 500
+   EXCEPT SELECT time, device, payload FROM lazy_detoast_ref WHERE val > 500)
+  UNION ALL
+  (SELECT time, device, payload FROM lazy_detoast_ref WHERE val > 500
+   EXCEPT SELECT time, device, payload FROM lazy_detoast WHERE val > 500)) q;
+SELECT count(*) FROM (
+  (SELECT time, note FROM lazy_detoast WHERE val % 3 = 0
+   EXCEPT SELECT time, note FROM lazy_detoast_ref WHERE val % 3 = 0)
+  UNION ALL
+  (SELECT time, note FROM lazy_detoast_ref WHERE val % 3 = 0
+   EXCEPT SELECT time, note FROM lazy_detoast WHERE val % 3 = 0)) q;
+SELECT count(*) FROM (
+  (SELECT time, note FROM lazy_detoast WHERE payload IS NULL
+   EXCEPT SELECT time, note FROM lazy_detoast_ref WHERE payload IS NULL)
+  UNION ALL
+  (SELECT time, note FROM lazy_detoast_ref WHERE payload IS NULL
+   EXCEPT SELECT time, note FROM lazy_detoast WHERE payload IS NULL)) q;
+DROP TABLE lazy_detoast_ref;
+DROP TABLE lazy_detoast;
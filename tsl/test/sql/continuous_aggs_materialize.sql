@@ -360,6 +360,14 @@ SELECT materialization_id, _timescaledb_internal.to_timestamp(watermark)
     WHERE materialization_id = :mat_hypertable_id;
 SELECT hypertable_id, _timescaledb_internal.to_timestamp(watermark) FROM _timescaledb_catalog.continuous_aggs_invalidation_threshold;
 
+-- invalidations from COPY are tracked the same way as from INSERT
+COPY continuous_agg_test_t FROM STDIN;
+2019-02-02 2:30 UTC	1
+2019-02-02 3:30 UTC	1
+\.
+
+SELECT * FROM _timescaledb_catalog.continuous_aggs_hypertable_invalidation_log;
+
 -- test extremes
 CREATE TABLE continuous_agg_extreme(time BIGINT, data BIGINT);
 SELECT create_hypertable('continuous_agg_extreme', 'time', chunk_time_interval=> 10);
@@ -749,3 +757,30 @@ REFRESH MATERIALIZED VIEW continuous_agg_ts_max_view;
 SELECT view_name, completed_threshold, invalidation_threshold
 FROM timescaledb_information.continuous_aggregate_stats
 where view_name::text like 'continuous_agg_ts_max_view';
+
+-- test that inserts invalidate continuous aggregates without firing the
+-- invalidation trigger for every row
+CREATE TABLE continuous_agg_inval(time BIGINT, data BIGINT);
+SELECT table_name FROM create_hypertable('continuous_agg_inval', 'time', chunk_time_interval=> 10);
+CREATE OR REPLACE FUNCTION integer_now_continuous_agg_inval() returns BIGINT LANGUAGE SQL STABLE as $$ SELECT BIGINT '100' $$;
+SELECT set_integer_now_func('continuous_agg_inval', 'integer_now_continuous_agg_inval');
+CREATE VIEW continuous_agg_inval_view
+    WITH (timescaledb.continuous, timescaledb.refresh_lag='0', timescaledb.ignore_invalidation_older_than = 50)
+    AS SELECT time_bucket('10', time), COUNT(data) as value
+        FROM continuous_agg_inval
+        GROUP BY 1;
+INSERT INTO continuous_agg_inval SELECT i, i FROM generate_series(0, 99) i;
+SELECT id AS inval_hypertable_id FROM _timescaledb_catalog.hypertable
+WHERE table_name = 'continuous_agg_inval' \gset
+SET ROLE :ROLE_SUPERUSER;
+INSERT INTO _timescaledb_catalog.continuous_aggs_invalidation_threshold VALUES (:inval_hypertable_id, 100);
+SET ROLE :ROLE_DEFAULT_PERM_USER;
+
+-- values older than ignore_invalidation_older_than are not tracked
+INSERT INTO continuous_agg_inval VALUES (5, 1);
+INSERT INTO continuous_agg_inval VALUES (10, 1), (62, 1), (65, 1);
+-- batched inserts track the values of every chunk they insert into
+INSERT INTO continuous_agg_inval SELECT 70 + (i % 2) * 10 + i % 7, i FROM generate_series(1, 2000) i;
+SELECT lowest_modified_value, greatest_modified_value
+FROM _timescaledb_catalog.continuous_aggs_hypertable_invalidation_log
+WHERE hypertable_id = :inval_hypertable_id ORDER BY 1, 2;
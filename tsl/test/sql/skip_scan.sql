@@ -0,0 +1,52 @@
+-- This file and its contents are licensed under the Timescale License.
+-- Please see the included NOTICE for copyright information and
+-- LICENSE-TIMESCALE for a copy of the license.
+
+\set PREFIX 'EXPLAIN (costs off)'
+\pset null NULL
+
+CREATE TABLE skip_scan(time int NOT NULL, dev int, val int);
+SELECT table_name FROM create_hypertable('skip_scan', 'time', chunk_time_interval => 10);
+INSERT INTO skip_scan SELECT t, t % 4, t FROM generate_series(0, 29) t;
+INSERT INTO skip_scan VALUES (5, NULL, -1), (25, NULL, -2);
+CREATE INDEX ON skip_scan(dev, time DESC);
+ANALYZE skip_scan;
+
+SET enable_seqscan TO off;
+SET enable_hashagg TO off;
+
+-- DISTINCT on the leading index column, including NULL
+:PREFIX SELECT DISTINCT dev FROM skip_scan ORDER BY dev;
+SELECT DISTINCT dev FROM skip_scan ORDER BY dev;
+
+-- DISTINCT ON returns the first row of each value across chunks
+:PREFIX SELECT DISTINCT ON (dev) dev, time, val FROM skip_scan ORDER BY dev, time DESC;
+SELECT DISTINCT ON (dev) dev, time, val FROM skip_scan ORDER BY dev, time DESC;
+
+-- backward scan returns NULLs first
+:PREFIX SELECT DISTINCT ON (dev) dev, time, val FROM skip_scan ORDER BY dev DESC, time;
+SELECT DISTINCT ON (dev) dev, time, val FROM skip_scan ORDER BY dev DESC, time;
+
+-- chunk exclusion and index quals on later index columns, which the skip
+-- qual has to precede
+:PREFIX SELECT DISTINCT ON (dev) dev, time FROM skip_scan WHERE time >= 5 AND time < 20 ORDER BY dev, time DESC;
+SELECT DISTINCT ON (dev) dev, time FROM skip_scan WHERE time >= 5 AND time < 20 ORDER BY dev, time DESC;
+:PREFIX SELECT DISTINCT dev FROM skip_scan WHERE dev > 1 ORDER BY dev;
+SELECT DISTINCT dev FROM skip_scan WHERE dev > 1 ORDER BY dev;
+
+-- filters on columns not in the index
+SELECT DISTINCT dev FROM skip_scan WHERE val % 2 = 1 ORDER BY dev;
+
+-- prepared statements are rescanned with different parameters
+PREPARE prep(int) AS SELECT DISTINCT dev FROM skip_scan WHERE time < $1 ORDER BY dev;
+EXECUTE prep(5);
+EXECUTE prep(30);
+DEALLOCATE prep;
+
+SET timescaledb.enable_skipscan TO false;
+:PREFIX SELECT DISTINCT dev FROM skip_scan ORDER BY dev;
+RESET timescaledb.enable_skipscan;
+
+RESET enable_hashagg;
+RESET enable_seqscan;
+DROP TABLE skip_scan;
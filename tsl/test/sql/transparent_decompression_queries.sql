@@ -67,3 +67,34 @@ GROUP BY 2, 3;
 
 RESET enable_hashagg;
 
+-- the row estimate of a compressed chunk uses the number of rows per batch
+-- recorded when it was compressed, here 10 rows per device and chunk
+CREATE TABLE batch_est(time int NOT NULL, device int, value float);
+SELECT table_name FROM create_hypertable('batch_est', 'time', chunk_time_interval => 1000);
+ALTER TABLE batch_est SET (timescaledb.compress, timescaledb.compress_segmentby = 'device');
+INSERT INTO batch_est SELECT t, t % 100, t FROM generate_series(0, 1999) t;
+SELECT count(compress_chunk(c)) FROM show_chunks('batch_est') c;
+ANALYZE _timescaledb_internal.compress_hyper_6_13_chunk;
+ANALYZE _timescaledb_internal.compress_hyper_6_14_chunk;
+CREATE TABLE batch_est_ref(time int);
+INSERT INTO batch_est_ref SELECT generate_series(0, 19999);
+ANALYZE batch_est_ref;
+
+SET max_parallel_workers_per_gather TO 0;
+-- the compressed chunks are estimated to be smaller, so they are hashed
+EXPLAIN (costs off) SELECT count(*) FROM batch_est b INNER JOIN batch_est_ref r ON r.time = b.time;
+
+-- chunks compressed without recorded row counts assume full batches of
+-- 1000 rows, so the other table is hashed
+\c :TEST_DBNAME :ROLE_SUPERUSER
+UPDATE _timescaledb_catalog.compression_chunk_size
+SET numrows_pre_compression = NULL, numrows_post_compression = NULL
+WHERE chunk_id IN (11, 12);
+\c :TEST_DBNAME :ROLE_DEFAULT_PERM_USER
+SET max_parallel_workers_per_gather TO 0;
+EXPLAIN (costs off) SELECT count(*) FROM batch_est b INNER JOIN batch_est_ref r ON r.time = b.time;
+SELECT count(*) FROM batch_est b INNER JOIN batch_est_ref r ON r.time = b.time;
+
+RESET max_parallel_workers_per_gather;
+DROP TABLE batch_est_ref;
+DROP TABLE batch_est;
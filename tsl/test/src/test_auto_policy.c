@@ -20,6 +20,7 @@
 TS_FUNCTION_INFO_V1(ts_test_auto_reorder);
 TS_FUNCTION_INFO_V1(ts_test_auto_drop_chunks);
 TS_FUNCTION_INFO_V1(ts_test_auto_compress_chunks);
+TS_FUNCTION_INFO_V1(ts_test_auto_precreate_chunks);
 
 static Oid chunk_oid;
 static Oid index_oid;
@@ -81,3 +82,12 @@ ts_test_auto_compress_chunks(PG_FUNCTION_ARGS)
 	ts_bgw_job_stat_mark_start(job_id);
 	return execute_compress_chunks_policy(job);
 }
+
+Datum
+ts_test_auto_precreate_chunks(PG_FUNCTION_ARGS)
+{
+	int32 job_id = PG_GETARG_INT32(0);
+	BgwJob *job = ts_bgw_job_find(job_id, CurrentMemoryContext, true);
+
+	PG_RETURN_BOOL(execute_precreate_chunks_policy(job));
+}
@@ -18,6 +18,7 @@
 #include <utils/rel.h>
 #include <utils/syscache.h>
 #include <utils/typcache.h>
+#include <utils/uuid.h>
 #include <fmgr.h>
 
 #include <catalog.h>
@@ -215,6 +216,40 @@ test_string_dictionary()
 	TestEnsureError(dictionary_compressor_alloc(CSTRINGOID));
 }
 
+static void
+test_uuid_dictionary()
+{
+	DictionaryCompressor *compressor = dictionary_compressor_alloc(UUIDOID);
+	DictionaryCompressed *compressed;
+	DecompressionIterator *iter;
+	pg_uuid_t uuids[15];
+	int i;
+	for (i = 0; i < 15; i++)
+	{
+		memset(uuids[i].data, 0, UUID_LEN);
+		uuids[i].data[0] = i;
+		uuids[i].data[UUID_LEN - 1] = 0xff - i;
+	}
+
+	for (i = 0; i < 1015; i++)
+		dictionary_compressor_append(compressor, UUIDPGetDatum(&uuids[i % 15]));
+
+	compressed = dictionary_compressor_finish(compressor);
+	TestAssertTrue(compressed != NULL);
+
+	i = 0;
+	iter = tsl_dictionary_decompression_iterator_from_datum_forward(PointerGetDatum(compressed),
+																	UUIDOID);
+	for (DecompressResult r = dictionary_decompression_iterator_try_next_forward(iter); !r.is_done;
+		 r = dictionary_decompression_iterator_try_next_forward(iter))
+	{
+		TestAssertTrue(!r.is_null);
+		TestAssertTrue(memcmp(DatumGetUUIDP(r.val)->data, uuids[i % 15].data, UUID_LEN) == 0);
+		i += 1;
+	}
+	TestAssertInt64Eq(i, 1015);
+}
+
 static void
 test_gorilla_int()
 {
@@ -425,6 +460,7 @@ ts_test_compression(PG_FUNCTION_ARGS)
 	test_string_array();
 	test_int_dictionary();
 	test_string_dictionary();
+	test_uuid_dictionary();
 	test_gorilla_int();
 	test_gorilla_float();
 	test_gorilla_double();